@@ -39,9 +39,18 @@ void pbbs_pctl_call(pbbs::measured_type measured, parray<pasl::pctl::_point2d<do
       pbbs::delaunay(&y[0], (int)y.size());
     });
   } else {
+    // location=dynamic locates the points from a dynamic point index
+    // instead of the tree regenerated now and then; engine=brio inserts
+    // them in biased randomized insertion order, located by the conflict
+    // lists of the triangles
+    bool dynamic = deepsea::cmdline::parse_or_default_string("location", "rebuild") == "dynamic";
+    bool brio = deepsea::cmdline::parse_or_default_string("engine", "default") == "brio";
+    pasl::pctl::delaunay_stats stats;
     measured([&] {
-      pasl::pctl::delaunay(x);
+      pasl::pctl::delaunay(x, dynamic, brio, &stats);
     });
+    printf("rounds %ld\n", stats.rounds);
+    printf("retries %ld\n", stats.retries);
   }
 }
 
@@ -13,6 +13,7 @@
 #include <stdlib.h>
 #include "bench.hpp"
 #include "deterministichash.hpp"
+#include "stringintern.hpp"
 #include "loaders.hpp"
 #include "deterministicHash.h"
 #undef parallel_for
@@ -37,6 +38,30 @@ void pbbs_pctl_call(pbbs::measured_type measured, parray<Item>& x) {
   }
 }
 
+// algo=intern measures instead the dictionary encoding of the strings,
+// which also gives the id of every string
+void pbbs_pctl_strings_call(pbbs::measured_type measured, parray<char*>& x) {
+  std::string algo = deepsea::cmdline::parse_or_default_string("algo", "remove_duplicates");
+  long distinct = 0;
+  if (algo == "intern") {
+    long arena_bytes = 0;
+    measured([&] {
+      parray<int> ids;
+      pasl::pctl::string_dictionary dict = pasl::pctl::intern_strings(x, ids);
+      distinct = dict.size();
+      arena_bytes = dict.size_in_bytes();
+    });
+    printf("arena_mb %.3lf\n", (double)arena_bytes / (1 << 20));
+  } else if (algo == "remove_duplicates") {
+    pbbs_pctl_call(measured, x);
+    distinct = pasl::pctl::remove_duplicates(x).size();
+  } else {
+    std::cerr << "unknown algo " << algo << std::endl;
+    exit(1);
+  }
+  printf("distinct %ld\n", distinct);
+}
+
 int main(int argc, char** argv) {
   pbbs::launch(argc, argv, [&] (pbbs::measured_type measured) {
     std::string infile = deepsea::cmdline::parse_or_default_string("infile", "");
@@ -48,7 +73,7 @@ int main(int argc, char** argv) {
       });
       d.add("array_string", [&] {
         parray<char*> x = pasl::pctl::io::load<parray<char*>>(infile);
-        pbbs_pctl_call(measured, x);
+        pbbs_pctl_strings_call(measured, x);
       });
       d.add("array_pair_string_int", [&] {
         parray<std::pair<char*, int>*> x = pasl::pctl::io::load<parray<std::pair<char*, int>*>>(infile);
@@ -113,7 +138,7 @@ int main(int argc, char** argv) {
       } else {
         a = pasl::pctl::io::load_trigram_words(std::string("tests/trigram_words_") + std::to_string(n), n, reload);
       }
-      pbbs_pctl_call(measured, a);
+      pbbs_pctl_strings_call(measured, a);
       pasl::pctl::parallel_for(0, n, [&] (int i) {
         delete [] a[i];
       });
@@ -0,0 +1,121 @@
+/*!
+ * \file dynamicindex_bench.cpp
+ * \brief Benchmarking script for the dynamic point index
+ * \date 2016
+ * \copyright COPYRIGHT (c) 2015 Umut Acar, Arthur Chargueraud, and
+ * Michael Rainey. All rights reserved.
+ * \license This project is released under the GNU Public License.
+ *
+ */
+
+#include <math.h>
+#include <functional>
+#include <chrono>
+#include <stdlib.h>
+#include "bench.hpp"
+#include "dynamicindex.hpp"
+#include "loaders.hpp"
+
+/***********************************************************************/
+
+/*---------------------------------------------------------------------*/
+
+template <class Item>
+using parray = pasl::pctl::parray<Item>;
+
+double since(std::chrono::system_clock::time_point start) {
+  std::chrono::duration<double> diff = std::chrono::system_clock::now() - start;
+  return diff.count();
+}
+
+// The points are inserted by batches of "batch" points, and every batch is
+// followed by "queries" k-nearest neighbor queries, at the points of the
+// next batch, as for the point location of an incremental construction,
+// and by the deletion of the erase_ratio * batch oldest points, so that
+// the live points are a sliding window of the input.
+//
+// index=dynamic maintains a dynamic_point_index; index=rebuild builds a
+// point_kdtree over the live points again after every batch.
+template <class Point, int K>
+void pctl_call(pbbs::measured_type measured, parray<Point>& x) {
+  std::string index = deepsea::cmdline::parse_or_default_string("index", "dynamic");
+  long n = x.size();
+  long batch = std::max(1, deepsea::cmdline::parse_or_default_int("batch", 10000));
+  long queries = deepsea::cmdline::parse_or_default_int("queries", (int) batch);
+  double erase_ratio = deepsea::cmdline::parse_or_default_double("erase_ratio", 0.0);
+  int k = deepsea::cmdline::parse_or_default_int("k", 1);
+  if (index != "dynamic" && index != "rebuild") {
+    std::cerr << "unknown index " << index << std::endl;
+    exit(1);
+  }
+  parray<int> ids(n, [&] (long i) {
+    return (int) i;
+  });
+  double insert_time = 0.0;
+  double query_time = 0.0;
+  double erase_time = 0.0;
+  int levels = 0;
+  measured([&] {
+    pasl::pctl::dynamic_point_index<Point> dynamic;
+    pasl::pctl::point_kdtree<Point> rebuilt;
+    long lo = 0;
+    for (long hi = 0; hi < n; ) {
+      long m = std::min(batch, n - hi);
+      auto start = std::chrono::system_clock::now();
+      if (index == "dynamic") {
+        dynamic.insert(x.begin() + hi, ids.cbegin() + hi, m);
+      } else {
+        rebuilt = pasl::pctl::point_kdtree<Point>(x.begin() + lo, hi + m - lo);
+      }
+      insert_time += since(start);
+      hi += m;
+      parray<Point> q(queries, [&] (long i) {
+        return x[(hi + i) % n];
+      });
+      start = std::chrono::system_clock::now();
+      if (index == "dynamic") {
+        dynamic.template knn<K>(q.begin(), queries, k);
+      } else {
+        rebuilt.template knn<K>(q.begin(), queries, k);
+      }
+      query_time += since(start);
+      long e = std::min((long) (erase_ratio * m), hi - lo);
+      start = std::chrono::system_clock::now();
+      if (index == "dynamic") {
+        dynamic.erase(ids.cbegin() + lo, e);
+      }
+      erase_time += since(start);
+      lo += e;
+    }
+    levels = dynamic.nb_levels();
+  });
+  printf("insert_time %.3lf\n", insert_time);
+  printf("query_time %.3lf\n", query_time);
+  printf("erase_time %.3lf\n", erase_time);
+  printf("levels %d\n", levels);
+}
+
+int main(int argc, char** argv) {
+  pbbs::launch(argc, argv, [&] (pbbs::measured_type measured) {
+    int test = deepsea::cmdline::parse_or_default_int("test", 0);
+    int n = deepsea::cmdline::parse_or_default_int("n", 1000000);
+    bool reload = deepsea::cmdline::parse_or_default_int("reload", 0) == 1;
+    system("mkdir tests");
+    if (test == 0) {
+      parray<pasl::pctl::_point2d<double>> a = pasl::pctl::io::load_points_uniform_2d(std::string("tests/random_in_cube_2d_") + std::to_string(n), n, false, false, reload);
+      pctl_call<pasl::pctl::_point2d<double>, 10>(measured, a);
+    } else if (test == 1) {
+      parray<pasl::pctl::_point2d<double>> a = pasl::pctl::io::load_points_plummer_2d(std::string("tests/random_plummer_2d_") + std::to_string(n), n, reload);
+      pctl_call<pasl::pctl::_point2d<double>, 10>(measured, a);
+    } else if (test == 2) {
+      parray<pasl::pctl::_point3d<double>> a = pasl::pctl::io::load_points_uniform_3d(std::string("tests/random_in_cube_3d_") + std::to_string(n), n, false, false, reload);
+      pctl_call<pasl::pctl::_point3d<double>, 10>(measured, a);
+    } else if (test == 3) {
+      parray<pasl::pctl::_point3d<double>> a = pasl::pctl::io::load_points_plummer_3d(std::string("tests/random_plummer_3d_") + std::to_string(n), n, reload);
+      pctl_call<pasl::pctl::_point3d<double>, 10>(measured, a);
+    }
+  });
+  return 0;
+}
+
+/***********************************************************************/
@@ -0,0 +1,128 @@
+/*!
+ * \file externalsort_bench.cpp
+ * \brief Benchmarking script for the external-memory sort
+ * \date 2016
+ * \copyright COPYRIGHT (c) 2015 Umut Acar, Arthur Chargueraud, and
+ * Michael Rainey. All rights reserved.
+ * \license This project is released under the GNU Public License.
+ *
+ */
+
+#include <math.h>
+#include <functional>
+#include <fstream>
+#include <stdlib.h>
+#include "bench.hpp"
+#include "externalsort.hpp"
+#include "sequencedata.hpp"
+
+/***********************************************************************/
+
+/*---------------------------------------------------------------------*/
+
+template <class Item>
+using parray = pasl::pctl::parray<Item>;
+
+// Writes n random items to file in chunks of at most chunk items, so that
+// inputs larger than the memory can be generated
+template <class Item>
+void write_random_file(std::string file, long n, long chunk) {
+  std::ofstream out(file, std::ofstream::binary);
+  out.write(reinterpret_cast<char*>(&n), sizeof(long));
+  for (long lo = 0; lo < n; lo += chunk) {
+    long hi = std::min(n, lo + chunk);
+    parray<Item> a = pasl::pctl::sequencedata::rand<Item>(lo, hi);
+    out.write(reinterpret_cast<char*>(a.begin()), sizeof(Item) * (hi - lo));
+  }
+  out.close();
+}
+
+// Checks, in chunks, that file holds n items in order
+template <class Item>
+bool check_sorted_file(std::string file, long n, long chunk) {
+  std::ifstream in(file, std::ifstream::binary);
+  long m = 0;
+  in.read(reinterpret_cast<char*>(&m), sizeof(long));
+  if (m != n) {
+    return false;
+  }
+  parray<Item> a;
+  a.prefix_tabulate(std::max(1L, std::min(n, chunk)), 0);
+  Item last;
+  for (long lo = 0; lo < n; lo += chunk) {
+    long len = std::min(n - lo, chunk);
+    in.read(reinterpret_cast<char*>(a.begin()), sizeof(Item) * len);
+    for (long i = 0; i < len; i++) {
+      if ((lo + i > 0) && a[i] < last) {
+        return false;
+      }
+      last = a[i];
+    }
+  }
+  return true;
+}
+
+// memory caps, in megabytes, the buffers of the sort; chosen below the
+// input size, it forces the out-of-core path
+template <class Item>
+void pbbs_pctl_call(pbbs::measured_type measured, std::string infile, std::string outfile, long n) {
+  long memory = deepsea::cmdline::parse_or_default_long("memory", 256) << 20;
+  bool check = deepsea::cmdline::parse_or_default_int("check", 1) == 1;
+  pasl::pctl::external_sort_stats stats;
+  measured([&] {
+    stats = pasl::pctl::external_sort<Item>(infile, outfile, memory);
+  });
+  printf("memory_mb %ld\n", memory >> 20);
+  printf("input_mb %.3lf\n", (double) (n * sizeof(Item)) / (1 << 20));
+  printf("run_size %ld\n", stats.run_size);
+  printf("runs %ld\n", stats.nb_runs);
+  printf("merge_passes %d\n", stats.nb_merge_passes);
+  if (check && ! check_sorted_file<Item>(outfile, n, std::max(1L, memory / (long) sizeof(Item)))) {
+    std::cerr << "ACHTUNG!\n";
+  }
+}
+
+int main(int argc, char** argv) {
+  pbbs::launch(argc, argv, [&] (pbbs::measured_type measured) {
+    std::string infile = deepsea::cmdline::parse_or_default_string("infile", "");
+    std::string outfile = deepsea::cmdline::parse_or_default_string("outfile", "");
+    if (infile != "") {
+      // a parray written by io::write_to_file
+      if (outfile == "") {
+        outfile = infile + ".sorted";
+      }
+      std::ifstream in(infile, std::ifstream::binary);
+      long n = 0;
+      in.read(reinterpret_cast<char*>(&n), sizeof(long));
+      in.close();
+      deepsea::cmdline::dispatcher d;
+      d.add("array_double", [&] {
+        pbbs_pctl_call<double>(measured, infile, outfile, n);
+      });
+      d.add("array_int", [&] {
+        pbbs_pctl_call<int>(measured, infile, outfile, n);
+      });
+      d.dispatch("type");
+      return;
+    }
+
+    long n = deepsea::cmdline::parse_or_default_long("n", 100000000);
+    bool reload = deepsea::cmdline::parse_or_default_int("reload", 0) == 1;
+    long chunk = 1 << 24;
+    system("mkdir tests");
+    infile = std::string("tests/external_random_seq_") + std::to_string(n);
+    if (outfile == "") {
+      outfile = infile + ".sorted";
+    }
+    std::ifstream in(infile, std::ifstream::binary);
+    if (reload || ! in.good()) {
+      write_random_file<double>(infile, n, chunk);
+    }
+    in.close();
+    pbbs_pctl_call<double>(measured, infile, outfile, n);
+    unlink(outfile.c_str());
+  });
+  return 0;
+}
+
+/***********************************************************************/
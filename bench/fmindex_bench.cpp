@@ -0,0 +1,95 @@
+/*!
+ * \file fmindex_bench.cpp
+ * \brief Benchmarking script for the FM-index against suffix array search
+ * \date 2016
+ * \copyright COPYRIGHT (c) 2015 Umut Acar, Arthur Chargueraud, and
+ * Michael Rainey. All rights reserved.
+ * \license This project is released under the GNU Public License.
+ *
+ */
+
+#include <math.h>
+#include "bench.hpp"
+#include "fmindex.hpp"
+#include "textindex.hpp"
+#include "loaders.hpp"
+
+/***********************************************************************/
+
+using namespace pasl::pctl;
+
+// nb substrings of length m of x at pseudo-random positions
+parray<std::string> random_patterns(const std::string& x, long nb, long m) {
+  long n = x.length();
+  return parray<std::string>(nb, [&] (long i) {
+    long s = prandgen::hashi((int) i) % std::max(1L, n - m);
+    return x.substr(s, m);
+  });
+}
+
+// index=fm counts by backward search on the FM-index; index=sa by binary
+// search on a text_index. Both report the size of their structures.
+void pbbs_pctl_call(pbbs::measured_type measured, std::string sa_file, std::string& x) {
+  bool reload = deepsea::cmdline::parse_or_default_int("reload", 0) == 1;
+  long nb = deepsea::cmdline::parse_or_default_long("queries", 1000000);
+  long m = deepsea::cmdline::parse_or_default_long("m", 8);
+  // the suffix array of x read as unsigned characters
+  parray<intT> SA = pasl::pctl::io::load(sa_file, [&] {
+    return suffix_array((unsigned char*)&x[0], (intT)x.length());
+  }, reload);
+  parray<std::string> patterns = random_patterns(x, nb, m);
+  long matches = 0;
+  long index_bytes = 0;
+  deepsea::cmdline::dispatcher d;
+  d.add("fm", [&] {
+    fm_index index(x.c_str(), SA);
+    SA.clear();
+    index_bytes = index.size_in_bytes();
+    measured([&] {
+      parray<long> counts = index.count(patterns);
+      matches = reduce(counts.cbegin(), counts.cend(), 0L, [&] (long a, long b) {
+        return a + b;
+      });
+    });
+  });
+  d.add("sa", [&] {
+    parray<unsigned char> text(x.length(), [&] (long i) {
+      return (unsigned char)x[i];
+    });
+    parray<intT> LCP = lcp_array(text.cbegin(), SA);
+    text_index<intT> index(std::move(text), std::move(SA), std::move(LCP));
+    index_bytes = index.size_in_bytes();
+    measured([&] {
+      parray<long> counts = index.count(patterns);
+      matches = reduce(counts.cbegin(), counts.cend(), 0L, [&] (long a, long b) {
+        return a + b;
+      });
+    });
+  });
+  d.dispatch_or_default("index", "fm");
+  printf("text_length %ld\n", (long)x.length());
+  printf("index_mb %.3lf\n", (double)index_bytes / (1 << 20));
+  printf("bits_per_char %.3lf\n", 8.0 * index_bytes / std::max(1L, (long)x.length()));
+  printf("queries %ld\n", nb);
+  printf("matches %ld\n", matches);
+}
+
+int main(int argc, char** argv) {
+  pbbs::launch(argc, argv, [&] (pbbs::measured_type measured) {
+    std::string infile = deepsea::cmdline::parse_or_default_string("infile", "");
+    if (infile != "") {
+      std::string x = pasl::pctl::io::load<std::string>(infile);
+      pbbs_pctl_call(measured, infile + ".usa", x);
+      return;
+    }
+    int n = deepsea::cmdline::parse_or_default_int("n", 10000000);
+    bool reload = deepsea::cmdline::parse_or_default_int("reload", 0) == 1;
+    system("mkdir tests");
+    std::string file = "tests/trigram_string_" + std::to_string(n);
+    std::string x = pasl::pctl::io::load_trigram_string(file, n, reload);
+    pbbs_pctl_call(measured, file + ".usa", x);
+  });
+  return 0;
+}
+
+/***********************************************************************/
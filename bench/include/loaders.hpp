@@ -105,7 +105,7 @@ parray<point3d> load_points_plummer_3d(std::string file, int n, bool regenerate
   return load(file, [&] { return pasl::pctl::plummer3d<int, unsigned int>(n); }, regenerate);
 }
 
-std::string load_trigram_string(std::string file, int n, bool regenerate = false) {
+std::string load_trigram_string(std::string file, long n, bool regenerate = false) {
   return load(file, [&] { return pasl::pctl::trigram_string(0, n); }, regenerate);
 }
 
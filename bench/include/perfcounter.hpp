@@ -0,0 +1,95 @@
+/* COPYRIGHT (c) 2015 Umut Acar, Arthur Chargueraud, and Michael
+ * Rainey
+ * All rights reserved.
+ *
+ * \file perfcounter.hpp
+ * \brief Hardware cache-miss counters for the benchmarks
+ *
+ */
+
+#include <vector>
+#include <string>
+#include <cstring>
+#include <cstdlib>
+#include <dirent.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+
+#ifndef _PCTL_PERF_COUNTER_H_
+#define _PCTL_PERF_COUNTER_H_
+
+namespace pbbs {
+
+// Counts the last-level cache misses of all the threads of the process
+// between start and stop, with one hardware counter per thread opened by
+// perf_event_open, which the threads of the scheduler are already running
+// at start. stop returns -1 when the counters are not available, e.g. with
+// kernel.perf_event_paranoid above 2 or in a virtual machine without a PMU.
+class cache_miss_counter {
+private:
+
+  std::vector<int> fds;
+
+  static int open_counter(pid_t tid) {
+    struct perf_event_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.config = PERF_COUNT_HW_CACHE_MISSES;
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    return (int) syscall(__NR_perf_event_open, &attr, tid, -1, -1, 0);
+  }
+
+public:
+
+  bool start() {
+    fds.clear();
+    DIR* dir = opendir("/proc/self/task");
+    if (dir == NULL) {
+      return false;
+    }
+    struct dirent* entry;
+    while ((entry = readdir(dir)) != NULL) {
+      if (entry->d_name[0] == '.') {
+        continue;
+      }
+      int fd = open_counter((pid_t) atoi(entry->d_name));
+      if (fd < 0) {
+        continue;
+      }
+      fds.push_back(fd);
+    }
+    closedir(dir);
+    for (int fd : fds) {
+      ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+      ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+    }
+    return !fds.empty();
+  }
+
+  long stop() {
+    if (fds.empty()) {
+      return -1;
+    }
+    long total = 0;
+    for (int fd : fds) {
+      ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+      long long count = 0;
+      if (read(fd, &count, sizeof(count)) == sizeof(count)) {
+        total += (long) count;
+      }
+      close(fd);
+    }
+    fds.clear();
+    return total;
+  }
+
+};
+
+} // end namespace
+
+#endif /*! _PCTL_PERF_COUNTER_H_ */
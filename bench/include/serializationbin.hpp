@@ -10,6 +10,11 @@
 
 namespace pasl {
 namespace pctl {
+
+// see textindex.hpp, to be included to read or write an index
+template <class Index>
+class text_index;
+
 namespace io {
 
 template <class Item>
@@ -206,6 +211,27 @@ struct write_to_file_struct<ray_cast_test> {
   }
 };
 
+// The text, the suffix array and the LCP; the lookup table and the
+// range-minimum structure are rebuilt on reading
+template <class Index>
+struct read_from_file_struct<text_index<Index>> {
+  text_index<Index> operator()(std::ifstream& in) {
+    parray<unsigned char> text = read_from_file<parray<unsigned char>>(in);
+    parray<Index> SA = read_from_file<parray<Index>>(in);
+    parray<Index> LCP = read_from_file<parray<Index>>(in);
+    return text_index<Index>(std::move(text), std::move(SA), std::move(LCP));
+  }
+};
+
+template <class Index>
+struct write_to_file_struct<text_index<Index>> {
+  void operator()(std::ofstream& out, text_index<Index>& index) {
+    write_to_file_struct<parray<unsigned char>>()(out, index.text);
+    write_to_file_struct<parray<Index>>()(out, index.SA);
+    write_to_file_struct<parray<Index>>()(out, index.LCP);
+  }
+};
+
 template <class intT>
 struct read_from_file_struct<graph::graph<intT>> {
   graph::graph<intT> operator()(std::ifstream& in) {
@@ -0,0 +1,91 @@
+/*!
+ * \file invertedindex_bench.cpp
+ * \brief Benchmarking script for tokenizing, word count and inverted index
+ * \date 2016
+ * \copyright COPYRIGHT (c) 2015 Umut Acar, Arthur Chargueraud, and
+ * Michael Rainey. All rights reserved.
+ * \license This project is released under the GNU Public License.
+ *
+ */
+
+#include <math.h>
+#include <chrono>
+#include <functional>
+#include "bench.hpp"
+#include "invertedindex.hpp"
+#include "loaders.hpp"
+
+/***********************************************************************/
+
+using namespace pasl::pctl;
+
+// phase=tokenize measures the tokenizer, phase=count the tokenizer and
+// the word count, and phase=index the tokenizer and the inverted index.
+// The throughput is in tokens per second, and the index size is given per
+// distinct term.
+void pbbs_pctl_call(pbbs::measured_type measured, const std::string& x) {
+  long nb_tokens = 0;
+  long nb_terms = 0;
+  long index_bytes = 0;
+  double seconds = 0.0;
+  auto timed = [&] (const std::function<void()>& f) {
+    measured([&] {
+      auto start = std::chrono::system_clock::now();
+      f();
+      std::chrono::duration<double> diff = std::chrono::system_clock::now() - start;
+      seconds = diff.count();
+    });
+  };
+  deepsea::cmdline::dispatcher d;
+  d.add("tokenize", [&] {
+    timed([&] {
+      tokens toks(x.c_str(), x.length());
+      nb_tokens = toks.size();
+    });
+  });
+  d.add("count", [&] {
+    timed([&] {
+      tokens toks(x.c_str(), x.length());
+      nb_tokens = toks.size();
+      nb_terms = word_counts(toks).size();
+    });
+  });
+  d.add("index", [&] {
+    timed([&] {
+      tokens toks(x.c_str(), x.length());
+      nb_tokens = toks.size();
+      inverted_index index(toks);
+      nb_terms = index.nb_terms();
+      index_bytes = index.size_in_bytes();
+    });
+  });
+  d.dispatch_or_default("phase", "index");
+  printf("text_length %ld\n", (long)x.length());
+  printf("tokens %ld\n", nb_tokens);
+  printf("terms %ld\n", nb_terms);
+  printf("tokens_per_s %.3lf\n", nb_tokens / std::max(seconds, 1e-9));
+  if (index_bytes > 0) {
+    printf("index_mb %.3lf\n", (double)index_bytes / (1 << 20));
+    printf("bytes_per_term %.3lf\n", (double)index_bytes / std::max(1L, nb_terms));
+  }
+}
+
+int main(int argc, char** argv) {
+  pbbs::launch(argc, argv, [&] (pbbs::measured_type measured) {
+    std::string infile = deepsea::cmdline::parse_or_default_string("infile", "");
+    if (infile != "") {
+      std::string x = pasl::pctl::io::load<std::string>(infile);
+      pbbs_pctl_call(measured, x);
+      return;
+    }
+    long n = deepsea::cmdline::parse_or_default_long("n", 100000000);
+    bool reload = deepsea::cmdline::parse_or_default_int("reload", 0) == 1;
+    system("mkdir tests");
+    std::string file = "tests/trigram_string_" + std::to_string(n);
+    std::string x = pasl::pctl::io::load_trigram_string(file, n, reload);
+    pbbs_pctl_call(measured, x);
+  });
+  return 0;
+}
+
+/***********************************************************************/
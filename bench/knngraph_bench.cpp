@@ -0,0 +1,82 @@
+/*!
+ * \file knngraph_bench.cpp
+ * \brief Benchmarking script for the k-nearest neighbor graph of vectors
+ * \date 2016
+ * \copyright COPYRIGHT (c) 2015 Umut Acar, Arthur Chargueraud, and
+ * Michael Rainey. All rights reserved.
+ * \license This project is released under the GNU Public License.
+ *
+ */
+
+#include <math.h>
+#include <functional>
+#include <stdlib.h>
+#include "bench.hpp"
+#include "geometrydata.hpp"
+#include "knngraph.hpp"
+
+/***********************************************************************/
+
+/*---------------------------------------------------------------------*/
+
+template <class Item>
+using parray = pasl::pctl::parray<Item>;
+
+// The fraction of the exact k nearest neighbors found by the graph, over
+// a sample of the vectors, each one compared with all the others
+double recall(parray<float>& x, long n, int d, int k, pasl::pctl::graph::graph<int>& g, long samples) {
+  samples = std::min(samples, n);
+  parray<long> found(samples, [&] (long s) {
+    long u = (s * 7919) % n;
+    std::vector<std::pair<float, int>> all;
+    for (long v = 0; v < n; v++) {
+      if (v != u) {
+        all.push_back(std::make_pair(pasl::pctl::squared_l2<float>::run(&x[u * d], &x[v * d], d), (int) v));
+      }
+    }
+    int m = (int) std::min((long) k, n - 1);
+    std::partial_sort(all.begin(), all.begin() + m, all.end());
+    long f = 0;
+    for (int j = 0; j < g.V[u].degree; j++) {
+      for (int l = 0; l < m; l++) {
+        if (g.V[u].Neighbors[j] == all[l].second) {
+          f++;
+          break;
+        }
+      }
+    }
+    return f;
+  });
+  long total = pasl::pctl::level1::reduce(found.cbegin(), found.cend(), 0L, [&] (long a, long b) {
+    return a + b;
+  }, [&] (long f) {
+    return f;
+  });
+  return (double) total / std::max(1L, samples * std::min((long) k, n - 1));
+}
+
+int main(int argc, char** argv) {
+  pbbs::launch(argc, argv, [&] (pbbs::measured_type measured) {
+    long n = deepsea::cmdline::parse_or_default_long("n", 1000000);
+    int d = deepsea::cmdline::parse_or_default_int("d", 32);
+    int k = deepsea::cmdline::parse_or_default_int("k", 10);
+    int clusters = deepsea::cmdline::parse_or_default_int("clusters", 100);
+    int trees = deepsea::cmdline::parse_or_default_int("trees", 4);
+    int iterations = deepsea::cmdline::parse_or_default_int("iterations", 10);
+    double delta = deepsea::cmdline::parse_or_default_double("delta", 0.001);
+    long samples = deepsea::cmdline::parse_or_default_long("recall_samples", 0);
+    parray<float> x = pasl::pctl::clustered_vectors<float>(n, d, clusters);
+    pasl::pctl::graph::graph<int> g(NULL, 0, 0);
+    measured([&] {
+      g = pasl::pctl::knn_graph(x.cbegin(), n, d, k, trees, iterations, delta);
+    });
+    printf("edges %d\n", g.m);
+    if (samples > 0) {
+      printf("recall %.4lf\n", recall(x, n, d, k, g, samples));
+    }
+    g.del();
+  });
+  return 0;
+}
+
+/***********************************************************************/
@@ -0,0 +1,90 @@
+/*!
+ * \file lz77_bench.cpp
+ * \brief Benchmarking script for LZ77 factorization and decoding
+ * \date 2016
+ * \copyright COPYRIGHT (c) 2015 Umut Acar, Arthur Chargueraud, and
+ * Michael Rainey. All rights reserved.
+ * \license This project is released under the GNU Public License.
+ *
+ */
+
+#include <math.h>
+#include <chrono>
+#include <functional>
+#include "bench.hpp"
+#include "lz77.hpp"
+#include "loaders.hpp"
+
+/***********************************************************************/
+
+using namespace pasl::pctl;
+
+// phase=encode measures the factorization with the suffix array,
+// phase=factorize the factorization from a cached suffix array and
+// phase=decode the decoding. The throughput is in megabytes of text per
+// second.
+void pbbs_pctl_call(pbbs::measured_type measured, std::string sa_file, const std::string& x) {
+  bool reload = deepsea::cmdline::parse_or_default_int("reload", 0) == 1;
+  std::string phase = deepsea::cmdline::parse_or_default_string("phase", "encode");
+  long n = x.length();
+  parray<lz77_phrase<intT>> phrases;
+  double seconds = 0.0;
+  auto timed = [&] (const std::function<void()>& f) {
+    measured([&] {
+      auto start = std::chrono::system_clock::now();
+      f();
+      std::chrono::duration<double> diff = std::chrono::system_clock::now() - start;
+      seconds = diff.count();
+    });
+  };
+  if (phase == "encode") {
+    timed([&] {
+      phrases = lz77_factorize(x.c_str(), n);
+    });
+  } else if (phase == "factorize" || phase == "decode") {
+    parray<intT> SA = pasl::pctl::io::load(sa_file, [&] {
+      return suffix_array((unsigned char*)&x[0], (intT)n);
+    }, reload);
+    if (phase == "factorize") {
+      timed([&] {
+        phrases = lz77_factorize(x.c_str(), SA);
+      });
+    } else {
+      phrases = lz77_factorize(x.c_str(), SA);
+      std::string y;
+      timed([&] {
+        y = lz77_decode(phrases);
+      });
+      if (y != x) {
+        std::cerr << "decoding error" << std::endl;
+        exit(1);
+      }
+    }
+  } else {
+    std::cerr << "unknown phase " << phase << std::endl;
+    exit(1);
+  }
+  printf("text_length %ld\n", n);
+  printf("phrases %ld\n", (long)phrases.size());
+  printf("mb_per_s %.3lf\n", (double)n / (1 << 20) / std::max(seconds, 1e-9));
+}
+
+int main(int argc, char** argv) {
+  pbbs::launch(argc, argv, [&] (pbbs::measured_type measured) {
+    std::string infile = deepsea::cmdline::parse_or_default_string("infile", "");
+    if (infile != "") {
+      std::string x = pasl::pctl::io::load<std::string>(infile);
+      pbbs_pctl_call(measured, infile + ".usa", x);
+      return;
+    }
+    int n = deepsea::cmdline::parse_or_default_int("n", 10000000);
+    bool reload = deepsea::cmdline::parse_or_default_int("reload", 0) == 1;
+    system("mkdir tests");
+    std::string file = "tests/trigram_string_" + std::to_string(n);
+    std::string x = pasl::pctl::io::load_trigram_string(file, n, reload);
+    pbbs_pctl_call(measured, file + ".usa", x);
+  });
+  return 0;
+}
+
+/***********************************************************************/
@@ -10,9 +10,12 @@
 
 #include <math.h>
 #include <functional>
+#include <chrono>
 #include <stdlib.h>
 #include "bench.hpp"
+#include "perfcounter.hpp"
 #include "nearestneighbors.hpp"
+#include "pointkdtree.hpp"
 #include "loaders.hpp"
 #include "nearestNeighbors.h"
 
@@ -39,6 +42,88 @@ parray<pbbs::_point3d<double>> to_pbbs(parray<pasl::pctl::_point3d<double>>& poi
   return result;
 }
 
+// layout=soa runs on the Morton-ordered point cloud, layout=vertices on
+// the tree of vertex pointers and layout=kdtree on the median-split k-d
+// tree; compare=1 also runs the other layout (soa, or vertices for soa)
+// after the measured run and reports the speedup of the first. The cache
+// misses are reported when the hardware counters are available.
+//
+// eps and max_leaves select the approximate search of every layout;
+// recall=1 then reports the fraction of the exact
+// neighbors found, and the number of points searched per second, for
+// recall / throughput curves over a range of eps or max_leaves.
+template <class Item1, int K>
+void pctl_layout_call(pbbs::measured_type measured, parray<Item1>& x, int k) {
+  std::string layout = deepsea::cmdline::parse_or_default_string("layout", "soa");
+  bool compare = deepsea::cmdline::parse_or_default_int("compare", 0) == 1;
+  double eps = deepsea::cmdline::parse_or_default_double("eps", 0.0);
+  long max_leaves = deepsea::cmdline::parse_or_default_long("max_leaves", -1L);
+  bool recall = deepsea::cmdline::parse_or_default_int("recall", 0) == 1;
+  int n = (int)x.size();
+  auto run = [&] (const std::string& l, double e, long m) -> parray<int> {
+    if (l == "soa") {
+      return pasl::pctl::ANN<int, K, Item1>(x, n, k, e, m);
+    } else if (l == "vertices") {
+      return pasl::pctl::ANN_vertices<int, K, Item1>(x, n, k, e, m);
+    } else if (l == "kdtree") {
+      return pasl::pctl::kdtree_ANN<int, K, Item1>(x, n, k, e, m);
+    } else {
+      std::cerr << "unknown layout " << l << std::endl;
+      exit(1);
+    }
+  };
+  pbbs::cache_miss_counter counter;
+  double seconds = 0.0;
+  parray<int> result;
+  counter.start();
+  measured([&] {
+    auto start = std::chrono::system_clock::now();
+    result = run(layout, eps, max_leaves);
+    std::chrono::duration<double> diff = std::chrono::system_clock::now() - start;
+    seconds = diff.count();
+  });
+  long misses = counter.stop();
+  if (misses >= 0) {
+    printf("cache_misses %ld\n", misses);
+  }
+  if (recall) {
+    parray<int> exact = run(layout, 0.0, -1L);
+    int m = std::min(n - 1, k);
+    parray<long> found(n, [&] (long i) {
+      long f = 0;
+      for (int j = 0; j < m; j++) {
+        for (int l = 0; l < m; l++) {
+          if (result[i * k + j] == exact[i * k + l]) {
+            f++;
+            break;
+          }
+        }
+      }
+      return f;
+    });
+    long total = pasl::pctl::level1::reduce(found.cbegin(), found.cend(), 0L, [&] (long a, long b) {
+      return a + b;
+    }, [&] (long f) {
+      return f;
+    });
+    printf("recall %.4lf\n", (double) total / std::max(1L, (long) n * m));
+    printf("queries_per_second %.0lf\n", n / std::max(seconds, 1e-9));
+  }
+  if (compare) {
+    std::string other = (layout == "soa") ? "vertices" : "soa";
+    counter.start();
+    auto start = std::chrono::system_clock::now();
+    run(other, eps, max_leaves);
+    std::chrono::duration<double> diff = std::chrono::system_clock::now() - start;
+    long other_misses = counter.stop();
+    printf("other_exectime %.3lf\n", diff.count());
+    if (other_misses >= 0) {
+      printf("other_cache_misses %ld\n", other_misses);
+    }
+    printf("speedup %.3lf\n", diff.count() / std::max(seconds, 1e-9));
+  }
+}
+
 template <class Item1, class Item2, int K>
 void pbbs_pctl_call(pbbs::measured_type measured, parray<Item1>& x, int k) {
   std::string lib_type = deepsea::cmdline::parse_or_default_string("lib_type", "pctl");
@@ -48,9 +133,7 @@ void pbbs_pctl_call(pbbs::measured_type measured, parray<Item1>& x, int k) {
       pbbs::findNearestNeighbors<K, Item2>(&y[0], (int)y.size(), k);
     });
   } else {
-    measured([&] {
-      pasl::pctl::ANN<int, K, Item1>(x, (int)x.size(), k);
-    });
+    pctl_layout_call<Item1, K>(measured, x, k);
   }
 }
 
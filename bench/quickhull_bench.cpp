@@ -13,6 +13,7 @@
 #include <stdlib.h>
 #include "bench.hpp"
 #include "hull.hpp"
+#include "hull3d.hpp"
 #include "loaders.hpp"
 #include "hull.h"
 
@@ -45,6 +46,17 @@ void pbbs_pctl_call(pbbs::measured_type measured, parray<pasl::pctl::_point2d<do
   }
 }
 
+// There is no 3d hull in pbbs to compare with
+void pctl_call_3d(pbbs::measured_type measured, parray<pasl::pctl::_point3d<double>>& x) {
+  long nb_facets = 0;
+  measured([&] {
+    pasl::pctl::triangles<pasl::pctl::_point3d<double>> t = pasl::pctl::hull3d(x);
+    nb_facets = t.num_triangles;
+    t.del();
+  });
+  printf("facets %ld\n", nb_facets);
+}
+
 int main(int argc, char** argv) {
   pbbs::launch(argc, argv, [&] (pbbs::measured_type measured) {
     std::string infile = deepsea::cmdline::parse_or_default_string("infile", "");
@@ -84,6 +96,22 @@ int main(int argc, char** argv) {
         a = pasl::pctl::io::load_points_uniform_2d(std::string("tests/random_on_sphere_2d_") + std::to_string(n), n, false, true, reload);
       }
       pbbs_pctl_call(measured, a);
+    } else if (test == 3) {
+      parray<pasl::pctl::_point3d<double>> a;
+      if (files) {
+        a = pasl::pctl::io::load_seq_from_txt<pasl::pctl::_point3d<double>>(std::string("tests/random_in_sphere_3d_txt_10000000"), path_to_data + std::string("3DinSphere_10M"), 10000000, reload);
+      } else {
+        a = pasl::pctl::io::load_points_uniform_3d(std::string("tests/random_in_sphere_3d_") + std::to_string(n), n, true, false, reload);
+      }
+      pctl_call_3d(measured, a);
+    } else if (test == 4) {
+      parray<pasl::pctl::_point3d<double>> a;
+      if (files) {
+        a = pasl::pctl::io::load_seq_from_txt<pasl::pctl::_point3d<double>>(std::string("tests/random_on_sphere_3d_txt_10000000"), path_to_data + std::string("3DonSphere_10M"), 10000000, reload);
+      } else {
+        a = pasl::pctl::io::load_points_uniform_3d(std::string("tests/random_on_sphere_3d_") + std::to_string(n), n, false, true, reload);
+      }
+      pctl_call_3d(measured, a);
     }
   });
   return 0;
@@ -0,0 +1,96 @@
+/*!
+ * \file rangemin_bench.cpp
+ * \brief Benchmarking script for range-minimum structures
+ * \date 2016
+ * \copyright COPYRIGHT (c) 2015 Umut Acar, Arthur Chargueraud, and
+ * Michael Rainey. All rights reserved.
+ * \license This project is released under the GNU Public License.
+ *
+ */
+
+#include <math.h>
+#include <utility>
+#include "bench.hpp"
+#include "rangemin.hpp"
+#include "loaders.hpp"
+
+/***********************************************************************/
+
+using namespace pasl::pctl;
+
+// nb ranges [i, j] of x, of length at most max_len, at pseudo-random
+// positions
+parray<std::pair<intT, intT>> random_ranges(intT n, long nb, intT max_len) {
+  return parray<std::pair<intT, intT>>(nb, [&] (long k) {
+    intT i = prandgen::hashi((int) (2 * k)) % n;
+    intT len = prandgen::hashi((int) (2 * k + 1)) % std::min(max_len, n - i);
+    return std::make_pair(i, i + len);
+  });
+}
+
+// rmq=compact for basic_compact_rmq and rmq=sparse for myRMQ; phase=build
+// measures the construction and phase=query a batch of queries
+void pbbs_pctl_call(pbbs::measured_type measured, parray<intT>& x) {
+  intT n = (intT) x.size();
+  long nb = deepsea::cmdline::parse_or_default_long("queries", 10000000);
+  intT max_len = (intT) deepsea::cmdline::parse_or_default_int("max_len", n);
+  std::string phase = deepsea::cmdline::parse_or_default_string("phase", "query");
+  parray<std::pair<intT, intT>> ranges = random_ranges(n, nb, std::max((intT) 1, max_len));
+  parray<intT> answers(nb);
+  long bytes = 0;
+  deepsea::cmdline::dispatcher d;
+  d.add("compact", [&] {
+    if (phase == "build") {
+      measured([&] {
+        compact_rmq rmq(x.cbegin(), n);
+        bytes = rmq.size_in_bytes();
+      });
+      return;
+    }
+    compact_rmq rmq(x.cbegin(), n);
+    bytes = rmq.size_in_bytes();
+    measured([&] {
+      rmq.query(ranges.cbegin(), ranges.cend(), answers.begin());
+    });
+  });
+  d.add("sparse", [&] {
+    if (phase == "build") {
+      measured([&] {
+        myRMQ rmq(x.begin(), n);
+        bytes = rmq.size_in_bytes();
+      });
+      return;
+    }
+    myRMQ rmq(x.begin(), n);
+    bytes = rmq.size_in_bytes();
+    measured([&] {
+      parallel_for(0L, nb, [&] (long k) {
+        answers[k] = rmq.query(ranges[k].first, ranges[k].second);
+      });
+    });
+  });
+  d.dispatch_or_default("rmq", "compact");
+  printf("n %ld\n", (long) n);
+  printf("memory_mb %.3lf\n", (double) bytes / (1 << 20));
+  printf("bits_per_item %.3lf\n", 8.0 * bytes / std::max((intT) 1, n));
+  printf("queries %ld\n", nb);
+}
+
+int main(int argc, char** argv) {
+  pbbs::launch(argc, argv, [&] (pbbs::measured_type measured) {
+    std::string infile = deepsea::cmdline::parse_or_default_string("infile", "");
+    if (infile != "") {
+      parray<intT> x = pasl::pctl::io::load<parray<intT>>(infile);
+      pbbs_pctl_call(measured, x);
+      return;
+    }
+    int n = deepsea::cmdline::parse_or_default_int("n", 10000000);
+    parray<intT> x(n, [&] (intT i) {
+      return (intT) (prandgen::hashi(i) % n);
+    });
+    pbbs_pctl_call(measured, x);
+  });
+  return 0;
+}
+
+/***********************************************************************/
@@ -26,10 +26,31 @@ using parray = pasl::pctl::parray<Item>;
 template <class Item, class Compare_fct>
 void pbbs_pctl_call(pbbs::measured_type measured, parray<Item>& x, const Compare_fct& compare) {
   std::string lib_type = deepsea::cmdline::parse_or_default_string("lib_type", "pctl");
+  // the case that the sorts detect and dispatch on, for inputs above PRESORT_THR
+  pasl::pctl::presortedness p = pasl::pctl::detect_presortedness(x.begin(), (int)x.size(), compare);
+  printf("presortedness %s\n", p.name());
+  printf("runs %ld\n", p.nb_runs);
+  // leaves of at most leaf_size elements go to the sorting network, when it
+  // is compiled in for this type (see sortingnetwork.hpp); 0 disables it
+  printf("sorting_network %d\n", (int) pasl::pctl::sorting_network_enabled<Item, Compare_fct>::value);
+  pasl::pctl::sorting_network_leaf_size() = deepsea::cmdline::parse_or_default_int("leaf_size", pasl::pctl::sorting_network_leaf_size());
+  bool leaf_sweep = deepsea::cmdline::parse_or_default_int("leaf_sweep", 0) == 1;
   if (lib_type == "pbbs") {
     measured([&] {
       pbbs::sampleSort(x.begin(), (int)x.size(), compare);
     });
+  } else if (leaf_sweep) {
+    // one run per leaf size, each on a fresh copy of the input
+    parray<Item> y;
+    for (int leaf_size = 0; leaf_size <= SORTNET_MAX; leaf_size = (leaf_size == 0) ? 4 : 2 * leaf_size) {
+      y = x;
+      pasl::pctl::sorting_network_leaf_size() = leaf_size;
+      printf("leaf_size %d\n", leaf_size);
+      measured([&] {
+        pasl::pctl::sample_sort(y.begin(), (int)y.size(), compare);
+      });
+    }
+    x.swap(y);
   } else {
     measured([&] {
       pasl::pctl::sample_sort(x.begin(), (int)x.size(), compare);
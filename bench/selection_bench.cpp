@@ -0,0 +1,100 @@
+/*!
+ * \file selection_bench.cpp
+ * \brief Benchmarking script for parallel selection, partial sort and top-k
+ * \date 2016
+ * \copyright COPYRIGHT (c) 2015 Umut Acar, Arthur Chargueraud, and
+ * Michael Rainey. All rights reserved.
+ * \license This project is released under the GNU Public License.
+ *
+ */
+
+#include <math.h>
+#include <functional>
+#include <stdlib.h>
+#include "bench.hpp"
+#include "selection.hpp"
+#include "loaders.hpp"
+
+/***********************************************************************/
+
+/*---------------------------------------------------------------------*/
+
+template <class Item>
+using parray = pasl::pctl::parray<Item>;
+
+// The rank k is given either directly by "k" or as a fraction of the input
+// size by "k_ratio", so that a single input can be swept across k/n ratios.
+int parse_k(int n) {
+  double k_ratio = deepsea::cmdline::parse_or_default_double("k_ratio", 0.01);
+  int k = deepsea::cmdline::parse_or_default_int("k", (int)(k_ratio * n));
+  return std::max(1, std::min(k, n));
+}
+
+template <class Item, class Compare_fct>
+void pbbs_pctl_call(pbbs::measured_type measured, parray<Item>& x, const Compare_fct& compare) {
+  std::string algo = deepsea::cmdline::parse_or_default_string("algo", "top_k");
+  int n = (int)x.size();
+  int k = parse_k(n);
+  std::cerr << "n = " << n << " k = " << k << std::endl;
+  if (algo == "nth_element") {
+    measured([&] {
+      pasl::pctl::nth_element(x.begin(), n, k - 1, compare);
+    });
+  } else if (algo == "partial_sort") {
+    measured([&] {
+      pasl::pctl::partial_sort(x.begin(), n, k, compare);
+    });
+  } else if (algo == "top_k") {
+    parray<Item> result;
+    measured([&] {
+      result = pasl::pctl::top_k(x.begin(), n, k, compare);
+    });
+  } else if (algo == "sample_sort") {
+    measured([&] {
+      pasl::pctl::sample_sort(x.begin(), n, compare);
+    });
+  } else {
+    std::cerr << "unknown algo " << algo << std::endl;
+    exit(1);
+  }
+}
+
+int main(int argc, char** argv) {
+  pbbs::launch(argc, argv, [&] (pbbs::measured_type measured) {
+    std::string infile = deepsea::cmdline::parse_or_default<std::string>("infile", "");
+    if (infile != "") {
+      deepsea::cmdline::dispatcher d;
+      d.add("array_double", [&] {
+        parray<double> x = pasl::pctl::io::load<parray<double>>(infile);
+        pbbs_pctl_call(measured, x, std::greater<double>());
+      });
+      d.add("array_int", [&] {
+        parray<int> x = pasl::pctl::io::load<parray<int>>(infile);
+        pbbs_pctl_call(measured, x, std::greater<int>());
+      });
+      d.dispatch("type");
+      return;
+    }
+
+    int test = deepsea::cmdline::parse_or_default_int("test", 0);
+    int n = deepsea::cmdline::parse_or_default_int("n", 10000000);
+    system("mkdir tests");
+
+    if (test == 0) {
+      parray<double> a = pasl::pctl::io::load_random_seq<double>(std::string("tests/random_seq_") + std::to_string(n), n);
+      pbbs_pctl_call(measured, a, std::greater<double>());
+    } else if (test == 1) {
+      parray<double> a = pasl::pctl::io::load_random_exp_dist_seq<double>(std::string("tests/random_exp_dist_seq_") + std::to_string(n), n);
+      pbbs_pctl_call(measured, a, std::greater<double>());
+    } else if (test == 2) {
+      parray<double> a = pasl::pctl::io::load_random_almost_sorted_seq<double>(std::string("tests/random_almost_sorted_seq_") + std::to_string(n), n, (int)sqrt(n));
+      pbbs_pctl_call(measured, a, std::greater<double>());
+    } else if (test == 3) {
+      parray<int> a = pasl::pctl::io::load_random_bounded_seq(std::string("tests/random_bounded_seq_") + std::to_string(n) + "_256", n, 256);
+      pbbs_pctl_call(measured, a, std::greater<int>());
+    }
+  });
+  return 0;
+}
+
+/***********************************************************************/
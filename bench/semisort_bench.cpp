@@ -0,0 +1,82 @@
+/*!
+ * \file semisort_bench.cpp
+ * \brief Benchmarking script for parallel semisort and group-by
+ * \date 2016
+ * \copyright COPYRIGHT (c) 2015 Umut Acar, Arthur Chargueraud, and
+ * Michael Rainey. All rights reserved.
+ * \license This project is released under the GNU Public License.
+ *
+ */
+
+#include <math.h>
+#include <functional>
+#include <stdlib.h>
+#include "bench.hpp"
+#include "semisort.hpp"
+#include "blockradixsort.hpp"
+#include "loaders.hpp"
+
+/***********************************************************************/
+
+/*---------------------------------------------------------------------*/
+
+template <class Item>
+using parray = pasl::pctl::parray<Item>;
+
+// algo=radix_sort groups the pairs by sorting them fully on the key, which
+// is what the callers of integer_sort do today
+void pbbs_pctl_call(pbbs::measured_type measured, parray<std::pair<int, int>>& x) {
+  std::string algo = deepsea::cmdline::parse_or_default_string("algo", "semisort");
+  if (algo == "semisort") {
+    measured([&] {
+      pasl::pctl::semisort(x.begin(), (int)x.size());
+    });
+  } else if (algo == "reduce_by_key") {
+    parray<std::pair<int, int>> result;
+    measured([&] {
+      result = pasl::pctl::reduce_by_key(x.begin(), (int)x.size(), 0, [&] (int a, int b) {
+        return a + b;
+      });
+    });
+    std::cerr << "groups " << result.size() << std::endl;
+  } else if (algo == "radix_sort") {
+    measured([&] {
+      pasl::pctl::integer_sort(x.begin(), (int)x.size());
+    });
+  } else {
+    std::cerr << "unknown algo " << algo << std::endl;
+    exit(1);
+  }
+}
+
+int main(int argc, char** argv) {
+  pbbs::launch(argc, argv, [&] (pbbs::measured_type measured) {
+    std::string infile = deepsea::cmdline::parse_or_default_string("infile", "");
+    if (infile != "") {
+      parray<std::pair<int, int>> x = pasl::pctl::io::load<parray<std::pair<int, int>>>(infile);
+      pbbs_pctl_call(measured, x);
+      return;
+    }
+
+    int test = deepsea::cmdline::parse_or_default_int("test", 0);
+    int n = deepsea::cmdline::parse_or_default_int("n", 10000000);
+    bool reload = deepsea::cmdline::parse_or_default_int("reload", 0) == 1;
+    system("mkdir tests");
+    parray<std::pair<int, int>> a;
+    if (test == 0) {
+      // keys in [0, n): mostly distinct
+      a = pasl::pctl::io::load_random_bounded_seq_with_int(std::string("tests/random_seq_int_int_") + std::to_string(n), n, n, n, reload);
+    } else if (test == 1) {
+      // keys in [0, 256): a few heavy keys
+      a = pasl::pctl::io::load_random_bounded_seq_with_int(std::string("tests/random_seq_int_int_") + std::to_string(n) + "_256", n, 256, n, reload);
+    } else if (test == 2) {
+      // keys in [0, range)
+      int range = deepsea::cmdline::parse_or_default_int("range", 100000);
+      a = pasl::pctl::io::load_random_bounded_seq_with_int(std::string("tests/random_seq_int_int_") + std::to_string(n) + "_" + std::to_string(range), n, range, n, reload);
+    }
+    pbbs_pctl_call(measured, a);
+  });
+  return 0;
+}
+
+/***********************************************************************/
@@ -9,8 +9,12 @@
  */
 
 #include <math.h>
+#include <fstream>
+#include <string>
+#include <climits>
 #include "bench.hpp"
 #include "suffixarray.hpp"
+#include "lcp.hpp"
 #include "loaders.hpp"
 #include "pks.h"
 
@@ -18,17 +22,113 @@
 
 using namespace pasl::pctl;
 
-void pbbs_pctl_call(pbbs::measured_type measured, std::string x) {
+// Resets the peak resident set size of the process (Linux only)
+void reset_peak_rss() {
+  std::ofstream out("/proc/self/clear_refs");
+  out << "5";
+}
+
+// Peak resident set size of the process, in megabytes
+double peak_rss_mb() {
+  std::ifstream in("/proc/self/status");
+  std::string line;
+  while (std::getline(in, line)) {
+    if (line.compare(0, 6, "VmHWM:") == 0) {
+      return atol(line.c_str() + 6) / 1024.0;
+    }
+  }
+  return 0.0;
+}
+
+// Random text over ACGT, of any length
+std::string random_dna_string(long n) {
+  std::string x(n, 'A');
+  parallel_for(0L, n, [&] (long i) {
+    unsigned long h = (unsigned long) i * 0x9E3779B97F4A7C15UL;
+    h = (h ^ (h >> 31)) * 0xBF58476D1CE4E5B9UL;
+    x[i] = "ACGT"[(h >> 40) & 3];
+  });
+  return x;
+}
+
+// mode=lcp measures the LCP of a suffix array cached in sa_file, which is
+// built first if absent; lcp=dc3 measures instead DC3 finding the suffix
+// array and the LCP together
+template <class Index, class SA_fct>
+void pbbs_pctl_lcp_call(pbbs::measured_type measured, std::string& x, std::string sa_file, const SA_fct& sa) {
+  std::string lcp = deepsea::cmdline::parse_or_default_string("lcp", "phi");
+  bool reload = deepsea::cmdline::parse_or_default_int("reload", 0) == 1;
+  if (lcp == "dc3") {
+    measured([&] {
+      parray<long> suffixes;
+      parray<long> LCP;
+      pasl::pctl::suffix_array(&x[0], (long)x.length(), true, suffixes, LCP);
+    });
+    return;
+  }
+  parray<Index> SA = pasl::pctl::io::load(sa_file, sa, reload);
+  reset_peak_rss();
+  measured([&] {
+    pasl::pctl::lcp_array(x.c_str(), SA);
+  });
+}
+
+void pbbs_pctl_call(pbbs::measured_type measured, std::string x, std::string sa_file = "") {
   std::string lib_type = deepsea::cmdline::parse_or_default_string("lib_type", "pctl");
-  if (lib_type == "pbbs") {
+  std::string mode = deepsea::cmdline::parse_or_default_string("mode", "sa");
+  reset_peak_rss();
+  if (mode == "lcp") {
+    if (sa_file == "") {
+      sa_file = "tests/suffix_array_" + std::to_string(x.length());
+    }
+    if (x.length() > INT_MAX) {
+      pbbs_pctl_lcp_call<uint40>(measured, x, sa_file + "_uint40", [&] {
+        return pasl::pctl::suffix_array_large<uint40>(&x[0], (long)x.length());
+      });
+    } else {
+      pbbs_pctl_lcp_call<intT>(measured, x, sa_file, [&] {
+        return pasl::pctl::suffix_array(&x[0], x.length());
+      });
+    }
+  } else if (lib_type == "pbbs") {
     measured([&] {
       pbbs::suffixArray(&x[0], (int)x.length());
     });
   } else {
-    measured([&] {
-      pasl::pctl::suffix_array(&x[0], x.length());
+    suffix_array_algorithm algorithm = suffix_array_dc3;
+    deepsea::cmdline::dispatcher d;
+    d.add("dc3", [&] {
+      algorithm = suffix_array_dc3;
+    });
+    d.add("prefix_doubling", [&] {
+      algorithm = suffix_array_prefix_doubling;
     });
+    d.dispatch_or_default("algo", "dc3");
+    // index=long or index=uint40 for inputs of more than 2^31 characters
+    std::string index = deepsea::cmdline::parse_or_default_string("index", (x.length() > INT_MAX) ? "uint40" : "int");
+    if (index == "int" && x.length() > INT_MAX) {
+      std::cerr << "input of " << x.length() << " characters needs index=long or index=uint40\n";
+      exit(1);
+    }
+    deepsea::cmdline::dispatcher di;
+    di.add("int", [&] {
+      measured([&] {
+        pasl::pctl::suffix_array(&x[0], x.length(), algorithm);
+      });
+    });
+    di.add("long", [&] {
+      measured([&] {
+        pasl::pctl::suffix_array_large<long>(&x[0], (long)x.length(), algorithm);
+      });
+    });
+    di.add("uint40", [&] {
+      measured([&] {
+        pasl::pctl::suffix_array_large<uint40>(&x[0], (long)x.length(), algorithm);
+      });
+    });
+    di.dispatch_or_default("index", index);
   }
+  printf("peak_rss_mb %.3lf\n", peak_rss_mb());
 }
 
 int main(int argc, char** argv) {
@@ -36,35 +136,54 @@ int main(int argc, char** argv) {
     std::string infile = deepsea::cmdline::parse_or_default_string("infile", "");
     if (infile != "") {
       std::string x = pasl::pctl::io::load<std::string>(infile);
-      pbbs_pctl_call(measured, x);
+      pbbs_pctl_call(measured, x, infile + ".sa");
       return;
     }
     int test = deepsea::cmdline::parse_or_default_int("test", 0);
-    int n = deepsea::cmdline::parse_or_default_int("n", 10000000);
+    long n = deepsea::cmdline::parse_or_default_long("n", (test == 4) ? 3L << 30 : 10000000);
     bool files = deepsea::cmdline::parse_or_default_int("files", 1) == 1;
     bool reload = deepsea::cmdline::parse_or_default_int("reload", 0) == 1;
     std::string path_to_data = deepsea::cmdline::parse_or_default_string("path_to_data", "/home/aksenov/pbbs/sequenceData/data/");
     system("mkdir tests");
     if (test == 0) {
       std::string a;
+      std::string file;
       if (files) {
-        a = pasl::pctl::io::load_string_from_txt("tests/trigram_string_txt_10000000", path_to_data + "trigramString_10000000", reload);
+        file = "tests/trigram_string_txt_10000000";
+        a = pasl::pctl::io::load_string_from_txt(file, path_to_data + "trigramString_10000000", reload);
       } else {
-        a = pasl::pctl::io::load_trigram_string("tests/trigram_string_" + std::to_string(n), n, reload);
+        file = "tests/trigram_string_" + std::to_string(n);
+        a = pasl::pctl::io::load_trigram_string(file, n, reload);
       }
-      pbbs_pctl_call(measured, a);
+      pbbs_pctl_call(measured, a, file + ".sa");
     } else if (test == 1) {
       std::string a;
       a = pasl::pctl::io::load_string_from_txt("tests/chr22.dna.bin", path_to_data + "chr22.dna", reload);
-      pbbs_pctl_call(measured, a);
+      pbbs_pctl_call(measured, a, "tests/chr22.dna.sa");
     } else if (test == 2) {
       std::string a;
       a = pasl::pctl::io::load_string_from_txt("tests/etext99.bin", path_to_data + "etext99", reload);
-      pbbs_pctl_call(measured, a);
+      pbbs_pctl_call(measured, a, "tests/etext99.sa");
     } else if (test == 3) {
       std::string a;
       a = pasl::pctl::io::load_string_from_txt("tests/wikisamp.xml.bin", path_to_data + "wikisamp.xml", reload);
+      pbbs_pctl_call(measured, a, "tests/wikisamp.xml.sa");
+    } else if (test == 4) {
+      // large input: beyond 2^31 characters by default, indexed with uint40;
+      // text=trigrams for English-like text
+      std::string text = deepsea::cmdline::parse_or_default_string("text", "dna");
+      std::string a = (text == "trigrams") ? pasl::pctl::trigram_text(0, n) : random_dna_string(n);
       pbbs_pctl_call(measured, a);
+    } else if (test == 5) {
+      // repetitive text: tandem repeats of a random DNA string of length
+      // period, where the LCP are as long as the text
+      long period = deepsea::cmdline::parse_or_default_long("period", 1);
+      std::string r = random_dna_string(period);
+      std::string a(n, 'A');
+      parallel_for(0L, n, [&] (long i) {
+        a[i] = r[i % period];
+      });
+      pbbs_pctl_call(measured, a, "tests/tandem_" + std::to_string(period) + "_" + std::to_string(n) + ".sa");
     }
   });
   return 0;
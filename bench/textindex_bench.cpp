@@ -0,0 +1,83 @@
+/*!
+ * \file textindex_bench.cpp
+ * \brief Benchmarking script for batched queries on a full-text index
+ * \date 2016
+ * \copyright COPYRIGHT (c) 2015 Umut Acar, Arthur Chargueraud, and
+ * Michael Rainey. All rights reserved.
+ * \license This project is released under the GNU Public License.
+ *
+ */
+
+#include <math.h>
+#include "bench.hpp"
+#include "textindex.hpp"
+#include "loaders.hpp"
+
+/***********************************************************************/
+
+using namespace pasl::pctl;
+
+// nb patterns of length m: substrings of the text at pseudo-random
+// positions, one in four of them with its last character changed so that
+// some patterns do not occur
+parray<std::string> random_patterns(const text_index<intT>& index, long nb, long m) {
+  long n = index.size();
+  return parray<std::string>(nb, [&] (long i) {
+    long s = prandgen::hashi((int) i) % std::max(1L, n - m);
+    std::string p((const char*) index.text.cbegin() + s, std::min(m, n - s));
+    if (i % 4 == 3 && p.length() > 0) {
+      p[p.length() - 1] ^= 1;
+    }
+    return p;
+  });
+}
+
+void pbbs_pctl_call(pbbs::measured_type measured, std::string index_file, const std::string& x) {
+  bool reload = deepsea::cmdline::parse_or_default_int("reload", 0) == 1;
+  long nb = deepsea::cmdline::parse_or_default_long("queries", 1000000);
+  long m = deepsea::cmdline::parse_or_default_long("m", 8);
+  text_index<intT> index = pasl::pctl::io::load(index_file, [&] {
+    return text_index<intT>(x.c_str(), x.length());
+  }, reload);
+  parray<std::string> patterns = random_patterns(index, nb, m);
+  long matches = 0;
+  deepsea::cmdline::dispatcher d;
+  d.add("count", [&] {
+    measured([&] {
+      parray<long> counts = index.count(patterns);
+      matches = reduce(counts.cbegin(), counts.cend(), 0L, [&] (long a, long b) {
+        return a + b;
+      });
+    });
+  });
+  d.add("locate", [&] {
+    measured([&] {
+      text_index_matches<intT> r = index.locate(patterns);
+      matches = r.positions.size();
+    });
+  });
+  d.dispatch_or_default("query", "count");
+  printf("text_length %ld\n", index.size());
+  printf("queries %ld\n", nb);
+  printf("matches %ld\n", matches);
+}
+
+int main(int argc, char** argv) {
+  pbbs::launch(argc, argv, [&] (pbbs::measured_type measured) {
+    std::string infile = deepsea::cmdline::parse_or_default_string("infile", "");
+    if (infile != "") {
+      std::string x = pasl::pctl::io::load<std::string>(infile);
+      pbbs_pctl_call(measured, infile + ".index", x);
+      return;
+    }
+    int n = deepsea::cmdline::parse_or_default_int("n", 10000000);
+    bool reload = deepsea::cmdline::parse_or_default_int("reload", 0) == 1;
+    system("mkdir tests");
+    std::string file = "tests/trigram_string_" + std::to_string(n);
+    std::string x = pasl::pctl::io::load_trigram_string(file, n, reload);
+    pbbs_pctl_call(measured, file + ".index", x);
+  });
+  return 0;
+}
+
+/***********************************************************************/
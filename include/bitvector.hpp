@@ -0,0 +1,177 @@
+/* COPYRIGHT (c) 2015 Umut Acar, Arthur Chargueraud, and Michael
+ * Rainey
+ * All rights reserved.
+ *
+ * \file bitvector.hpp
+ * \brief Bit vector with constant-time rank and select
+ *
+ */
+
+#include <stdint.h>
+#if defined(__BMI2__)
+#include <immintrin.h>
+#endif
+#include "datapar.hpp"
+
+#ifndef _PBBS_PCTL_BITVECTOR_H_
+#define _PBBS_PCTL_BITVECTOR_H_
+
+namespace pasl {
+namespace pctl {
+
+// Number of 64-bit words per rank block: the number of ones before each
+// block is stored, so that rank costs at most this many popcounts, for an
+// overhead of 64 / (64 * RANK_BLOCK_WORDS) bits per bit
+#define RANK_BLOCK_WORDS 8
+// Number of ones (and of zeros) between select samples: the rank block of
+// every SELECT_SAMPLE-th one and zero is stored, and select searches the
+// blocks between two samples, for an overhead of at most 64 / SELECT_SAMPLE
+// bits per bit
+#define SELECT_SAMPLE 4096
+
+// Position of the set bit of x of rank r, for r < popcount(x): a pdep on
+// BMI2, skipping bytes then clearing the lowest bits otherwise
+inline int select_in_word(uint64_t x, long r) {
+#if defined(__BMI2__)
+  return __builtin_ctzl(_pdep_u64(1UL << r, x));
+#else
+  int i = 0;
+  int c;
+  while (r >= (c = __builtin_popcountl(x & 0xff))) {
+    r -= c;
+    x >>= 8;
+    i += 8;
+  }
+  for (; r > 0; r--) {
+    x &= x - 1;
+  }
+  return i + __builtin_ctzl(x);
+#endif
+}
+
+class rank_bitvector {
+private:
+
+  long n;
+  parray<uint64_t> words;
+  parray<long> blocks;
+  // samples[one][k] is the block of the one, or zero, of rank
+  // k * SELECT_SAMPLE, followed by the last block
+  parray<long> samples[2];
+
+  // Number of ones, or zeros, before block b
+  long before(bool one, long b) const {
+    return one ? blocks[b] : std::min(n, b * RANK_BLOCK_WORDS * 64) - blocks[b];
+  }
+
+  // The last block b in [lo, hi] with j ones, or zeros, or fewer before it
+  long find_block(bool one, long j, long lo, long hi) const {
+    while (lo < hi) {
+      long mid = (lo + hi + 1) / 2;
+      if (before(one, mid) <= j) {
+        lo = mid;
+      } else {
+        hi = mid - 1;
+      }
+    }
+    return lo;
+  }
+
+  long select(bool one, long j) const {
+    long k = j / SELECT_SAMPLE;
+    long b = find_block(one, j, samples[one][k], samples[one][k + 1]);
+    j -= before(one, b);
+    for (long w = b * RANK_BLOCK_WORDS; ; w++) {
+      uint64_t x = one ? words[w] : ~words[w];
+      long c = __builtin_popcountl(x);
+      if (j < c) {
+        return w * 64 + select_in_word(x, j);
+      }
+      j -= c;
+    }
+  }
+
+public:
+
+  rank_bitvector()
+  : n(0) { }
+
+  // Bit i is bit(i), for i in [0, n); built in parallel, a word at a time
+  template <class Pred>
+  rank_bitvector(long n, const Pred& bit)
+  : n(n) {
+    long nb_words = n / 64 + 1;
+    words = parray<uint64_t>(nb_words, [&] (long w) {
+      uint64_t x = 0;
+      long hi = std::min(64L, n - w * 64);
+      for (long j = 0; j < hi; j++) {
+        x |= (uint64_t) (bit(w * 64 + j) ? 1 : 0) << j;
+      }
+      return x;
+    });
+    long nb_blocks = (nb_words + RANK_BLOCK_WORDS - 1) / RANK_BLOCK_WORDS;
+    blocks = parray<long>(nb_blocks + 1, [&] (long b) {
+      long ones = 0;
+      for (long w = b * RANK_BLOCK_WORDS; w < std::min(nb_words, (b + 1) * RANK_BLOCK_WORDS); w++) {
+        ones += __builtin_popcountl(words[w]);
+      }
+      return ones;
+    });
+    dps::scan(blocks.begin(), blocks.end(), 0L, [&] (long x, long y) {
+      return x + y;
+    }, blocks.begin(), forward_exclusive_scan);
+    for (int one = 0; one < 2; one++) {
+      long count = before(one, nb_blocks);
+      long nb_samples = (count + SELECT_SAMPLE - 1) / SELECT_SAMPLE;
+      samples[one] = parray<long>(nb_samples + 1, [&] (long k) {
+        return (k == nb_samples) ? nb_blocks - 1 : find_block(one, k * SELECT_SAMPLE, 0, nb_blocks - 1);
+      });
+    }
+  }
+
+  long size() const {
+    return n;
+  }
+
+  bool operator[](long i) const {
+    return (words[i / 64] >> (i % 64)) & 1;
+  }
+
+  // Number of ones in [0, i), for i in [0, n]
+  long rank1(long i) const {
+    long w = i / 64;
+    long r = blocks[w / RANK_BLOCK_WORDS];
+    for (long v = w - w % RANK_BLOCK_WORDS; v < w; v++) {
+      r += __builtin_popcountl(words[v]);
+    }
+    if (i % 64 != 0) {
+      r += __builtin_popcountl(words[w] & ((1UL << (i % 64)) - 1));
+    }
+    return r;
+  }
+
+  long rank0(long i) const {
+    return i - rank1(i);
+  }
+
+  // Position of the one of rank j, for j in [0, rank1(n))
+  long select1(long j) const {
+    return select(true, j);
+  }
+
+  // Position of the zero of rank j, for j in [0, rank0(n))
+  long select0(long j) const {
+    return select(false, j);
+  }
+
+  long size_in_bytes() const {
+    return sizeof(uint64_t) * words.size()
+      + sizeof(long) * (blocks.size() + samples[0].size() + samples[1].size());
+  }
+
+};
+
+} // end namespace
+} // end namespace
+
+#endif /*! _PBBS_PCTL_BITVECTOR_H_ */
@@ -169,7 +169,7 @@ void radix_loop_top_down(E* a, E* b, bIndexT* tmp, intT (*raw_buckets)[BUCKETS],
               eBits<intT, E, F>(MAX_RADIX, bits - MAX_RADIX, f));
     intT* offsets = raw_buckets[0];
     intT remain = raw_buckets_number - BUCKETS - 1;
-    float y = remain / (float) n;
+    double y = remain / (double) n;
     auto comp = [&] (intT l, intT r) {
       return (r == BUCKETS ? n : offsets[r]) - offsets[l];
     };
@@ -198,6 +198,8 @@ long integer_sort_space(intT n) {
 
 // Sorts the array A, which is of length n.
 // Function f maps each element into an integer in the range [0,max_value)
+// The type intT of n and max_value is also the type of the bucket counts:
+//   it can be int, or long for arrays of more than 2^31 items
 // If bucketOffsets is not NULL then it should be an array of length max_value
 // The offset in A of each bucket i in [0, max_value) is placed in location i
 //   such that for i < max_value - 1, offsets[i + 1] - offsets[i] gives the number
@@ -319,7 +321,7 @@ static void integer_sort(std::pair<uintT, T>* a, intT n) {
     pasl::pctl::level1::seq_reduce_rng_spec<std::pair<uintT, T>* , value_type_of<std::pair<uintT, T>* >> f;
     return f.f(_lo - lo, _lo, _hi, 0, combine, lift_idx);
   };
-  int max_value = level2::reduce(a, a + n, 0, combine, lift_comp_rng, lift_idx, seq_reduce_rng);
+  uintT max_value = level2::reduce(a, a + n, (uintT) 0, combine, lift_comp_rng, lift_idx, seq_reduce_rng);
   /*
   intT max_value = pasl::pctl::level1::reduce(a, a + n, 0, [&] (uintT a, uintT b) {
     return std::max(a, b);
@@ -24,7 +24,10 @@
 #include "datapar.hpp"
 #include "geometry.hpp"
 #include "nearestneighbors.hpp"
+#include "dynamicindex.hpp"
 #include "topology.hpp"
+#include "halfedge.hpp"
+#include "samplesort.hpp"
 
 #ifndef _PCTL_DELAUNAY_TRI_H_
 #define _PCTL_DELAUNAY_TRI_H_
@@ -41,89 +44,213 @@ using namespace std;
 //    ROUTINES FOR FINDING AND INSERTING A NEW POINT
 // *************************************************************
 
-// Finds a vertex (p) in a mesh starting at any triangle (start)
+// Finds a point (p) in a mesh starting at any half-edge (start), and
+// returns a half-edge of the triangle that contains it
 // Requires that the mesh is properly connected and convex
-simplex find(vertex *p, simplex start) {
-  simplex t = start;
+int find(const halfedge_mesh& mesh, point2d p, int start) {
+  int h = start;
   while (1) {
     int i;
     for (i = 0; i < 3; i++) {
-      t = t.rotClockwise();
-      if (t.outside(p)) {t = t.across(); break;}
+      h = halfedge_mesh::next(h);
+      if (mesh.outside(h, p)) {
+        if (mesh.twin[h] < 0) return h;
+        h = mesh.twin[h];
+        break;
+      }
     }
-    if (i == 3) return t;
-    if (!t.valid()) return t;
+    if (i == 3) return h;
   }
 }
 
-// Holds vertex and simplex queues used to store the cavity created
+// Holds vertex and half-edge queues used to store the cavity created
 // while searching from a vertex between when it is initially searched
-// and later checked to see if all corners are reserved.
+// and later checked to see if all corners are reserved, and the conflict
+// lists detached from the cavity while it is retriangulated, with the
+// half-edges out of the new vertex and their directions.
 struct queues {
-  vector<vertex*> vertex_queue;
-  vector<simplex> simplex_queue;
+  vector<int> vertex_queue;
+  vector<int> edge_queue;
+  vector<int> list_queue;
+  vector<int> fan_queue;
+  vector<vect2d> ray_queue;
+};
+
+// The conflict lists of the triangles of a mesh: the vertices not yet
+// inserted, linked by the triangle that contains them. first[t] is the
+// first vertex of the triangle t, or -1. The node of a vertex u holds the
+// next vertex of its triangle, or -1, its triangle, and a copy of its
+// point, so that moving u touches a single node.
+struct conflict_lists {
+  struct node {
+    point2d p;
+    int next;
+    int face;
+  };
+
+  parray<int> first;
+  parray<node> nodes;
+
+  conflict_lists() { }
+
+  // The vertices lo to n - 1 of the mesh, located by walks from start and
+  // bucketed by triangle
+  conflict_lists(const halfedge_mesh& mesh, intT lo, intT n, int start)
+  : first(mesh.nb_triangles(), -1), nodes(n) {
+    int m = (int) mesh.nb_triangles();
+    parallel_for(lo, n, [&] (intT u) {
+      nodes[u].p = mesh.points[u];
+      nodes[u].face = halfedge_mesh::face(find(mesh, mesh.points[u], start));
+    });
+    parray<int> sorted(n - lo, [&] (intT i) {
+      return (int) (lo + i);
+    });
+    parray<int> offsets(m + 1);
+    if (n > lo) {
+      intsort::integer_sort(sorted.begin(), offsets.begin(), (int) (n - lo), m, [&] (int u) {
+        return nodes[u].face;
+      });
+    }
+    offsets[m] = (int) (n - lo);
+    parallel_for(0, m, [&] (int t) {
+      for (int i = offsets[t + 1] - 1; i >= offsets[t]; i--) {
+        add(t, sorted[i]);
+      }
+    });
+  }
+
+  // The triangle of the vertex u
+  int face(int u) const {
+    return nodes[u].face;
+  }
+
+  void add(int t, int u) {
+    nodes[u].next = first[t];
+    nodes[u].face = t;
+    first[t] = u;
+  }
+
+  // Detaches the list of the triangle t, keeping its first vertex in lists
+  void detach(int t, vector<int>& lists) {
+    if (first[t] >= 0) {
+      lists.push_back(first[t]);
+      first[t] = -1;
+    }
+  }
+
+  // Adds the vertices of the lists detached in q->list_queue other than
+  // v, in the star of v, to its triangles: the triangle of a point is the
+  // one whose wedge at v, between two consecutive half-edges out of v,
+  // holds the point
+  void scatter(const halfedge_mesh& mesh, int v, queues* q) {
+    point2d o = mesh.points[v];
+    int e = mesh.out[v];
+    int g = e;
+    do {
+      q->fan_queue.push_back(g);
+      point2d w = mesh.points[mesh.target(g)];
+      q->ray_queue.push_back(w - o);
+      g = mesh.twin[halfedge_mesh::prev(g)];
+    } while (g != e);
+    int k = q->fan_queue.size();
+    q->ray_queue.push_back(q->ray_queue[0]);
+    for (int l : q->list_queue) {
+      for (int u = l, after; u >= 0; u = after) {
+        after = nodes[u].next;
+        if (u == v) {
+          continue;
+        }
+        vect2d d = nodes[u].p - o;
+        int i = 0;
+        double s = d.cross(q->ray_queue[0]);
+        for (; i < k; i++) {
+          double t = d.cross(q->ray_queue[i + 1]);
+          if (s <= 0.0 && t >= 0.0) {
+            break;
+          }
+          s = t;
+        }
+        // only rounding leaves no wedge, and then find walks from the first
+        add(halfedge_mesh::face(q->fan_queue[(i < k) ? i : 0]), u);
+      }
+    }
+    q->fan_queue.clear();
+    q->ray_queue.clear();
+  }
 };
 
-// Recursive routine for finding a cavity across an edge with
-// respect to a vertex p.
-// The simplex has orientation facing the direction it is entered.
+// Recursive routine for finding a cavity across a half-edge h with
+// respect to a point p.
+// The twin g of h is the half-edge through which T is entered.
 //
 //         a
 //         | \ --> recursive call
 //   p --> |T c
-// enter   | / --> recursive call
+// enter g | / --> recursive call
 //         b
 //
 //  If p is in circumcircle of T then
-//     add T to simplex_queue, c to vertex_queue, and recurse
-void findCavity(simplex t, vertex *p, queues *q) {
-  if (t.inCirc(p)) {
-    q->simplex_queue.push_back(t);
-    t = t.rotClockwise();
-    findCavity(t.across(), p, q);
-    q->vertex_queue.push_back(t.firstVertex());
-    t = t.rotClockwise();
-    findCavity(t.across(), p, q);
+//     add g to edge_queue, c to vertex_queue, and recurse
+void find_cavity(const halfedge_mesh& mesh, int h, point2d p, queues *q) {
+  int g = mesh.twin[h];
+  if (g >= 0 && mesh.in_circle(g, p)) {
+    q->edge_queue.push_back(g);
+    find_cavity(mesh, halfedge_mesh::next(g), p, q);
+    q->vertex_queue.push_back(mesh.apex(g));
+    find_cavity(mesh, halfedge_mesh::prev(g), p, q);
   }
 }
 
 // Finds the cavity for v and tries to reserve vertices on the
-// boundary (v must be inside of the simplex t)
+// boundary (v must be inside of the triangle of h)
 // The boundary vertices are pushed onto q->vertex_queue and
-// simplices to be deleted on q->simplex_queue (both initially empty)
-// It makes no side effects to the mesh other than to X->reserve
-void reserve_for_insert(vertex* v, simplex t, queues* q) {
+// half-edges to be flipped on q->edge_queue (both initially empty)
+// It makes no side effects to the mesh other than to mesh.reserve
+void reserve_for_insert(halfedge_mesh& mesh, int v, int h, queues* q) {
+  point2d p = mesh.points[v];
   // each iteration searches out from one edge of the triangle
   for (int i = 0; i < 3; i++) {
-    q->vertex_queue.push_back(t.firstVertex());
-    findCavity(t.across(), v, q);
-    t = t.rotClockwise();
+    q->vertex_queue.push_back(mesh.target(h));
+    find_cavity(mesh, h, p, q);
+    h = halfedge_mesh::next(h);
   }
   // the maximum id new vertex that tries to reserve a boundary vertex
   // will have its id written.  reserve starts out as -1
   for (intT i = 0; i < q->vertex_queue.size(); i++)
-    utils::writeMax(&((q->vertex_queue)[i]->reserve), v->id);
+    utils::writeMax(&mesh.reserve[(q->vertex_queue)[i]], v);
 }
 
-// checks if v "won" on all adjacent vertices and inserts point if so
-bool insert(vertex *v, simplex t, queues *q) {
+// checks if v "won" on all adjacent vertices and inserts point if so,
+// using the triangles t1 and t1 + 1 for the two new triangles
+// With conflict lists c, the vertices of the triangles of the cavity are
+// moved to the new triangles: v has reserved every vertex of these
+// triangles, so no other insertion touches their lists.
+bool insert(halfedge_mesh& mesh, int v, int h, queues *q, int t1, conflict_lists* c = NULL) {
   bool flag = 0;
   for (intT i = 0; i < q->vertex_queue.size(); i++) {
-    vertex* u = (q->vertex_queue)[i];
-    if (u->reserve == v->id) u->reserve = -1; // reset to -1
+    int u = (q->vertex_queue)[i];
+    if (mesh.reserve[u] == v) mesh.reserve[u] = -1; // reset to -1
     else flag = 1; // someone else with higher priority reserved u
   }
   if (!flag) {
-    tri* t1 = v->t;  // the memory for the two new triangles
-    tri* t2 = t1 + 1;
+    if (c != NULL) {
+      c->detach(halfedge_mesh::face(h), q->list_queue);
+      for (intT i = 0; i < q->edge_queue.size(); i++) {
+        c->detach(halfedge_mesh::face((q->edge_queue)[i]), q->list_queue);
+      }
+    }
     // the following 3 lines do all the side effects to the mesh.
-    t.split(v, t1, t2);
-    for (intT i = 0; i < q->simplex_queue.size(); i++) {
-      (q->simplex_queue)[i].flip();
+    mesh.split(h, v, t1, t1 + 1);
+    for (intT i = 0; i < q->edge_queue.size(); i++) {
+      mesh.flip((q->edge_queue)[i]);
+    }
+    if (c != NULL) {
+      c->scatter(mesh, v, q);
     }
   }
-  q->simplex_queue.clear();
+  q->edge_queue.clear();
   q->vertex_queue.clear();
+  q->list_queue.clear();
   return flag;
 }
 
@@ -131,21 +258,21 @@ bool insert(vertex *v, simplex t, queues *q) {
 //    CHECKING THE TRIANGULATION
 // *************************************************************
 
-void checkDelaunay1(tri *triangs, intT n, intT boundarySize) {
+void checkDelaunay1(const halfedge_mesh& mesh, intT boundarySize) {
+  intT n = mesh.nb_triangles();
   parray<intT> bcount(n, 0);
   parallel_for((intT)0, n, [&] (intT i) {
-    if (triangs[i].initialized >= 0) {
-      simplex t = simplex(&triangs[i],0);
-      for (int i=0; i < 3; i++) {
-        simplex a = t.across();
-        if (a.valid()) {
-          vertex* v = a.rotClockwise().firstVertex();
-          if (!t.outside(v)) {
-            cout << "Inside Out: "; v->pt.print(); t.print();}
-          if (t.inCirc(v)) {
-            cout << "In Circle Violation: "; v->pt.print(); t.print(); }
+    if (mesh.alive(i)) {
+      for (int j = 0; j < 3; j++) {
+        int h = 3 * i + j;
+        int g = mesh.twin[h];
+        if (g >= 0) {
+          point2d v = mesh.points[mesh.apex(g)];
+          if (!mesh.outside(h, v)) {
+            cout << "Inside Out: "; v.print(); cout << " at triangle " << i << endl;}
+          if (mesh.in_circle(h, v)) {
+            cout << "In Circle Violation: "; v.print(); cout << " at triangle " << i << endl;}
         } else bcount[i]++;
-        t = t.rotClockwise();
       }
     }
   });
@@ -165,9 +292,10 @@ struct maxpt {
 
 // P is the set of points to bound and n the number
 // bCount is the number of points to put on the boundary
-// v is an array to put the new points
-// t is an array to put the new triangles
-simplex generate_boundary(point2d* p, intT n, intT boundary_size, vertex* v, tri* t) {
+// the new points are the vertices n to n + boundary_size - 1 of mesh,
+// and the new triangles start at its triangle t
+// returns a half-edge of the first new triangle
+int generate_boundary(point2d* p, intT n, intT boundary_size, halfedge_mesh& mesh, intT t) {
   point2d minP = reduce(p, p + n, p[0], [&] (point2d a, point2d b) {
     return a.min_coord(b);
   });
@@ -179,30 +307,58 @@ simplex generate_boundary(point2d* p, intT n, intT boundary_size, vertex* v, tri
   double radius = stretch * size;
   point2d center = maxP + (maxP - minP)/2.0;
   
-  point2d* boundary = newA(point2d, boundary_size);
   double pi = 3.14159;
   
   // Generate the bounding points on a circle far outside the bounding box
   for (intT i=0; i < boundary_size; i++) {
     double x = radius * cos(2 * pi * ((float) i)/((float) boundary_size));
     double y = radius * sin(2 * pi * ((float) i)/((float) boundary_size));
-    boundary[i] = center + vect2d(x, y);
-    v[i] = vertex(boundary[i], i + n);
+    mesh.points[n + i] = center + vect2d(x, y);
   }
   
-  // Fill with simplices (bCount - 2  total simplices)
-  simplex s = simplex(&v[0], &v[1], &v[2], t);
-  for (intT i = 3; i < boundary_size; i++)
-    s = s.extend(&v[i], t + i - 2);
-  return s;
+  // Fill with simplices (bCount - 2  total simplices), in a fan around
+  // the first boundary point
+  for (intT i = 0; i < boundary_size - 2; i++) {
+    mesh.set_triangle(t + i, n, n + i + 1, n + i + 2);
+    if (i > 0) mesh.link(3 * (t + i), 3 * (t + i - 1) + 2);
+  }
+  return 3 * t;
 }
 
-
 // *************************************************************
 //    MAIN LOOP
 // *************************************************************
 
-void incrementally_add_points(vertex** v, intT n, vertex* start) {
+// Counters of a run of the main loop: a round is a set of insertions
+// tried in parallel, and a retry an insertion that lost a reservation
+struct delaunay_stats {
+  long rounds = 0;
+  long retries = 0;
+};
+
+// with dynamic_location, the vertices inserted are added to the point
+// location structure once they are more than 1 / DELAUNAY_PENDING_FRACTION
+// of those it holds
+#define DELAUNAY_PENDING_FRACTION 8
+
+// A vertex of the mesh as seen by the point location structure
+struct location_vertex {
+  typedef point2d pointT;
+  point2d pt;
+  intT id;
+};
+
+// The point location starts the walk of find from the nearest inserted
+// vertex: by default given by a tree regenerated every time the number of
+// inserted vertices grows by a factor of multiplier, and stale in between
+// (and for good after n / multiplier), or, with dynamic_location, by a
+// dynamic_point_index to which the vertices inserted are added in batches.
+//
+// The vertices v are inserted from the last one down, and the vertex i
+// uses the triangles 2i and 2i + 1 of the mesh; start is a vertex of the
+// mesh before the first insertion.
+void incrementally_add_points(halfedge_mesh& mesh, intT* v, intT n, intT start,
+                              bool dynamic_location = false, delaunay_stats* stats = NULL) {
   
   // various structures needed for each parallel insertion
   intT maxR = (intT) (n / 100) + 1; // maximum number to try in parallel
@@ -213,15 +369,24 @@ void incrementally_add_points(vertex** v, intT n, vertex* start) {
   for (intT i = 0; i < maxR; i++) {
     qs[i] = new (&qqs[i]) queues;
   }
-  parray<simplex> t(maxR);
+  parray<int> t(maxR);
   parray<bool> flags(maxR);
-  parray<vertex*> h(maxR);
+  parray<intT> h(maxR);
   
   // create a point location structure
-  typedef nearest_neighbours_ds<intT, vertex, 1> KNN;
-  KNN knn = KNN(&start, 1);
+  typedef nearest_neighbours_ds<intT, location_vertex, 1> KNN;
+  parray<location_vertex> lv(mesh.nb_vertices(), [&] (intT i) {
+    location_vertex u;
+    u.pt = mesh.points[i];
+    u.id = i;
+    return u;
+  });
+  location_vertex* lstart = &lv[start];
+  KNN knn = KNN(&lstart, 1);
   int multiplier = 8; // when to regenerate
   intT nextNN = multiplier;
+  dynamic_point_index<point2d> index;
+  intT indexed = 0; // number of vertices in the dynamic index
   
   intT top = n; intT rounds = 0; intT failed = 0;
   
@@ -229,10 +394,27 @@ void incrementally_add_points(vertex** v, intT n, vertex* start) {
   while (top > 0) {
     
     // every once in a while create a new point location
-    // structure using all points inserted so far
-    if ((n - top) >= nextNN && (n - top) < n / multiplier) {
+    // structure using all points inserted so far, or add them
+    // to the dynamic one
+    if (dynamic_location) {
+      // the vertices inserted since the last update, just above top
+      intT pending = (n - top) - indexed;
+      if (pending > 0 && pending >= indexed / DELAUNAY_PENDING_FRACTION) {
+        parray<point2d> pts(pending, [&] (intT j) {
+          return mesh.points[v[top + j]];
+        });
+        parray<int> ids(pending, [&] (intT j) {
+          return v[top + j];
+        });
+        index.insert(pts.begin(), ids.cbegin(), pending);
+        indexed += pending;
+      }
+    } else if ((n - top) >= nextNN && (n - top) < n / multiplier) {
       knn.del();
-      knn = KNN(v + top, n - top);
+      parray<location_vertex*> inserted(n - top, [&] (intT j) {
+        return &lv[v[top + j]];
+      });
+      knn = KNN(inserted.begin(), n - top);
       nextNN = nextNN * multiplier;
     }
     
@@ -240,31 +422,35 @@ void incrementally_add_points(vertex** v, intT n, vertex* start) {
     intT cnt = 1 + (n - top) / 100;  // 100 is pulled out of a hat
     cnt = (cnt > maxR) ? maxR : cnt;
     cnt = (cnt > top) ? top : cnt;
-    vertex** vv = v + top - cnt;
+    intT* vv = v + top - cnt;
     
     // for trial vertices find containing triangle, determine cavity
     // and reserve vertices on boundary of cavity
     parallel_for((intT)0, cnt, [&] (intT j) {
-      vertex *u = knn.nearest(vv[j]);
-      t[j] = find(vv[j], simplex(u->t, 0));
-      reserve_for_insert(vv[j], t[j], qs[j]);
+      intT u;
+      if (dynamic_location) {
+        int id = index.nearest(mesh.points[vv[j]]);
+        u = (id < 0) ? start : id;
+      } else {
+        u = knn.nearest(&lv[vv[j]])->id;
+      }
+      t[j] = find(mesh, mesh.points[vv[j]], mesh.out[u]);
+      reserve_for_insert(mesh, vv[j], t[j], qs[j]);
     });
     
     // For trial vertices check if they own their boundary and
     // update mesh if so.  flags[i] is 1 if failed (need to retry)
     parallel_for((intT)0, cnt, [&] (intT j) {
-      flags[j] = insert(vv[j], t[j], qs[j]);
+      flags[j] = insert(mesh, vv[j], t[j], qs[j], 2 * vv[j]);
     });
     
     // Pack failed vertices back onto Q and successful
     // ones up above (needed for point location structure)
     intT k = (intT)dps::pack(flags.cbegin(), vv, vv + cnt, h.begin());
-//    intT k = sequence::pack(vv,h,flags,cnt);
     parallel_for((intT)0, cnt, [&] (intT j) {
       flags[j] = !flags[j];
     });
     dps::pack(flags.cbegin(), vv, vv + cnt, h.begin() + k);
-//    sequence::pack(vv,h+k,flags,cnt);
     parallel_for((intT)0, cnt, [&] (intT j) {
       vv[j] = h[j];
     });
@@ -276,11 +462,12 @@ void incrementally_add_points(vertex** v, intT n, vertex* start) {
   
   knn.del();
   
-  //cout << "n=" << n << "  Total retries=" << failed
-  //     << "  Total rounds=" << rounds << endl;
+  if (stats != NULL) {
+    stats->rounds = rounds;
+    stats->retries = failed;
+  }
 }
 
-
 // *************************************************************
 //    DRIVER
 // *************************************************************
@@ -308,70 +495,226 @@ public:
   intT get(intT i) { return (i*k)%n; }
 };
 
-triangles<point2d> delaunay(parray<point2d>& p) {
+// *************************************************************
+//    BIASED RANDOMIZED INSERTION ORDER
+// *************************************************************
+
+// Size of the first BRIO round; every following round is twice the size
+// of all the rounds before it
+#define DELAUNAY_BRIO_FIRST 64
+// At most one insertion is tried in parallel per DELAUNAY_BRIO_SPREAD
+// vertices of the mesh
+#define DELAUNAY_BRIO_SPREAD 64
+
+// The distance of (x, y) along the Hilbert curve of the 2^32 x 2^32 grid
+inline unsigned long hilbert_key(unsigned int x, unsigned int y) {
+  unsigned long d = 0;
+  for (unsigned int s = 1u << 31; s > 0; s /= 2) {
+    unsigned int rx = (x & s) > 0;
+    unsigned int ry = (y & s) > 0;
+    d += (unsigned long) s * s * ((3 * rx) ^ ry);
+    if (ry == 0) {
+      if (rx == 1) {
+        x = ~x;
+        y = ~y;
+      }
+      std::swap(x, y);
+    }
+  }
+  return d;
+}
+
+// The order of insertion of the points of p, and the first position of
+// every BRIO round in it, followed by n: the points are randomly assigned
+// to rounds, the last of which holds about half of them, and every round
+// is sorted along a Hilbert curve
+parray<intT> brio_order(parray<point2d>& p, parray<intT>& round_starts) {
+  intT n = p.size();
+  std::vector<intT> starts(1, 0);
+  intT size = DELAUNAY_BRIO_FIRST;
+  while (starts.back() < n) {
+    starts.push_back(std::min(n, starts.back() + size));
+    size = starts.back();
+  }
+  intT nb_rounds = starts.size() - 1;
+  round_starts = parray<intT>(nb_rounds + 1, [&] (intT r) {
+    return starts[r];
+  });
+  point2d lo = reduce(p.begin(), p.end(), p[0], [&] (point2d a, point2d b) {
+    return a.min_coord(b);
+  });
+  point2d hi = reduce(p.begin(), p.end(), p[0], [&] (point2d a, point2d b) {
+    return a.max_coord(b);
+  });
+  double scale = 4294967295.0 / std::max(std::max(hi.x - lo.x, hi.y - lo.y), 1e-300);
+  // the point at position i of a random permutation is in the round of i
+  hashID hash(n);
+  parray<intT> order(n, [&] (intT i) {
+    return hash.get(i);
+  });
+  parray<intT> rounds(n);
+  parray<unsigned long> keys(n);
+  parallel_for((intT)0, n, [&] (intT i) {
+    intT j = order[i];
+    rounds[j] = (intT) (std::upper_bound(starts.begin(), starts.end(), i) - starts.begin()) - 1;
+    unsigned int x = (unsigned int) ((p[j].x - lo.x) * scale);
+    unsigned int y = (unsigned int) ((p[j].y - lo.y) * scale);
+    keys[j] = hilbert_key(x, y);
+  });
+  sample_sort(order.begin(), n, [&] (intT a, intT b) {
+    return (rounds[a] < rounds[b]) || (rounds[a] == rounds[b] && keys[a] < keys[b]);
+  });
+  return order;
+}
+
+// Inserts the vertices 0 to n - 1 of the mesh, in their order, by the
+// BRIO rounds given by round_starts. Every round is split into as many
+// contiguous runs of the Hilbert order as insertions can be tried in
+// parallel, and every step tries the next vertex of every run, so that
+// the vertices tried together are far apart, and those of a run, tried
+// one after the other, are close.
+//
+// The points are located by conflict lists: every triangle keeps the
+// vertices not yet inserted that it contains, and every insertion moves
+// those of its cavity to the triangles around the new vertex, so that
+// find only checks the triangle of the list of a vertex. The lists are
+// built once the first round is inserted, by walks over its small mesh in
+// parallel: the first round is a single run, whose insertions would
+// otherwise move most of the vertices one after the other, many times.
+// Until then, the vertices are located by walks from start.
+void brio_add_points(halfedge_mesh& mesh, intT n, int start, parray<intT>& round_starts,
+                     delaunay_stats* stats = NULL) {
+  intT maxR = (intT) (n / DELAUNAY_BRIO_SPREAD) + 1;
+  parray<queues> qqs;
+  qqs.prefix_tabulate(maxR, 0);
+  parray<queues*> qs;
+  qs.prefix_tabulate(maxR, 0);
+  for (intT i = 0; i < maxR; i++) {
+    qs[i] = new (&qqs[i]) queues;
+  }
+  parray<int> t(maxR);
+  parray<bool> flags(maxR);
+  parray<intT> next(maxR);
+  parray<intT> end(maxR);
+  parray<intT> runs(maxR);
+  parray<intT> active(maxR);
+  
+  conflict_lists conflicts;
+  
+  long steps = 0; long failed = 0;
+  intT nb_rounds = round_starts.size() - 1;
+  for (intT r = 0; r < nb_rounds; r++) {
+    intT lo = round_starts[r];
+    intT hi = round_starts[r + 1];
+    intT nb_runs = std::min(std::min(hi - lo, maxR), 1 + lo / DELAUNAY_BRIO_SPREAD);
+    if (r == 1) {
+      conflicts = conflict_lists(mesh, lo, n, start);
+    }
+    conflict_lists* c = (r == 0) ? NULL : &conflicts;
+    parallel_for((intT)0, nb_runs, [&] (intT j) {
+      next[j] = lo + (intT) ((long) (hi - lo) * j / nb_runs);
+      end[j] = lo + (intT) ((long) (hi - lo) * (j + 1) / nb_runs);
+      runs[j] = j;
+    });
+    intT nb_active = nb_runs;
+    while (nb_active > 0) {
+      parallel_for((intT)0, nb_active, [&] (intT j) {
+        intT u = next[runs[j]];
+        t[j] = find(mesh, mesh.points[u], (c == NULL) ? start : 3 * c->face(u));
+        reserve_for_insert(mesh, u, t[j], qs[j]);
+      });
+      parallel_for((intT)0, nb_active, [&] (intT j) {
+        intT k = runs[j];
+        flags[j] = insert(mesh, next[k], t[j], qs[j], 2 * next[k], c);
+        if (!flags[j]) {
+          next[k]++;
+        }
+      });
+      failed += level1::reduce(flags.cbegin(), flags.cbegin() + nb_active, 0L, [&] (long a, long b) {
+        return a + b;
+      }, [&] (bool f) {
+        return (long) f;
+      });
+      parallel_for((intT)0, nb_active, [&] (intT j) {
+        flags[j] = next[runs[j]] < end[runs[j]];
+      });
+      nb_active = (intT)dps::pack(flags.cbegin(), runs.cbegin(), runs.cbegin() + nb_active, active.begin());
+      runs.swap(active);
+      steps++;
+    }
+  }
+  
+  if (stats != NULL) {
+    stats->rounds = steps;
+    stats->retries = failed;
+  }
+}
+
+// With brio, the points are inserted by brio_add_points, in the order of
+// brio_order; dynamic_location then has no effect.
+triangles<point2d> delaunay(parray<point2d>& p, bool dynamic_location = false, bool brio = false,
+                            delaunay_stats* stats = NULL) {
   intT boundary_size = 10;
   int n = p.size();
   
-  // allocate space for vertices
+  // allocate space for vertices, and all the triangles needed
   intT num_vertices = n + boundary_size;
-  parray<vertex*> v(n); // don't need pointers to boundary
-  v.prefix_tabulate(n, 0);
-  parray<vertex> vv;
-  vv.prefix_tabulate(num_vertices, 0);
+  intT num_triangles = 2 * n + (boundary_size - 2);
+  halfedge_mesh mesh(num_vertices, num_triangles);
   
   // The points are psuedorandomly permuted
   
   hashID hash(n);
+  parray<intT> round_starts;
+  parray<intT> order;
+  if (brio) {
+    order = brio_order(p, round_starts);
+  } else {
+    order = parray<intT>(n, [&] (intT i) {
+      return hash.get(i);
+    });
+  }
   parallel_for((intT)0, n, [&] (intT i) {
-    v[i] = new (&vv[i]) vertex(p[hash.get(i)], i);
-  });
-  
-  // allocate all the triangles needed
-  intT num_triangles = 2 * n + (boundary_size - 2);
-  parray<tri> triangles;
-  triangles.prefix_tabulate(num_triangles, 0);
-  
-  // give two triangles to each vertex
-  parallel_for((intT)0, n, [&] (intT i) {
-    v[i]->t = triangles.begin() + 2 * i;
+    mesh.points[i] = p[order[i]];
   });
   
   // generate boundary points and fill with simplices
-  // The boundary points and simplices go at the end
-  simplex sboundary = generate_boundary(p.begin(), n, boundary_size, vv.begin() + n, triangles.begin() + 2*n);
-  vertex* v0 = sboundary.t->vtx[0];
+  // The boundary points and simplices go at the end, and every other
+  // vertex i gets the two triangles 2i and 2i + 1
+  int start = generate_boundary(p.begin(), n, boundary_size, mesh, 2 * n);
   
   // main loop to add all points
-  incrementally_add_points(v.begin(), n, v0);
-  v.clear();
-  if (CHECK) checkDelaunay1(triangles.begin(), num_triangles, boundary_size);
-  
-  triangle* rt = newA(triangle, num_triangles);
+  if (brio) {
+    brio_add_points(mesh, n, start, round_starts, stats);
+  } else {
+    parray<intT> v(n, [&] (intT i) {
+      return i;
+    });
+    incrementally_add_points(mesh, v.begin(), n, mesh.origin[start], dynamic_location, stats);
+  }
+  if (CHECK) checkDelaunay1(mesh, boundary_size);
   
   // Since points were permuted need to translate back to
   // original coordinates
   parray<intT> m(num_vertices, [&] (intT i) {
     if (i < n) {
-      return hash.get(i);
+      return order[i];
     } else {
       return i;
     }
   });
   
-  parallel_for((intT)0, num_triangles, [&] (intT i) {
-    vertex** vtx = triangles[i].vtx;
-    rt[i] = triangle(m[vtx[0]->id], m[vtx[1]->id], m[vtx[2]->id]);
-  });
-  m.clear();
   point2d* rp = newA(point2d, num_vertices);
   parallel_for((intT)0, n, [&] (intT i) {
     rp[i] = p[i];
   });
   parallel_for((intT)n, num_vertices, [&] (intT i) {
-    rp[i] = vv[i].pt;
+    rp[i] = mesh.points[i];
   });
   
-  return pasl::pctl::triangles<point2d>(num_vertices, num_triangles, rp, rt);
+  return mesh.to_triangles(num_vertices, rp, [&] (int u) {
+    return m[u];
+  });
 }
   
 // Note that this is not currently a complete test of correctness
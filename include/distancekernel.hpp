@@ -0,0 +1,207 @@
+/* COPYRIGHT (c) 2015 Umut Acar, Arthur Chargueraud, and Michael
+ * Rainey
+ * All rights reserved.
+ *
+ * \file distancekernel.hpp
+ * \brief Vectorized squared distances and k-best insertion for kNN leaves
+ *
+ */
+
+#include <algorithm>
+#if defined(__AVX2__) || defined(__AVX512F__)
+#include <immintrin.h>
+#endif
+
+#ifndef _PBBS_PCTL_DISTANCEKERNEL_H_
+#define _PBBS_PCTL_DISTANCEKERNEL_H_
+
+namespace pasl {
+namespace pctl {
+
+// The points of a leaf of a point cloud are consecutive in its coordinate
+// arrays, so that their squared distances to a query are computed a block
+// at a time, on AVX-512 (when compiled with __AVX512F__) or AVX2 (with
+// __AVX2__) vectors of doubles, and by a plain loop otherwise. The points
+// of the block closer than the current k-th nearest neighbor are then
+// inserted in the k best by a branchless network of selects.
+
+// Number of points whose distances are computed at once
+#define KNN_BLOCK 16
+
+// The vectors of higher dimension, e.g. embeddings, are stored one after
+// the other, and the squared distance between two of them is summed over
+// their coordinates a vector at a time, see squared_l2.
+
+template <class floatT>
+struct distance_vec {
+  static constexpr bool enabled = false;
+  static constexpr int width = 1;
+};
+
+#if defined(__AVX512F__)
+
+template <>
+struct distance_vec<double> {
+  static constexpr bool enabled = true;
+  static constexpr int width = 8;
+  typedef __m512d vec;
+  static vec load(const double* p) { return _mm512_loadu_pd(p); }
+  static void store(double* p, vec v) { _mm512_storeu_pd(p, v); }
+  static vec set1(double x) { return _mm512_set1_pd(x); }
+  static vec sub(vec a, vec b) { return _mm512_sub_pd(a, b); }
+  static vec mul(vec a, vec b) { return _mm512_mul_pd(a, b); }
+  // a * b + c
+  static vec mul_add(vec a, vec b, vec c) { return _mm512_fmadd_pd(a, b, c); }
+  static double sum(vec v) { return _mm512_reduce_add_pd(v); }
+};
+
+template <>
+struct distance_vec<float> {
+  static constexpr bool enabled = true;
+  static constexpr int width = 16;
+  typedef __m512 vec;
+  static vec load(const float* p) { return _mm512_loadu_ps(p); }
+  static void store(float* p, vec v) { _mm512_storeu_ps(p, v); }
+  static vec set1(float x) { return _mm512_set1_ps(x); }
+  static vec sub(vec a, vec b) { return _mm512_sub_ps(a, b); }
+  static vec mul(vec a, vec b) { return _mm512_mul_ps(a, b); }
+  static vec mul_add(vec a, vec b, vec c) { return _mm512_fmadd_ps(a, b, c); }
+  static float sum(vec v) { return _mm512_reduce_add_ps(v); }
+};
+
+#elif defined(__AVX2__)
+
+template <>
+struct distance_vec<double> {
+  static constexpr bool enabled = true;
+  static constexpr int width = 4;
+  typedef __m256d vec;
+  static vec load(const double* p) { return _mm256_loadu_pd(p); }
+  static void store(double* p, vec v) { _mm256_storeu_pd(p, v); }
+  static vec set1(double x) { return _mm256_set1_pd(x); }
+  static vec sub(vec a, vec b) { return _mm256_sub_pd(a, b); }
+  static vec mul(vec a, vec b) { return _mm256_mul_pd(a, b); }
+#if defined(__FMA__)
+  static vec mul_add(vec a, vec b, vec c) { return _mm256_fmadd_pd(a, b, c); }
+#else
+  static vec mul_add(vec a, vec b, vec c) { return _mm256_add_pd(_mm256_mul_pd(a, b), c); }
+#endif
+  static double sum(vec v) {
+    __m128d h = _mm_add_pd(_mm256_castpd256_pd128(v), _mm256_extractf128_pd(v, 1));
+    return _mm_cvtsd_f64(_mm_add_sd(h, _mm_unpackhi_pd(h, h)));
+  }
+};
+
+template <>
+struct distance_vec<float> {
+  static constexpr bool enabled = true;
+  static constexpr int width = 8;
+  typedef __m256 vec;
+  static vec load(const float* p) { return _mm256_loadu_ps(p); }
+  static void store(float* p, vec v) { _mm256_storeu_ps(p, v); }
+  static vec set1(float x) { return _mm256_set1_ps(x); }
+  static vec sub(vec a, vec b) { return _mm256_sub_ps(a, b); }
+  static vec mul(vec a, vec b) { return _mm256_mul_ps(a, b); }
+#if defined(__FMA__)
+  static vec mul_add(vec a, vec b, vec c) { return _mm256_fmadd_ps(a, b, c); }
+#else
+  static vec mul_add(vec a, vec b, vec c) { return _mm256_add_ps(_mm256_mul_ps(a, b), c); }
+#endif
+  static float sum(vec v) {
+    __m128 h = _mm_add_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+    h = _mm_add_ps(h, _mm_movehl_ps(h, h));
+    return _mm_cvtss_f32(_mm_add_ss(h, _mm_movehdup_ps(h)));
+  }
+};
+
+#endif
+
+// out[i - lo] is the squared distance from q to the point i of the
+// coordinate arrays x, y and, in 3d, z, for i in [lo, hi)
+template <class floatT, int dim, bool vectorized = distance_vec<floatT>::enabled>
+struct squared_distances {
+  static void run(const floatT* x, const floatT* y, const floatT* z, long lo, long hi,
+                  const floatT* q, floatT* out) {
+    for (long i = lo; i < hi; i++) {
+      floatT dx = x[i] - q[0];
+      floatT dy = y[i] - q[1];
+      floatT r = dx * dx + dy * dy;
+      if (dim == 3) {
+        floatT dz = z[i] - q[2];
+        r += dz * dz;
+      }
+      out[i - lo] = r;
+    }
+  }
+};
+
+template <class floatT, int dim>
+struct squared_distances<floatT, dim, true> {
+  static void run(const floatT* x, const floatT* y, const floatT* z, long lo, long hi,
+                  const floatT* q, floatT* out) {
+    typedef distance_vec<floatT> V;
+    typename V::vec qx = V::set1(q[0]);
+    typename V::vec qy = V::set1(q[1]);
+    typename V::vec qz = V::set1(q[2]);
+    long i = lo;
+    for (; i + V::width <= hi; i += V::width) {
+      typename V::vec dx = V::sub(V::load(x + i), qx);
+      typename V::vec dy = V::sub(V::load(y + i), qy);
+      typename V::vec r = V::mul_add(dy, dy, V::mul(dx, dx));
+      if (dim == 3) {
+        typename V::vec dz = V::sub(V::load(z + i), qz);
+        r = V::mul_add(dz, dz, r);
+      }
+      V::store(out + i - lo, r);
+    }
+    squared_distances<floatT, dim, false>::run(x, y, z, i, hi, q, out + i - lo);
+  }
+};
+
+// The squared distance between the vectors a and b of dimension d
+template <class floatT, bool vectorized = distance_vec<floatT>::enabled>
+struct squared_l2 {
+  static floatT run(const floatT* a, const floatT* b, int d) {
+    floatT r = 0;
+    for (int i = 0; i < d; i++) {
+      floatT e = a[i] - b[i];
+      r += e * e;
+    }
+    return r;
+  }
+};
+
+template <class floatT>
+struct squared_l2<floatT, true> {
+  static floatT run(const floatT* a, const floatT* b, int d) {
+    typedef distance_vec<floatT> V;
+    typename V::vec acc = V::set1(0);
+    int i = 0;
+    for (; i + V::width <= d; i += V::width) {
+      typename V::vec e = V::sub(V::load(a + i), V::load(b + i));
+      acc = V::mul_add(e, e, acc);
+    }
+    return V::sum(acc) + squared_l2<floatT, false>::run(a + i, b + i, d - i);
+  }
+};
+
+// Inserts the candidate p at squared distance r in the k best, rn and pn,
+// sorted by decreasing distance, given that r < rn[0]: the entries farther
+// than r move down by one, and r takes the place of the last of them
+template <class floatT, class Index>
+inline void knn_insert(floatT* rn, Index* pn, int k, floatT r, Index p) {
+  for (int i = 0; i + 1 < k; i++) {
+    bool shift = rn[i + 1] > r;
+    bool here = rn[i] > r;
+    rn[i] = shift ? rn[i + 1] : (here ? r : rn[i]);
+    pn[i] = shift ? pn[i + 1] : (here ? p : pn[i]);
+  }
+  bool last = rn[k - 1] > r;
+  rn[k - 1] = last ? r : rn[k - 1];
+  pn[k - 1] = last ? p : pn[k - 1];
+}
+
+} // end namespace
+} // end namespace
+
+#endif /*! _PBBS_PCTL_DISTANCEKERNEL_H_ */
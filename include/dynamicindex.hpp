@@ -0,0 +1,265 @@
+/* COPYRIGHT (c) 2015 Umut Acar, Arthur Chargueraud, and Michael
+ * Rainey
+ * All rights reserved.
+ *
+ * \file dynamicindex.hpp
+ * \brief Dynamic point index with batch insertions and deletions
+ *
+ */
+
+#include <limits>
+#include <vector>
+#include <algorithm>
+#include "datapar.hpp"
+#include "geometry.hpp"
+#include "utils.hpp"
+#include "pointkdtree.hpp"
+
+#ifndef _PCTL_DYNAMICINDEX_H_
+#define _PCTL_DYNAMICINDEX_H_
+
+namespace pasl {
+namespace pctl {
+
+// A log-structured forest of static k-d trees: level l holds at most
+// DYNAMIC_INDEX_BASE << l points. A batch is inserted by merging it with
+// the levels 0 to l into level l, for the first l where they fit, and by
+// building the k-d tree of level l again, in parallel, so that a point is
+// moved to a larger level O(log n) times and the lower levels, rebuilt
+// often, stay small.
+//
+// The points carry ids, given at insertion and returned by the queries,
+// which must be distinct among the points of the index. A deleted point is
+// marked dead in its level and skipped by the queries, and a level is
+// built again on its live points once half of them are dead.
+//
+// A query searches the levels from the largest one down, carrying the k
+// best points found so far to prune the searches of the following levels.
+
+// Capacity of level 0
+#define DYNAMIC_INDEX_BASE 256
+
+template <class Point>
+class dynamic_point_index {
+public:
+
+  using point = Point;
+  using floatT = typename Point::floatT;
+  static const int dim = Point::dim;
+
+  struct level {
+    point_kdtree<Point> tree;
+    // in the order of the input of tree
+    parray<Point> points;
+    parray<int> ids;
+    parray<bool> dead;
+    long live;
+
+    level()
+    : live(0) { }
+  };
+
+  dynamic_point_index() { }
+
+  // number of live points
+  long size() const {
+    long n = 0;
+    for (const level& lv : levels) {
+      n += lv.live;
+    }
+    return n;
+  }
+
+  int nb_levels() const {
+    return (int) levels.size();
+  }
+
+  // Inserts the m points p with ids id
+  void insert(Point* p, const int* id, long m) {
+    if (m == 0) {
+      return;
+    }
+    int max_id = level1::reduce(id, id + m, 0, [&] (int a, int b) {
+      return std::max(a, b);
+    }, [&] (int i) {
+      return i;
+    });
+    reserve_ids(max_id + 1);
+    int l = 0;
+    long total = m;
+    while (true) {
+      if (l == nb_levels()) {
+        levels.push_back(level());
+      }
+      total += levels[l].live;
+      if (total <= capacity(l)) {
+        break;
+      }
+      l++;
+    }
+    parray<Point> points(total);
+    parray<int> ids(total);
+    parallel_for(0L, m, [&] (long i) {
+      points[i] = p[i];
+      ids[i] = id[i];
+    });
+    long k = m;
+    for (int j = 0; j <= l; j++) {
+      k += live_points(levels[j], points.begin() + k, ids.begin() + k);
+      if (j < l) {
+        levels[j] = level();
+      }
+    }
+    build(l, points, ids);
+  }
+
+  // Deletes the m points with ids id; the ids not in the index are ignored
+  void erase(const int* id, long m) {
+    parray<int> removed(m, [&] (long i) {
+      int x = id[i];
+      if (x < 0 || x >= (int) level_of.size()) {
+        return -1;
+      }
+      int l = level_of[x];
+      // the first of several deletions of x wins
+      if (l < 0 || !utils::CAS(&level_of[x], l, -1)) {
+        return -1;
+      }
+      levels[l].dead[slot_of[x]] = true;
+      return l;
+    });
+    for (int l = 0; l < nb_levels(); l++) {
+      long r = level1::reduce(removed.cbegin(), removed.cend(), 0L, [&] (long a, long b) {
+        return a + b;
+      }, [&] (int j) {
+        return (long) (j == l);
+      });
+      level& lv = levels[l];
+      lv.live -= r;
+      if (r > 0 && lv.live < (long) lv.points.size() / 2) {
+        parray<Point> points(lv.live);
+        parray<int> ids(lv.live);
+        live_points(lv, points.begin(), ids.begin());
+        build(l, points, ids);
+      }
+    }
+  }
+
+  // The id of the point nearest to p, or -1 if the index is empty
+  int nearest(Point p) const {
+    int result;
+    nearest<1>(p, 1, &result);
+    return result;
+  }
+
+  // The ids of the k points nearest to p, nearest first, written to out,
+  // with -1 after the last one if there are fewer than k points
+  template <int maxK>
+  void nearest(Point p, int k, int* out) const {
+    if (k > maxK) {
+      std::cout << "k too large in kNN" << std::endl;
+      abort();
+    }
+    floatT c[3];
+    point_kdtree<Point>::coordinates(p, c);
+    floatT rn[maxK];
+    long pn[maxK];
+    for (int j = 0; j < k; j++) {
+      rn[j] = std::numeric_limits<floatT>::max();
+      pn[j] = -1;
+    }
+    for (int l = nb_levels() - 1; l >= 0; l--) {
+      const level& lv = levels[l];
+      if (lv.live == 0) {
+        continue;
+      }
+      const int* input = lv.tree.ids.cbegin();
+      const bool* dead = lv.dead.cbegin();
+      const int* ids = lv.ids.cbegin();
+      lv.tree.search(c, k, rn, pn, [&] (long i) {
+        return dead[input[i]];
+      }, [&] (long i) {
+        return (long) ids[input[i]];
+      });
+    }
+    for (int j = 0; j < k; j++) {
+      out[j] = (int) pn[k - j - 1];
+    }
+  }
+
+  // The k nearest points of each of the m queries, in the format of
+  // point_kdtree::knn
+  template <int maxK>
+  parray<int> knn(Point* q, long m, int k) const {
+    parray<int> result(m * k);
+    parallel_for(0L, m, [&] (long i) {
+      nearest<maxK>(q[i], k, result.begin() + i * k);
+    });
+    return result;
+  }
+
+private:
+
+  std::vector<level> levels;
+  // level and index in the level of the point of every id, -1 if none
+  parray<int> level_of;
+  parray<int> slot_of;
+
+  static long capacity(int l) {
+    return (long) DYNAMIC_INDEX_BASE << l;
+  }
+
+  void reserve_ids(long n) {
+    long old = level_of.size();
+    if (n <= old) {
+      return;
+    }
+    n = std::max(n, 2 * old);
+    parray<int> l(n, [&] (long i) {
+      return (i < old) ? level_of[i] : -1;
+    });
+    parray<int> s(n, [&] (long i) {
+      return (i < old) ? slot_of[i] : -1;
+    });
+    level_of = l;
+    slot_of = s;
+  }
+
+  // Copies the live points of lv and their ids to points and ids, and
+  // returns their number
+  static long live_points(const level& lv, Point* points, int* ids) {
+    long n = lv.points.size();
+    if (lv.live == n) {
+      parallel_for(0L, n, [&] (long i) {
+        points[i] = lv.points[i];
+        ids[i] = lv.ids[i];
+      });
+      return n;
+    }
+    parray<bool> alive(n, [&] (long i) {
+      return !lv.dead[i];
+    });
+    dps::pack(alive.cbegin(), lv.points.cbegin(), lv.points.cend(), points);
+    return dps::pack(alive.cbegin(), lv.ids.cbegin(), lv.ids.cend(), ids);
+  }
+
+  void build(int l, parray<Point>& points, parray<int>& ids) {
+    level& lv = levels[l];
+    long n = points.size();
+    lv.points = points;
+    lv.ids = ids;
+    lv.dead = parray<bool>(n, false);
+    lv.live = n;
+    lv.tree = point_kdtree<Point>(lv.points);
+    parallel_for(0L, n, [&] (long i) {
+      level_of[lv.ids[i]] = l;
+      slot_of[lv.ids[i]] = (int) i;
+    });
+  }
+
+};
+
+} // end namespace
+} // end namespace
+
+#endif /*! _PCTL_DYNAMICINDEX_H_ */
@@ -0,0 +1,352 @@
+/* COPYRIGHT (c) 2015 Umut Acar, Arthur Chargueraud, and Michael
+ * Rainey
+ * All rights reserved.
+ *
+ * \file externalsort.hpp
+ * \brief External-memory sort for inputs larger than the memory
+ *
+ */
+
+#include <string>
+#include <future>
+#include <iostream>
+#include <algorithm>
+#include <stdio.h>
+#include <stdlib.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include "datapar.hpp"
+#include "samplesort.hpp"
+#include "presort.hpp"
+
+#ifndef _PBBS_PCTL_EXTERNALSORT_H_
+#define _PBBS_PCTL_EXTERNALSORT_H_
+
+namespace pasl {
+namespace pctl {
+
+// external_sort sorts a file of fixed-size items using at most about
+// memory_bytes of memory for its buffers. Files have the layout written by
+// io::write_to_file for a parray (see serializationbin.hpp): a long giving
+// the number of items, followed by the items.
+//
+// The sort makes two kinds of passes:
+//  - run formation: the input is read in runs that fill a third of the
+//    memory, each run is sorted in memory by sample_sort and written back.
+//    The read of the next run and the write of the previous one proceed
+//    in the background while the current run is sorted.
+//  - multiway merge: up to max_fan_in runs are merged at once. Each run
+//    has a current block and a block being prefetched. At every step, all
+//    the buffered items not greater than the smallest last item of the
+//    current blocks are safe to output; they are gathered, merged in
+//    parallel by merge_sorted_runs, and written in the background while the
+//    next step proceeds. When there are more runs than the memory can
+//    merge with blocks of at least EXTSORT_MIN_BLOCK items, groups of runs
+//    are merged into longer runs first.
+
+// Smallest merge block, in items
+#define EXTSORT_MIN_BLOCK (1 << 16)
+// Largest run, in items: runs are sorted by sample_sort, which takes an int
+#define EXTSORT_MAX_RUN (1 << 30)
+
+struct external_sort_stats {
+  long n;
+  long run_size;
+  long nb_runs;
+  int nb_merge_passes;
+};
+
+/*---------------------------------------------------------------------*/
+/* Files */
+
+// Reads and writes at explicit positions, so that several I/O threads can
+// work on the same file at once
+class extsort_file {
+public:
+
+  std::string name;
+  int fd;
+
+  extsort_file(const std::string& name, bool create)
+  : name(name) {
+    fd = create ? open(name.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644) : open(name.c_str(), O_RDONLY);
+    if (fd < 0) {
+      std::cerr << "external_sort: unable to open " << name << std::endl;
+      exit(1);
+    }
+  }
+
+  ~extsort_file() {
+    close(fd);
+  }
+
+  void read(void* dst, long bytes, long offset) {
+    char* p = (char*) dst;
+    while (bytes > 0) {
+      ssize_t r = pread(fd, p, bytes, offset);
+      if (r <= 0) {
+        std::cerr << "external_sort: read failed on " << name << std::endl;
+        exit(1);
+      }
+      p += r;
+      bytes -= r;
+      offset += r;
+    }
+  }
+
+  void write(const void* src, long bytes, long offset) {
+    const char* p = (const char*) src;
+    while (bytes > 0) {
+      ssize_t r = pwrite(fd, p, bytes, offset);
+      if (r <= 0) {
+        std::cerr << "external_sort: write failed on " << name << std::endl;
+        exit(1);
+      }
+      p += r;
+      bytes -= r;
+      offset += r;
+    }
+  }
+
+  long read_size() {
+    long n;
+    read(&n, sizeof(long), 0);
+    return n;
+  }
+
+  void write_size(long n) {
+    write(&n, sizeof(long), 0);
+  }
+
+  // Item i of the file; the items follow the size
+  template <class E>
+  static long offset_of(long i) {
+    return (long) sizeof(long) + i * (long) sizeof(E);
+  }
+
+  template <class E>
+  std::future<void> async_read(E* dst, long i, long nb) {
+    return std::async(std::launch::async, [this, dst, i, nb] {
+      read(dst, nb * sizeof(E), offset_of<E>(i));
+    });
+  }
+
+  template <class E>
+  std::future<void> async_write(const E* src, long i, long nb) {
+    return std::async(std::launch::async, [this, src, i, nb] {
+      write(src, nb * sizeof(E), offset_of<E>(i));
+    });
+  }
+
+};
+
+/*---------------------------------------------------------------------*/
+/* Run formation */
+
+// Sorts the consecutive runs of run_size items of src into dst
+template <class E, class BinPred>
+void extsort_form_runs(extsort_file& src, extsort_file& dst, long n, long run_size, BinPred compare) {
+  long nb_runs = (n + run_size - 1) / run_size;
+  parray<E> cur;
+  parray<E> next;
+  cur.prefix_tabulate(std::min(n, run_size), 0);
+  next.prefix_tabulate(std::min(n, run_size), 0);
+  std::future<void> reading = src.async_read(cur.begin(), 0, std::min(n, run_size));
+  std::future<void> writing;
+  for (long r = 0; r < nb_runs; r++) {
+    long lo = r * run_size;
+    long len = std::min(run_size, n - lo);
+    reading.get();
+    if (writing.valid()) {
+      // next holds the previous run until its write completes
+      writing.get();
+    }
+    if (r + 1 < nb_runs) {
+      reading = src.async_read(next.begin(), lo + len, std::min(run_size, n - lo - len));
+    }
+    sample_sort(cur.begin(), (int) len, compare);
+    writing = dst.async_write(cur.cbegin(), lo, len);
+    cur.swap(next);
+  }
+  if (writing.valid()) {
+    writing.get();
+  }
+}
+
+/*---------------------------------------------------------------------*/
+/* Multiway merge */
+
+// Merges the runs src[starts[j], starts[j + 1]), for j < k, into
+// dst[out, out + starts[k] - starts[0]), with blocks of block items
+template <class E, class BinPred>
+void extsort_merge(extsort_file& src, const long* starts, long k, extsort_file& dst, long out, long block, BinPred compare) {
+  // input: a current and a prefetched block per run
+  parray<E> in_buffers;
+  in_buffers.prefix_tabulate(2 * k * block, 0);
+  parray<E*> cur(k, [&] (long j) {
+    return in_buffers.begin() + 2 * j * block;
+  });
+  parray<E*> next(k, [&] (long j) {
+    return in_buffers.begin() + (2 * j + 1) * block;
+  });
+  parray<long> head(k, 0L);
+  parray<long> size(k, 0L);
+  parray<long> next_size(k, 0L);
+  parray<long> pos(k, [&] (long j) {
+    return starts[j];
+  });
+  std::vector<std::future<void>> prefetching(k);
+  auto prefetch = [&] (long j) {
+    next_size[j] = std::min(block, starts[j + 1] - pos[j]);
+    if (next_size[j] > 0) {
+      prefetching[j] = src.async_read(next[j], pos[j], next_size[j]);
+      pos[j] += next_size[j];
+    }
+  };
+  auto advance = [&] (long j) {
+    prefetching[j].get();
+    std::swap(cur[j], next[j]);
+    head[j] = 0;
+    size[j] = next_size[j];
+    prefetch(j);
+  };
+  for (long j = 0; j < k; j++) {
+    prefetch(j);
+    if (next_size[j] > 0) {
+      advance(j);
+    }
+  }
+
+  // output: two sets of gather and merge buffers, one being written while
+  // the other is filled
+  long out_capacity = k * block;
+  parray<E> out_buffers;
+  out_buffers.prefix_tabulate(4 * out_capacity, 0);
+  std::future<void> writing[2];
+  parray<long> counts(k + 1, 0L);
+  for (int step = 0; ; step = 1 - step) {
+    for (long j = 0; j < k; j++) {
+      if (head[j] == size[j] && next_size[j] > 0) {
+        advance(j);
+      }
+    }
+    // the items not greater than bound are safe to output, as every item
+    // still on disk follows the last item of the current block of its run
+    const E* bound = nullptr;
+    bool active = false;
+    for (long j = 0; j < k; j++) {
+      if (head[j] == size[j]) {
+        continue;
+      }
+      active = true;
+      const E* last = cur[j] + size[j] - 1;
+      if (next_size[j] > 0 && (bound == nullptr || compare(*last, *bound))) {
+        bound = last;
+      }
+    }
+    if (! active) {
+      break;
+    }
+    parallel_for(0L, k, [&] (long j) {
+      E* lo = cur[j] + head[j];
+      E* hi = cur[j] + size[j];
+      counts[j] = ((bound == nullptr) ? hi : std::upper_bound(lo, hi, *bound, compare)) - lo;
+    });
+    counts[k] = 0;
+    long total = dps::scan(counts.cbegin(), counts.cend(), 0L, [&] (long x, long y) {
+      return x + y;
+    }, counts.begin(), forward_exclusive_scan);
+    parray<long> run_starts(k + 1, [&] (long j) {
+      return counts[j];
+    });
+    if (writing[step].valid()) {
+      writing[step].get();
+    }
+    E* gather = out_buffers.begin() + 2 * step * out_capacity;
+    E* tmp = gather + out_capacity;
+    auto complexity_fct = [&] (long lo, long hi) {
+      return counts[hi] - counts[lo];
+    };
+    range::parallel_for(0L, k, complexity_fct, [&] (long j) {
+      long len = counts[j + 1] - counts[j];
+      pmem::copy(cur[j] + head[j], cur[j] + head[j] + len, gather + counts[j]);
+      head[j] += len;
+    });
+    E* result = merge_sorted_runs(gather, tmp, run_starts, compare);
+    writing[step] = dst.async_write((const E*) result, out, total);
+    out += total;
+  }
+  for (int s = 0; s < 2; s++) {
+    if (writing[s].valid()) {
+      writing[s].get();
+    }
+  }
+}
+
+/*---------------------------------------------------------------------*/
+/* External sort */
+
+// Sorts the items of infile into outfile with buffers of about
+// memory_bytes in total. Temporary runs are kept next to outfile.
+template <class E, class BinPred>
+external_sort_stats external_sort(const std::string& infile, const std::string& outfile, long memory_bytes, BinPred compare) {
+  external_sort_stats stats;
+  extsort_file in(infile, false);
+  long n = in.read_size();
+  // run formation holds two runs, plus the scratch space of sample_sort
+  long run_size = std::max(1L, std::min((long) EXTSORT_MAX_RUN, memory_bytes / (3 * (long) sizeof(E))));
+  // a k-way merge holds 2k input blocks and 4k output blocks
+  long max_fan_in = std::max(2L, memory_bytes / (6 * (long) sizeof(E) * EXTSORT_MIN_BLOCK));
+  long nb_runs = std::max(1L, (n + run_size - 1) / run_size);
+  stats.n = n;
+  stats.run_size = run_size;
+  stats.nb_runs = nb_runs;
+  stats.nb_merge_passes = 0;
+
+  std::string tmp_names[2] = { outfile + ".runs0", outfile + ".runs1" };
+  int tmp = 0;
+  {
+    extsort_file runs((nb_runs == 1) ? outfile : tmp_names[tmp], true);
+    runs.write_size(n);
+    if (n > 0) {
+      extsort_form_runs<E>(in, runs, n, run_size, compare);
+    }
+  }
+  parray<long> starts(nb_runs + 1, [&] (long j) {
+    return std::min(n, j * run_size);
+  });
+  while (nb_runs > 1) {
+    long nb_groups = (nb_runs + max_fan_in - 1) / max_fan_in;
+    bool last = nb_groups == 1;
+    {
+      extsort_file src(tmp_names[tmp], false);
+      extsort_file dst(last ? outfile : tmp_names[1 - tmp], true);
+      dst.write_size(n);
+      for (long g = 0; g < nb_groups; g++) {
+        long lo = g * max_fan_in;
+        long k = std::min(max_fan_in, nb_runs - lo);
+        long block = std::max(1L, memory_bytes / (6 * (long) sizeof(E) * k));
+        extsort_merge<E>(src, starts.cbegin() + lo, k, dst, starts[lo], block, compare);
+      }
+    }
+    unlink(tmp_names[tmp].c_str());
+    parray<long> next_starts(nb_groups + 1, [&] (long g) {
+      return starts[std::min(nb_runs, g * max_fan_in)];
+    });
+    starts.swap(next_starts);
+    nb_runs = nb_groups;
+    tmp = 1 - tmp;
+    stats.nb_merge_passes++;
+  }
+  return stats;
+}
+
+template <class E>
+external_sort_stats external_sort(const std::string& infile, const std::string& outfile, long memory_bytes) {
+  return external_sort<E>(infile, outfile, memory_bytes, std::less<E>());
+}
+
+} // end namespace
+} // end namespace
+
+#endif /*! _PBBS_PCTL_EXTERNALSORT_H_ */
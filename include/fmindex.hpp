@@ -0,0 +1,282 @@
+/* COPYRIGHT (c) 2015 Umut Acar, Arthur Chargueraud, and Michael
+ * Rainey
+ * All rights reserved.
+ *
+ * \file fmindex.hpp
+ * \brief Burrows-Wheeler transform and FM-index
+ *
+ */
+
+#include <string>
+#include <stdint.h>
+#include "datapar.hpp"
+#include "suffixarray.hpp"
+#include "bitvector.hpp"
+#include "utils.hpp"
+
+#ifndef _PBBS_PCTL_FMINDEX_H_
+#define _PBBS_PCTL_FMINDEX_H_
+
+namespace pasl {
+namespace pctl {
+
+/*---------------------------------------------------------------------*/
+/* Burrows-Wheeler transform */
+
+// The BWT of s[0, n) followed by a sentinel smaller than every character:
+// n + 1 characters, the one preceding each suffix in suffix array order.
+// The sentinel has no character of its own: its position is returned in
+// primary and a 0 is stored there.
+template <class CharT, class Index>
+parray<unsigned char> burrows_wheeler(const CharT* s, const Index* SA, long n, long& primary) {
+  using idx = typename index_arithmetic<Index>::type;
+  parray<unsigned char> bwt(n + 1, [&] (long i) {
+    if (i == 0) {
+      return (unsigned char) ((n == 0) ? 0 : s[n - 1]);
+    }
+    idx j = SA[i - 1];
+    return (unsigned char) ((j == 0) ? 0 : s[j - 1]);
+  });
+  primary = 0;
+  parallel_for(0L, n, [&] (long i) {
+    if ((idx) SA[i] == 0) {
+      primary = i + 1;
+    }
+  });
+  return bwt;
+}
+
+/*---------------------------------------------------------------------*/
+/* Wavelet matrix */
+
+// A sequence of symbols in [0, 2^nb_levels) with rank and select in
+// O(nb_levels) bit vector operations, as
+//   Francisco Claude, Gonzalo Navarro and Alberto Ordonez
+//   The wavelet matrix: An efficient wavelet tree for large alphabets
+//   Information Systems 47, 2015
+// Level l holds bit nb_levels - 1 - l of every symbol, the symbols being
+// stably partitioned by their bits of the previous levels, zeros first.
+class wavelet_matrix {
+private:
+
+  long n;
+  int nb_levels;
+  parray<rank_bitvector> levels;
+  parray<long> zeros;
+
+public:
+
+  wavelet_matrix()
+  : n(0), nb_levels(0) { }
+
+  wavelet_matrix(const parray<unsigned char>& symbols, int nb_levels)
+  : n(symbols.size()), nb_levels(nb_levels) {
+    levels = parray<rank_bitvector>(nb_levels);
+    zeros = parray<long>(nb_levels, 0L);
+    parray<unsigned char> cur = symbols;
+    for (int l = 0; l < nb_levels; l++) {
+      int shift = nb_levels - 1 - l;
+      levels[l] = rank_bitvector(n, [&] (long i) {
+        return (cur[i] >> shift) & 1;
+      });
+      zeros[l] = levels[l].rank0(n);
+      if (l + 1 < nb_levels) {
+        parray<unsigned char> z = filter(cur.cbegin(), cur.cend(), [&] (unsigned char c) {
+          return ((c >> shift) & 1) == 0;
+        });
+        parray<unsigned char> o = filter(cur.cbegin(), cur.cend(), [&] (unsigned char c) {
+          return ((c >> shift) & 1) == 1;
+        });
+        pmem::copy(z.cbegin(), z.cend(), cur.begin());
+        pmem::copy(o.cbegin(), o.cend(), cur.begin() + z.size());
+      }
+    }
+  }
+
+  long size() const {
+    return n;
+  }
+
+  // Number of occurrences of c in [0, i)
+  long rank(unsigned char c, long i) const {
+    long lo = 0;
+    for (int l = 0; l < nb_levels; l++) {
+      if ((c >> (nb_levels - 1 - l)) & 1) {
+        lo = zeros[l] + levels[l].rank1(lo);
+        i = zeros[l] + levels[l].rank1(i);
+      } else {
+        lo = levels[l].rank0(lo);
+        i = levels[l].rank0(i);
+      }
+    }
+    return i - lo;
+  }
+
+  unsigned char access(long i) const {
+    unsigned char c = 0;
+    for (int l = 0; l < nb_levels; l++) {
+      bool b = levels[l][i];
+      c = (unsigned char) ((c << 1) | (b ? 1 : 0));
+      i = b ? zeros[l] + levels[l].rank1(i) : levels[l].rank0(i);
+    }
+    return c;
+  }
+
+  // Position of the occurrence of c of rank j, for j in [0, rank(c, n)):
+  // the occurrence is at lo + j on the last level, from where it is
+  // followed back up by select on every level
+  long select(unsigned char c, long j) const {
+    long lo = 0;
+    for (int l = 0; l < nb_levels; l++) {
+      if ((c >> (nb_levels - 1 - l)) & 1) {
+        lo = zeros[l] + levels[l].rank1(lo);
+      } else {
+        lo = levels[l].rank0(lo);
+      }
+    }
+    long i = lo + j;
+    for (int l = nb_levels - 1; l >= 0; l--) {
+      if ((c >> (nb_levels - 1 - l)) & 1) {
+        i = levels[l].select1(i - zeros[l]);
+      } else {
+        i = levels[l].select0(i);
+      }
+    }
+    return i;
+  }
+
+  long size_in_bytes() const {
+    long bytes = sizeof(long) * zeros.size();
+    for (int l = 0; l < nb_levels; l++) {
+      bytes += levels[l].size_in_bytes();
+    }
+    return bytes;
+  }
+
+};
+
+/*---------------------------------------------------------------------*/
+/* FM-index */
+
+// Counts the occurrences of a pattern by backward search over the BWT
+//   Paolo Ferragina and Giovanni Manzini
+//   Opportunistic data structures with applications
+//   Proc. FOCS 2000
+// The characters of the text are renamed 1..sigma, 0 being the sentinel,
+// and the BWT is kept in a wavelet matrix of log(sigma + 1) levels, so
+// that the index takes about 1.14 * log(sigma + 1) bits per character.
+class fm_index {
+private:
+
+  long n;
+  parray<int> code;
+  parray<long> C;
+  wavelet_matrix bwt;
+
+  // Renames the characters of s and counts them: C[c] is the number of
+  // characters of s and sentinel smaller than c
+  template <class CharT>
+  int build_alphabet(const CharT* s) {
+    long nb_blocks = (n + (1 << 16) - 1) / (1 << 16);
+    parray<long> counts(nb_blocks * 256, 0L);
+    parallel_for(0L, nb_blocks, [&] (long b) {
+      long* cnt = counts.begin() + b * 256;
+      for (long i = b << 16; i < std::min(n, (b + 1) << 16); i++) {
+        cnt[(unsigned char) s[i]]++;
+      }
+    });
+    parray<long> total(256, [&] (long c) {
+      long t = 0;
+      for (long b = 0; b < nb_blocks; b++) {
+        t += counts[b * 256 + c];
+      }
+      return t;
+    });
+    code = parray<int>(256, 0);
+    int sigma = 0;
+    for (int c = 0; c < 256; c++) {
+      if (total[c] > 0) {
+        code[c] = ++sigma;
+      }
+    }
+    C = parray<long>(sigma + 2, 0L);
+    C[1] = 1;
+    for (int c = 0; c < 256; c++) {
+      if (total[c] > 0) {
+        C[code[c] + 1] = C[code[c]] + total[c];
+      }
+    }
+    return sigma;
+  }
+
+  template <class CharT, class Index>
+  void build(const CharT* s, const Index* SA) {
+    int sigma = build_alphabet(s);
+    long primary;
+    parray<unsigned char> b = burrows_wheeler(s, SA, n, primary);
+    parallel_for(0L, n + 1, [&] (long i) {
+      b[i] = (i == primary) ? 0 : (unsigned char) code[b[i]];
+    });
+    bwt = wavelet_matrix(b, std::max(1, utils::log2Up(sigma + 1)));
+  }
+
+public:
+
+  fm_index()
+  : n(0) { }
+
+  // From a suffix array of s[0, n), the characters being compared as
+  // unsigned
+  template <class CharT, class Index>
+  fm_index(const CharT* s, const parray<Index>& SA)
+  : n(SA.size()) {
+    build(s, SA.cbegin());
+  }
+
+  template <class CharT>
+  fm_index(const CharT* s, long n)
+  : n(n) {
+    // ordered as unsigned characters, as is the BWT
+    parray<intT> SA = suffix_array((unsigned char*) s, (intT) n);
+    build(s, SA.cbegin());
+  }
+
+  long size() const {
+    return n;
+  }
+
+  long count(const char* p, long m) const {
+    long sp = 0;
+    long ep = n + 1;
+    for (long j = m - 1; j >= 0 && sp < ep; j--) {
+      int c = code[(unsigned char) p[j]];
+      if (c == 0) {
+        return 0;
+      }
+      sp = C[c] + bwt.rank((unsigned char) c, sp);
+      ep = C[c] + bwt.rank((unsigned char) c, ep);
+    }
+    // the suffix made of the sentinel alone matches the empty pattern
+    return (m == 0) ? n : ep - sp;
+  }
+
+  long count(const std::string& p) const {
+    return count(p.c_str(), p.length());
+  }
+
+  parray<long> count(const parray<std::string>& patterns) const {
+    return parray<long>(patterns.size(), [&] (long i) {
+      return count(patterns[i]);
+    });
+  }
+
+  long size_in_bytes() const {
+    return bwt.size_in_bytes() + sizeof(int) * code.size() + sizeof(long) * C.size();
+  }
+
+};
+
+} // end namespace
+} // end namespace
+
+#endif /*! _PBBS_PCTL_FMINDEX_H_ */
@@ -121,6 +121,20 @@ parray<point3d> uniform3d(bool inSphere, bool onSphere, intT n) {
   });
 }
 
+// n vectors of dimension d, one after the other, each one drawn around
+// one of the random centers, in [-1, 1]^d, of the given number of clusters
+template <class floatT>
+parray<floatT> clustered_vectors(long n, int d, int clusters) {
+  return parray<floatT>(n * d, [&] (long l) {
+    long i = l / d;
+    long j = l % d;
+    long c = prandgen::hashu((unsigned int) i) % clusters;
+    double center = 2 * prandgen::hash<double>(3 * (c * d + j)) - 1;
+    double noise = prandgen::hash<double>(3 * l + 1) + prandgen::hash<double>(3 * l + 2) - 1;
+    return (floatT) (center + 0.2 * noise);
+  });
+}
+
 } // end namespace
 } // end namespace
 
@@ -0,0 +1,277 @@
+/* COPYRIGHT (c) 2015 Umut Acar, Arthur Chargueraud, and Michael
+ * Rainey
+ * All rights reserved.
+ *
+ * \file halfedge.hpp
+ * \brief Compact index-based half-edge mesh of a planar triangulation
+ *
+ */
+
+#include "datapar.hpp"
+#include "geometry.hpp"
+#include "blockradixsort.hpp"
+
+#ifndef _PCTL_HALFEDGE_H_
+#define _PCTL_HALFEDGE_H_
+
+namespace pasl {
+namespace pctl {
+
+// Size of the buckets of half-edges under which the constructor of
+// halfedge_mesh pairs twins by comparing all pairs
+#define HALFEDGE_PAIRS_SIZE 16
+
+// A triangulation stored as arrays indexed by 32-bit ids, in place of the
+// tri and vertex structures of topology.hpp linked by pointers. Triangle
+// t owns the half-edges 3t, 3t + 1 and 3t + 2, in counterclockwise order,
+// so that the next and previous half-edges of a triangle are implicit:
+//
+//            origin[3t + 2]
+//                 o
+//   3t + 2 ->   /   \   <- 3t + 1
+//              o --- o
+//   origin[3t]  3t ->  origin[3t + 1]
+//
+// A half-edge goes from its origin to the origin of the next one, and its
+// twin, if any, is the half-edge of the neighbor going the other way. The
+// mesh is allocated with room for the vertices and triangles to come: a
+// triangle not yet used has origin -1.
+//
+// The updates (split, split_boundary and flip) are those of simplex in
+// topology.hpp, and touch the triangles they rewrite, the twins of their
+// edges and the out half-edges of their vertices, so that insertions with
+// disjoint cavities may run in parallel.
+class halfedge_mesh {
+public:
+
+  // the coordinates of every vertex
+  parray<point2d> points;
+  // the origin and the twin (-1 on the boundary) of every half-edge
+  parray<int> origin;
+  parray<int> twin;
+  // a half-edge out of every vertex, -1 if none
+  parray<int> out;
+  // the priority of the insertion that reserved every vertex, -1 if none
+  parray<int> reserve;
+
+  halfedge_mesh() { }
+
+  // Room for n vertices and m triangles, none of them set
+  halfedge_mesh(long n, long m)
+  : points(n), origin(3 * m, -1), twin(3 * m, -1), out(n, -1), reserve(n, -1) { }
+
+  // The mesh of T, with room for extra_vertices and extra_triangles more.
+  // The triangles given clockwise are turned around, and the neighbors are
+  // found by sorting the half-edges by their unordered pairs of vertices,
+  // in place of the hash table of edges of topologyFromTriangles.
+  halfedge_mesh(triangles<point2d> T, long extra_vertices = 0, long extra_triangles = 0)
+  : halfedge_mesh(T.num_points + extra_vertices, T.num_triangles + extra_triangles) {
+    long n = T.num_points;
+    long m = T.num_triangles;
+    parallel_for(0L, n, [&] (long i) {
+      points[i] = T.p[i];
+    });
+    parallel_for(0L, m, [&] (long t) {
+      int* u = T.t[t].vertices;
+      bool ccw = triangle_area(T.p[u[0]], T.p[u[1]], T.p[u[2]]) >= 0.0;
+      origin[3 * t] = u[0];
+      origin[3 * t + 1] = ccw ? u[1] : u[2];
+      origin[3 * t + 2] = ccw ? u[2] : u[1];
+    });
+    // the half-edges sorted by the lower of their two vertices: twins end
+    // up in the same bucket, where they are paired by comparing all pairs
+    // of half-edges in small buckets, and in larger ones, around hubs, by
+    // sorting the bucket by the higher vertex, so that twins are next to
+    // each other, in O(d log d) for a vertex of degree d
+    auto low = [&] (int h) {
+      return std::min(origin[h], origin[next(h)]);
+    };
+    auto high = [&] (int h) {
+      return std::max(origin[h], origin[next(h)]);
+    };
+    parray<int> sorted(3 * m, [&] (long h) {
+      return (int) h;
+    });
+    parray<int> offsets(n + 1);
+    if (m > 0) {
+      intsort::integer_sort(sorted.begin(), offsets.begin(), (int) (3 * m), (int) n, low);
+    }
+    offsets[n] = (int) (3 * m);
+    parallel_for(0L, n, [&] (long u) {
+      int* lo = sorted.begin() + offsets[u];
+      int* hi = sorted.begin() + offsets[u + 1];
+      if (hi - lo <= HALFEDGE_PAIRS_SIZE) {
+        for (int* i = lo; i < hi; i++) {
+          for (int* j = i + 1; j < hi; j++) {
+            if (high(*i) == high(*j)) {
+              link(*i, *j);
+            }
+          }
+        }
+        return;
+      }
+      std::sort(lo, hi, [&] (int h, int g) {
+        return high(h) < high(g);
+      });
+      for (int* i = lo; i + 1 < hi; i++) {
+        if (high(i[0]) == high(i[1])) {
+          link(i[0], i[1]);
+          i++;
+        }
+      }
+    });
+    parallel_for(0L, 3 * m, [&] (long h) {
+      utils::writeMax(&out[origin[h]], (int) h);
+    });
+  }
+
+  long nb_vertices() const {
+    return out.size();
+  }
+
+  long nb_triangles() const {
+    return origin.size() / 3;
+  }
+
+  static int face(int h) {
+    return h / 3;
+  }
+
+  static int next(int h) {
+    return (h % 3 == 2) ? h - 2 : h + 1;
+  }
+
+  static int prev(int h) {
+    return (h % 3 == 0) ? h + 2 : h - 1;
+  }
+
+  int target(int h) const {
+    return origin[next(h)];
+  }
+
+  // the vertex of the triangle of h not on h
+  int apex(int h) const {
+    return origin[prev(h)];
+  }
+
+  bool alive(int t) const {
+    return origin[3 * t] >= 0;
+  }
+
+  // true if p is strictly on the right of h, outside of its triangle
+  bool outside(int h, point2d p) const {
+    return counter_clockwise(points[origin[h]], p, points[target(h)]);
+  }
+
+  // true if p is in the circumcircle of the triangle of h
+  bool in_circle(int h, point2d p) const {
+    int t = 3 * face(h);
+    return inCircle(points[origin[t]], points[origin[t + 1]], points[origin[t + 2]], p);
+  }
+
+  // Sets the triangle t to a, b, c, counterclockwise, with no neighbors
+  void set_triangle(int t, int a, int b, int c) {
+    origin[3 * t] = a;
+    origin[3 * t + 1] = b;
+    origin[3 * t + 2] = c;
+    twin[3 * t] = twin[3 * t + 1] = twin[3 * t + 2] = -1;
+    out[a] = 3 * t;
+    out[b] = 3 * t + 1;
+    out[c] = 3 * t + 2;
+  }
+
+  // Makes h and g, if any, twins
+  void link(int h, int g) {
+    twin[h] = g;
+    if (g >= 0) {
+      twin[g] = h;
+    }
+  }
+
+  // Splits the triangle of h into three triangles around the vertex v,
+  // inside of it, using t1 and t2 for the two new ones
+  void split(int h, int v, int t1, int t2) {
+    int t = 3 * face(h);
+    int a = origin[t];
+    int b = origin[t + 1];
+    int c = origin[t + 2];
+    int tb = twin[t + 1];
+    int tc = twin[t + 2];
+    origin[t + 2] = v;
+    origin[3 * t1] = b; origin[3 * t1 + 1] = c; origin[3 * t1 + 2] = v;
+    origin[3 * t2] = c; origin[3 * t2 + 1] = a; origin[3 * t2 + 2] = v;
+    link(3 * t1, tb);
+    link(3 * t2, tc);
+    link(t + 1, 3 * t1 + 2);
+    link(t + 2, 3 * t2 + 1);
+    link(3 * t1 + 1, 3 * t2 + 2);
+    out[v] = t + 2;
+    out[c] = 3 * t2;
+  }
+
+  // Splits the boundary half-edge h and its triangle in two at the vertex
+  // v, on h, using t1 for the new triangle
+  void split_boundary(int h, int v, int t1) {
+    int n = next(h);
+    int p = prev(h);
+    int b = origin[n];
+    int c = origin[p];
+    int tn = twin[n];
+    origin[n] = v;
+    origin[3 * t1] = v; origin[3 * t1 + 1] = b; origin[3 * t1 + 2] = c;
+    link(3 * t1, -1);
+    link(3 * t1 + 1, tn);
+    link(3 * t1 + 2, n);
+    out[v] = n;
+    out[b] = 3 * t1 + 1;
+    out[c] = p;
+  }
+
+  // Replaces the edge of h, between two triangles a b c and b a d, by the
+  // other diagonal of their quadrilateral, c d
+  void flip(int h) {
+    int g = twin[h];
+    int hn = next(h); int hp = prev(h);
+    int gn = next(g); int gp = prev(g);
+    int a = origin[h];
+    int b = origin[hn];
+    int c = origin[hp];
+    int d = origin[gp];
+    int thn = twin[hn]; int thp = twin[hp];
+    int tgn = twin[gn]; int tgp = twin[gp];
+    origin[h] = d; origin[hn] = c; origin[hp] = a;
+    origin[g] = c; origin[gn] = d; origin[gp] = b;
+    link(h, g);
+    link(hn, thp);
+    link(hp, tgn);
+    link(gn, tgp);
+    link(gp, thn);
+    out[a] = hp;
+    out[b] = gp;
+    out[c] = hn;
+    out[d] = h;
+  }
+
+  // The triangles in use, with the vertices of every triangle, starting
+  // from its first half-edge, given by vertex_id
+  template <class Vertex_id>
+  triangles<point2d> to_triangles(long num_points, point2d* p, const Vertex_id& vertex_id) const {
+    long m = nb_triangles();
+    parray<bool> used(m, [&] (long t) {
+      return alive((int) t);
+    });
+    parray<long> I = pack_index(used.cbegin(), used.cend());
+    triangle* rt = newA(triangle, I.size());
+    parallel_for(0L, (long) I.size(), [&] (long i) {
+      long t = I[i];
+      rt[i] = triangle(vertex_id(origin[3 * t]), vertex_id(origin[3 * t + 1]), vertex_id(origin[3 * t + 2]));
+    });
+    return triangles<point2d>(num_points, I.size(), p, rt);
+  }
+
+};
+
+} // end namespace
+} // end namespace
+
+#endif /*! _PCTL_HALFEDGE_H_ */
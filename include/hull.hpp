@@ -21,8 +21,10 @@
 // WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 
+#include <chrono>
 #include "datapar.hpp"
 #include "geometry.hpp"
+#include "utils.hpp"
 
 #ifndef _PCTL_PBBS_HULL_H_
 #define _PCTL_PBBS_HULL_H_
@@ -43,146 +45,354 @@ using iter = typename parray<Item>::iterator;
 template <class Item>
 using citer = typename parray<Item>::const_iterator;
 
-template <class F1, class F2>
-pair<intT, intT> double_pack(iter<intT> a, intT n, F1 lf, F2 rf) {
-  intT ll = 0, lm = 0;
-  intT rm = n - 1, rr = n - 1;
-  while (1) {
-    while (lm <= rm && !rf(a[lm])) {
-      if (lf(a[lm])) {
-        a[ll++] = a[lm];
+// The points of a subproblem, one array per coordinate and one for their
+// indices in the input, moved together by the partitions, so that every
+// level of the recursion streams them once
+struct hull_points {
+  intT* id;
+  double* x;
+  double* y;
+
+  hull_points operator+(intT k) const {
+    return { id + k, x + k, y + k };
+  }
+
+  intT point_id(intT i) const {
+    return id[i];
+  }
+
+  double point_x(intT i) const {
+    return x[i];
+  }
+
+  double point_y(intT i) const {
+    return y[i];
+  }
+
+  template <class Points>
+  void set(intT i, const Points& from, intT j) {
+    id[i] = from.point_id(j);
+    x[i] = from.point_x(j);
+    y[i] = from.point_y(j);
+  }
+};
+
+// The input of the first partition, which builds the first hull_points
+struct hull_input {
+  const point2d* p;
+
+  intT point_id(intT i) const {
+    return i;
+  }
+
+  double point_x(intT i) const {
+    return p[i].x;
+  }
+
+  double point_y(intT i) const {
+    return p[i].y;
+  }
+};
+
+// triangle_area(a, b, (x, y))
+inline double triangle_area(const point2d& a, const point2d& b, double x, double y) {
+  return (b.x - a.x) * (y - a.y) - (b.y - a.y) * (x - a.x);
+}
+
+// The two sides of a partition, with the farthest point of each side, by
+// its index in the input, -1 if the side is empty
+struct hull_partition {
+  intT n1, n2;
+  intT split1, split2;
+  double d1, d2;
+
+  hull_partition()
+  : n1(0), n2(0), split1(-1), split2(-1), d1(0.0), d2(0.0) { }
+
+  void add(int side, intT j, double d) {
+    if (side == 1) {
+      n1++;
+      if (split1 < 0 || d > d1) {
+        split1 = j;
+        d1 = d;
       }
-      lm++;
-    }
-    while (rm >= lm && !lf(a[rm])) {
-      if (rf(a[rm])) {
-        a[rr--] = a[rm];
+    } else if (side == 2) {
+      n2++;
+      if (split2 < 0 || d > d2) {
+        split2 = j;
+        d2 = d;
       }
-      rm--;
     }
-    if (lm >= rm) break;
-    auto tmp = a[rm--];
-    a[rr--] = a[lm++];
-    a[ll++] = tmp;
   }
-  intT n1 = ll;
-  intT n2 = n - rr - 1;
-  return pair<intT,intT>(n1, n2);
+
+  void merge(const hull_partition& other) {
+    n1 += other.n1;
+    n2 += other.n2;
+    if (other.split1 >= 0 && (split1 < 0 || other.d1 > d1)) {
+      split1 = other.split1;
+      d1 = other.d1;
+    }
+    if (other.split2 >= 0 && (split2 < 0 || other.d2 > d2)) {
+      split2 = other.split2;
+      d2 = other.d2;
+    }
+  }
+};
+
+// Size of the blocks of a parallel partition
+#define QUICKHULL_BLOCK_SIZE 2048
+
+// Moves the n points of in to out, of size m, those of side 1 to the
+// front and those of side 2 to the back, where classify(x, y, d) returns
+// the side of a point, or 0 to drop it, and sets its distance d on that
+// side. classify is called once per point, and the farthest point of each
+// side, the split point of the next level, is found in the same pass.
+template <class Points, class Classify>
+hull_partition partition_seq(const Points& in, hull_points out, intT n, intT m, const Classify& classify) {
+  hull_partition result;
+  for (intT i = 0; i < n; i++) {
+    double d;
+    int side = classify(in.point_x(i), in.point_y(i), d);
+    result.add(side, in.point_id(i), d);
+    if (side == 1) {
+      out.set(result.n1 - 1, in, i);
+    } else if (side == 2) {
+      out.set(m - result.n2, in, i);
+    }
+  }
+  return result;
+}
+
+// The sides of the n points of in, with the farthest point of each, as
+// found by partition, without moving the points
+template <class Points, class Classify>
+hull_partition partition_count(const Points& in, intT n, const Classify& classify) {
+  intT nb_blocks = 1 + (n - 1) / QUICKHULL_BLOCK_SIZE;
+  parray<hull_partition> blocks(nb_blocks, [&] (intT b) {
+    hull_partition r;
+    intT hi = std::min(n, (b + 1) * QUICKHULL_BLOCK_SIZE);
+    for (intT i = b * QUICKHULL_BLOCK_SIZE; i < hi; i++) {
+      double d;
+      int side = classify(in.point_x(i), in.point_y(i), d);
+      r.add(side, in.point_id(i), d);
+    }
+    return r;
+  });
+  hull_partition result;
+  for (intT b = 0; b < nb_blocks; b++) {
+    result.merge(blocks[b]);
+  }
+  return result;
 }
 
-intT quick_hull_seq(iter<intT> indices, point2d* p, intT n, intT l, intT r) {
-  if (n < 2) return n;
-  intT split_point = indices[0];
-  double max_area = triangle_area(p[l], p[r], p[split_point]);
-  for (intT i = 1; i < n; i++) {
-    intT j = indices[i];
-    double a = triangle_area(p[l], p[r], p[j]);
-    if (a > max_area) {
-      max_area = a;
-      split_point = j;
+// Same as partition_seq; the blocks are classified in parallel, keeping
+// the sides of their points, and then moved to the offsets given by their
+// counts, to the points returned by output(counts) along with their size
+template <class Points, class Classify, class Output>
+hull_partition partition_blocks(const Points& in, intT n, const Classify& classify, const Output& output) {
+  hull_partition result;
+  intT nb_blocks = 1 + (n - 1) / QUICKHULL_BLOCK_SIZE;
+  parray<char> sides(n);
+  parray<hull_partition> blocks(nb_blocks, [&] (intT b) {
+    hull_partition r;
+    intT hi = std::min(n, (b + 1) * QUICKHULL_BLOCK_SIZE);
+    for (intT i = b * QUICKHULL_BLOCK_SIZE; i < hi; i++) {
+      double d;
+      int side = classify(in.point_x(i), in.point_y(i), d);
+      sides[i] = (char) side;
+      r.add(side, in.point_id(i), d);
     }
+    return r;
+  });
+  parray<intT> offsets1(nb_blocks);
+  parray<intT> offsets2(nb_blocks);
+  for (intT b = 0; b < nb_blocks; b++) {
+    offsets1[b] = result.n1;
+    offsets2[b] = result.n2;
+    result.merge(blocks[b]);
   }
-  
-  pair<intT, intT> nn = double_pack(indices, n, [&] (intT i) {
-    return triangle_area(p[l], p[split_point], p[i]) > EPS;
-  }, [&] (intT i) {
-    return triangle_area(p[split_point], p[r], p[i]) > EPS;
+  std::pair<hull_points, intT> out = output(result);
+  parallel_for((intT)0, nb_blocks, [&] (intT b) {
+    intT o1 = offsets1[b];
+    intT o2 = out.second - result.n2 + offsets2[b];
+    intT hi = std::min(n, (b + 1) * QUICKHULL_BLOCK_SIZE);
+    for (intT i = b * QUICKHULL_BLOCK_SIZE; i < hi; i++) {
+      if (sides[i] == 1) {
+        out.first.set(o1++, in, i);
+      } else if (sides[i] == 2) {
+        out.first.set(o2++, in, i);
+      }
+    }
   });
-  intT n1 = nn.first;
-  intT n2 = nn.second;
-  
-  intT m1, m2;
-  m1 = quick_hull_seq(indices, p, n1, l, split_point);
-  m2 = quick_hull_seq(indices + n - n2, p, n2, split_point, r);
-  for (intT i = 0; i < m2; i++) {
-    indices[i + m1 + 1] = indices[i + n - n2];
+  return result;
+}
+
+// Same as partition_seq, by blocks above QUICKHULL_BLOCK_SIZE points
+template <class Points, class Classify>
+hull_partition partition(const Points& in, hull_points out, intT n, intT m, const Classify& classify) {
+  if (n <= QUICKHULL_BLOCK_SIZE) {
+    return partition_seq(in, out, n, m, classify);
   }
-  indices[m1] = split_point;
+  return partition_blocks(in, n, classify, [&] (const hull_partition&) {
+    return std::make_pair(out, m);
+  });
+}
+
+#ifdef TIME_MEASURE
+#define QUICKHULL_MAX_LEVELS 64
+// time of the partitions of every level of the parallel recursion, and of
+// the sequential subproblems
+double quickhull_level_time[QUICKHULL_MAX_LEVELS];
+double quickhull_sequential_time;
+#endif
+
+// The hull between l and split, then split, then the hull between split
+// and r, where split is the farthest of the n points of in from (l, r),
+// of which it is one, written to the front of in.id; tmp is scratch space
+// for n points
+intT quick_hull_seq(hull_points in, hull_points tmp, point2d* p, intT n, intT l, intT r, intT split) {
+  if (n < 2) {
+    return n;
+  }
+  point2d pl = p[l], pr = p[r], ps = p[split];
+  hull_partition sides = partition_seq(in, tmp, n, n, [&] (double x, double y, double& d) {
+    double a1 = triangle_area(pl, ps, x, y);
+    double a2 = triangle_area(ps, pr, x, y);
+    d = (a1 > EPS) ? a1 : a2;
+    return (a1 > EPS) ? 1 : (a2 > EPS) ? 2 : 0;
+  });
+  intT n1 = sides.n1;
+  intT n2 = sides.n2;
+  intT m1 = quick_hull_seq(tmp, in, p, n1, l, split, sides.split1);
+  intT m2 = quick_hull_seq(tmp + (n - n2), in + (n - n2), p, n2, split, r, sides.split2);
+  pmem::copy(tmp.id, tmp.id + m1, in.id);
+  in.id[m1] = split;
+  pmem::copy(tmp.id + n - n2, tmp.id + n - n2 + m2, in.id + m1 + 1);
   return m1 + 1 + m2;
 }
 
 constexpr char quickhull_file[] = "quickhull";
 
-intT quick_hull(iter<intT> indices, iter<intT> tmp, iter<point2d> p, intT n, intT l, intT r) {
+intT quick_hull(hull_points in, hull_points tmp, point2d* p, intT n, intT l, intT r, intT split, int level = 0) {
   intT result;
   par::cstmt<quickhull_file, intT>([&] { return n * std::log2(n); }, [&] {
     if (n < 2) {
-      result = quick_hull_seq(indices, p, n, l, r);
+      result = quick_hull_seq(in, tmp, p, n, l, r, split);
     } else {
-      auto greater = [&] (double x, double y) {
-        return x > y;
-      };
-
 #ifdef TIME_MEASURE
       auto start = std::chrono::system_clock::now();
 #endif
-/*      intT split = indices[0];
-      double max_area = triangle_area(p[l], p[r], p[split]);
-      for (intT i = 1; i < n; i++) {
-        intT j = indices[i];
-        double a = triangle_area(p[l], p[r], p[j]);
-        if (a > max_area) {
-          max_area = a;
-          split = j;
-        }
-      }*/
-
-      // Finding some point on the convex hull between l and r
-      intT idx = (intT)max_index(indices, indices + n, (double)0.0, std::greater<double>(), [&] (intT j, double) {
-        return triangle_area(p[l], p[r], p[indices[j]]);
+      // the points beyond (l, split), and those beyond (split, r), each
+      // with its farthest point, on the hull
+      point2d pl = p[l], pr = p[r], ps = p[split];
+      hull_partition sides = partition(in, tmp, n, n, [&] (double x, double y, double& d) {
+        double a1 = triangle_area(pl, ps, x, y);
+        double a2 = triangle_area(ps, pr, x, y);
+        d = (a1 > EPS) ? a1 : a2;
+        return (a1 > EPS) ? 1 : (a2 > EPS) ? 2 : 0;
       });
-      intT split = indices[idx];
-
-/*      intT split = (intT)reduce(indices, indices + n, indices[0], [&] (intT x, intT y) {
-        if (triangle_area(p[l], p[r], p[x]) > triangle_area(p[l], p[r], p[y])) {
-          return x;
-        } else {
-          return y;
-        }
-      });*/
-
-#ifdef TIME_MEASURE  
-      auto end = std::chrono::system_clock::now();
-      std::chrono::duration<float> diff = end - start;
-//      printf ("exectime reduce quickhull %.3lf\n", diff.count());
-#endif
-
-/*      if (split_point != split) {
-        std::cerr << "Fuck off! " << max_area << " " << triangle_area(p[l], p[r], p[split]) << " " << split_point << " " << split << " " << n << std::endl;
-      }*/
-
+      intT n1 = sides.n1;
+      intT n2 = sides.n2;
 #ifdef TIME_MEASURE
-      start = std::chrono::system_clock::now();
-#endif      
-      // vertices on the convex hull between l and split
-      intT n1 = (intT)dps::filter(indices, indices + n, tmp, [&] (intT i) {
-        return triangle_area(p[l], p[split], p[i]) > EPS;
-      });
-      // vertices on the convex hull between split and r
-      intT n2 = (intT)dps::filter(indices, indices + n, tmp + n1, [&] (intT i) {
-        return triangle_area(p[split], p[r], p[i]) > EPS;
-      });
-#ifdef TIME_MEASURE  
-      end = std::chrono::system_clock::now();
-      diff = end - start;
-//      printf ("exectime filters quickhull %.3lf\n", diff.count());
-#endif      
+      std::chrono::duration<double> diff = std::chrono::system_clock::now() - start;
+      utils::writeAdd(&quickhull_level_time[std::min(level, QUICKHULL_MAX_LEVELS - 1)], diff.count());
+#endif
 
       intT m1, m2;
       par::fork2([&] {
-        m1 = quick_hull(tmp, indices, p, n1, l, split);
+        m1 = quick_hull(tmp, in, p, n1, l, split, sides.split1, level + 1);
       }, [&] {
-        m2 = quick_hull(tmp + n1, indices + n1, p, n2, split, r);
+        m2 = quick_hull(tmp + (n - n2), in + (n - n2), p, n2, split, r, sides.split2, level + 1);
       });
-      
-      pmem::copy(tmp, tmp + m1, indices);
-      indices[m1] = split;
-      pmem::copy(tmp + n1, tmp + n1 + m2, indices + m1 + 1);
+
+      // only the hull points are copied back
+      pmem::copy(tmp.id, tmp.id + m1, in.id);
+      in.id[m1] = split;
+      pmem::copy(tmp.id + n - n2, tmp.id + n - n2 + m2, in.id + m1 + 1);
       result = m1 + 1 + m2;
     }
   }, [&] {
-    result = quick_hull_seq(indices, p, n, l, r);
-  }); 
+#ifdef TIME_MEASURE
+    auto start = std::chrono::system_clock::now();
+#endif
+    result = quick_hull_seq(in, tmp, p, n, l, r, split);
+#ifdef TIME_MEASURE
+    std::chrono::duration<double> diff = std::chrono::system_clock::now() - start;
+    utils::writeAdd(&quickhull_sequential_time, diff.count());
+#endif
+  });
+  return result;
+}
+
+// The hull of the n points of the input on one side of (l, r), with split
+// the farthest of them, as given by quick_hull. The first partition reads
+// the n_input points of the input, keeping those for which on_side holds,
+// and the points of the recursion are only allocated once it has counted
+// them, which on most inputs leaves very few.
+template <class On_side>
+parray<intT> quick_hull_input(hull_input input, intT n_input, point2d* p,
+                              intT n, intT l, intT r, intT split, const On_side& on_side) {
+  if (n < 2) {
+    return parray<intT>(n, split);
+  }
+#ifdef TIME_MEASURE
+  auto start = std::chrono::system_clock::now();
+#endif
+  point2d pl = p[l], pr = p[r], ps = p[split];
+  auto classify = [&] (double x, double y, double& d) {
+    if (! on_side(x, y)) {
+      return 0;
+    }
+    double a1 = triangle_area(pl, ps, x, y);
+    double a2 = triangle_area(ps, pr, x, y);
+    d = (a1 > EPS) ? a1 : a2;
+    return (a1 > EPS) ? 1 : (a2 > EPS) ? 2 : 0;
+  };
+  // two sets of points for the partitions to move between, allocated
+  // once the first one is counted
+  intT m = 0;
+  intT* ids = nullptr;
+  double* coordinates = nullptr;
+#ifndef MANUAL_ALLOCATION
+  parray<intT> ids_array;
+  parray<double> coordinates_array;
+#endif
+  hull_points in, tmp;
+  hull_partition sides = partition_blocks(input, n_input, classify, [&] (const hull_partition& counts) {
+    m = counts.n1 + counts.n2;
+#ifdef MANUAL_ALLOCATION
+    ids = newA(intT, 2 * m);
+    coordinates = newA(double, 4 * m);
+#else
+    ids_array = parray<intT>(2 * m);
+    coordinates_array = parray<double>(4 * m);
+    ids = ids_array.begin();
+    coordinates = coordinates_array.begin();
+#endif
+    in = { ids, coordinates, coordinates + m };
+    tmp = { ids + m, coordinates + 2 * m, coordinates + 3 * m };
+    return std::make_pair(tmp, m);
+  });
+  intT n1 = sides.n1;
+  intT n2 = sides.n2;
+#ifdef TIME_MEASURE
+  std::chrono::duration<double> diff = std::chrono::system_clock::now() - start;
+  utils::writeAdd(&quickhull_level_time[0], diff.count());
+#endif
+  intT m1, m2;
+  par::fork2([&] {
+    m1 = quick_hull(tmp, in, p, n1, l, split, sides.split1, 1);
+  }, [&] {
+    m2 = quick_hull(tmp + (m - n2), in + (m - n2), p, n2, split, r, sides.split2, 1);
+  });
+  parray<intT> result(m1 + 1 + m2);
+  pmem::copy(tmp.id, tmp.id + m1, result.begin());
+  result[m1] = split;
+  pmem::copy(tmp.id + m - n2, tmp.id + m - n2 + m2, result.begin() + m1 + 1);
+#ifdef MANUAL_ALLOCATION
+  free(ids);
+  free(coordinates);
+#endif
   return result;
 }
 
@@ -213,114 +423,61 @@ parray<intT> hull(parray<point2d>& p) {
   intT r = min_max.second;
 #ifdef TIME_MEASURE
       start = std::chrono::system_clock::now();
+      for (int i = 0; i < QUICKHULL_MAX_LEVELS; i++) {
+        quickhull_level_time[i] = 0.0;
+      }
+      quickhull_sequential_time = 0.0;
 #endif
 
-#ifdef MANUAL_ALLOCATION
-  bool* is_top_hull = newA(bool, n);
-  bool* is_bottom_hull = newA(bool, n);
-  intT* indices = newA(intT, n);
-  intT* tmp = newA(intT, n);
-#else
-  parray<bool> is_top_hull;
-  is_top_hull.prefix_tabulate(n, 0);
-  parray<bool> is_bottom_hull;
-  is_bottom_hull.prefix_tabulate(n, 0);
-  parray<intT> indices;
-  indices.prefix_tabulate(n, 0);
-  parray<intT> tmp(n, [&] (int i) {
-    return i;
+  // the sizes and farthest points of the points above (l, r) and of those
+  // below, which are only moved by the next partition
+  point2d pl = p[l], pr = p[r];
+  hull_input input = { p.cbegin() };
+  hull_partition sides = partition_count(input, n, [&] (double x, double y, double& d) {
+    double a = triangle_area(pl, pr, x, y);
+    d = (a > EPS) ? a : -a;
+    return (a > EPS) ? 1 : (a < EPS) ? 2 : 0;
   });
-#endif
-
-#ifdef TIME_MEASURE  
-      end = std::chrono::system_clock::now();
-      diff = end - start;
-      printf ("exectime init hull %.3lf\n", diff.count());
-#endif
-#ifdef TIME_MEASURE
-      start = std::chrono::system_clock::now();
-#endif
-  parallel_for((intT)0, n, [&] (intT i) {
-    double a = triangle_area(p[l], p[r], p[i]);
-    is_top_hull[i] = a > EPS;
-    is_bottom_hull[i] = a < EPS;
-  });
-#ifdef TIME_MEASURE  
-      end = std::chrono::system_clock::now();
-      diff = end - start;
-      printf ("exectime for hull %.3lf\n", diff.count());
-
-      start = std::chrono::system_clock::now();
-#endif
-#ifdef MANUAL_ALLOCATION
-  intT n1 = (intT)dps::pack(is_top_hull, tmp, tmp + n, indices);
-  intT n2 = (intT)dps::pack(is_bottom_hull, tmp, tmp + n, indices + n1);
-  free(is_top_hull);
-  free(is_bottom_hull);
-#else
-  intT n1 = (intT)dps::pack(is_top_hull.cbegin(), tmp.cbegin(), tmp.cend(), indices.begin());
-  intT n2 = (intT)dps::pack(is_bottom_hull.cbegin(), tmp.cbegin(), tmp.cend(), indices.begin() + n1);
-#endif
-
+  intT n1 = sides.n1;
+  intT n2 = sides.n2;
 #ifdef TIME_MEASURE
       end = std::chrono::system_clock::now();
       diff = end - start;
-      printf ("exectime packs hull %.3lf\n", diff.count());
+      printf ("exectime partition hull %.3lf\n", diff.count());
 
       start = std::chrono::system_clock::now();
 #endif
-/*  cout << n1 << " " << n2 << " " << l << " " << r << endl;
-  if (n2 == 2) {
-    for (int i = 0; i < n1; i++) {
-      cout << indices[i] << " ";
-    }
-    cout << endl;
 
-    for (int i = 0; i < n2; i++) {
-      cout << indices[i + n1] << " ";
-    }
-    cout << endl;
-  }*/
-
-  intT m1; intT m2;
+  parray<intT> top, bottom;
   par::fork2([&] {
-#ifdef MANUAL_ALLOCATION
-    m1 = quick_hull(indices, tmp, p.begin(), n1, l, r);
-#else
-    m1 = quick_hull(indices.begin(), tmp.begin(), p.begin(), n1, l, r);
-#endif
-//    m1 = quick_hull_seq(indices.begin(), p.begin(), n1, l, r);
+    top = quick_hull_input(input, n, p.begin(), n1, l, r, sides.split1, [&] (double x, double y) {
+      return triangle_area(pl, pr, x, y) > EPS;
+    });
   }, [&] {
-#ifdef MANUAL_ALLOCATION
-    m2 = quick_hull(indices + n1, tmp + n1, p.begin(), n2, r, l);
-#else
-    m2 = quick_hull(indices.begin() + n1, tmp.begin() + n1, p.begin(), n2, r, l);
-#endif
-//    m2 = quick_hull_seq(indices.begin() + n1, p.begin(), n2, r, l);
+    bottom = quick_hull_input(input, n, p.begin(), n2, r, l, sides.split2, [&] (double x, double y) {
+      return triangle_area(pl, pr, x, y) < EPS;
+    });
   });
+  intT m1 = (intT)top.size();
+  intT m2 = (intT)bottom.size();
 #ifdef TIME_MEASURE
       end = std::chrono::system_clock::now();
       diff = end - start;
       printf ("exectime hull call hull %.3lf\n", diff.count());
+      for (int i = 0; i < QUICKHULL_MAX_LEVELS; i++) {
+        if (quickhull_level_time[i] > 0.0) {
+          printf ("exectime level %d hull %.3lf\n", i, quickhull_level_time[i]);
+        }
+      }
+      printf ("exectime sequential levels hull %.3lf\n", quickhull_sequential_time);
 #endif
-  
-#ifdef MANUAL_ALLOCATION
-  pmem::copy(indices, indices + m1, tmp + 1);
-  pmem::copy(indices + n1, indices + n1 + m2, tmp + m1 + 2);
-#else
-  pmem::copy(indices.cbegin(), indices.cbegin() + m1, tmp.begin() + 1);
-  pmem::copy(indices.cbegin() + n1, indices.cbegin() + n1 + m2, tmp.begin() + m1 + 2);
-#endif
-  
-  tmp[0] = l;
-  tmp[m1 + 1] = r;
-#ifdef MANUAL_ALLOCATION
-  free(indices);
-  return parray<int>(indices, indices + m1 + 2 + m2);
-#else
-  tmp.resize(m1 + 2 + m2);
-  return tmp;
-#endif
+
+  parray<intT> result(m1 + 2 + m2);
+  result[0] = l;
+  pmem::copy(top.cbegin(), top.cend(), result.begin() + 1);
+  result[m1 + 1] = r;
+  pmem::copy(bottom.cbegin(), bottom.cend(), result.begin() + m1 + 2);
+  return result;
 }
 
 } // end namespace
@@ -0,0 +1,424 @@
+/* COPYRIGHT (c) 2015 Umut Acar, Arthur Chargueraud, and Michael
+ * Rainey
+ * All rights reserved.
+ *
+ * \file hull3d.hpp
+ * \brief Parallel 3d convex hull
+ *
+ */
+
+#include <vector>
+#include <limits>
+#include <algorithm>
+#include <unordered_set>
+#include <functional>
+#include "datapar.hpp"
+#include "geometry.hpp"
+#include "utils.hpp"
+#include "prandgen.hpp"
+
+#ifndef _PCTL_PBBS_HULL3D_H_
+#define _PCTL_PBBS_HULL3D_H_
+
+namespace pasl {
+namespace pctl {
+
+// Quickhull in 3d, with facet-level parallelism: the points outside the
+// current hull are kept in the outside set of one of the facets they see,
+// with the farthest of them, the apex of the facet, and every round
+//
+// - walks, for every facet with points, the facets visible from its apex,
+//   and reserves them with a random priority, as in speculativefor.hpp:
+//   in the order of the facets, the cones of neighboring facets, which
+//   overlap, would form long chains of losers;
+// - lets every apex that holds its reservations, and whose horizon does
+//   not touch the visible facets of a smaller priority, replace its
+//   visible facets by the cone of new facets over its horizon, in
+//   parallel with the others;
+// - moves the points of the removed facets to the first new facet of the
+//   same cone that they see, or drops them if they see none.
+//
+// A round thus only touches the facets and the points of its cones, and
+// the losers of a round are retried in the next one. A point sees a facet
+// when it is more than HULL3D_EPS above its plane, so that points almost
+// on the hull, e.g. on a sphere, may be left out of it. Fewer than 4
+// points, or coplanar ones, have no hull.
+
+#define HULL3D_EPS 1e-12
+// Number of points under which a cone assigns its points sequentially
+#define HULL3D_SEQ_SIZE 2048
+
+namespace quickhull3d {
+
+struct facet {
+  int v[3]; // counterclockwise seen from outside
+  int nb[3]; // facet across the edge from v[i] to v[i + 1]
+  vect3d normal; // unit outward normal
+  double offset; // normal.dot(p) - offset is the height of p
+  bool alive;
+  double farthest; // height of the apex
+  int apex; // farthest point of the outside set
+  long reserved; // smallest priority of the cones that reserved it
+};
+
+// A candidate cone: the facets visible from apex, starting from the facet
+// start, and the edges of the horizon, (facet in visible, edge) pairs
+struct cone {
+  int start;
+  int apex;
+  std::vector<int> visible;
+  std::vector<std::pair<int, int>> horizon;
+  long priority;
+  long offset; // of its new facets
+};
+
+class builder {
+public:
+
+  builder(parray<point3d>& points)
+  : p(points.begin()), n(points.size()), nb_facets(0), nb_active(0) { }
+
+  // The facets of the hull, as triangles of indices in the points
+  parray<triangle> run() {
+    if (!initial_simplex()) {
+      return parray<triangle>(0);
+    }
+    while (nb_active > 0) {
+      round();
+    }
+    parray<int> alive(nb_facets, [&] (long f) {
+      return facets[f].alive ? 1 : 0;
+    });
+    long m = dps::scan(alive.begin(), alive.end(), 0, [&] (int a, int b) {
+      return a + b;
+    }, alive.begin(), forward_exclusive_scan);
+    parray<triangle> result(m);
+    parallel_for(0L, nb_facets, [&] (long f) {
+      if (facets[f].alive) {
+        result[alive[f]] = triangle(facets[f].v[0], facets[f].v[1], facets[f].v[2]);
+      }
+    });
+    return result;
+  }
+
+private:
+
+  point3d* p;
+  long n;
+  parray<facet> facets;
+  std::vector<std::vector<int>> outside;
+  long nb_facets;
+  // the facets with a non-empty outside set
+  parray<int> active;
+  long nb_active;
+
+  double height(facet& f, int q) {
+    return f.normal.dot(p[q] - point3d(0, 0, 0)) - f.offset;
+  }
+
+  void set_plane(facet& f) {
+    vect3d e = (p[f.v[1]] - p[f.v[0]]).cross(p[f.v[2]] - p[f.v[0]]);
+    double l = e.length();
+    f.normal = (l > 0) ? e / l : e;
+    f.offset = f.normal.dot(p[f.v[0]] - point3d(0, 0, 0));
+    f.alive = true;
+    f.farthest = 0;
+    f.apex = -1;
+    f.reserved = std::numeric_limits<long>::max();
+  }
+
+  void reserve_facets(long m) {
+    if (m <= (long) facets.size()) {
+      return;
+    }
+    long c = std::max(m, 2 * (long) facets.size());
+    parray<facet> g(c);
+    pmem::copy(facets.cbegin(), facets.cbegin() + nb_facets, g.begin());
+    facets = g;
+    outside.resize(c);
+  }
+
+  // Moves each of the m points q to the outside set of the first of the
+  // facets first to first + count - 1 that it sees, if any
+  void distribute(const int* q, long m, long first, long count) {
+    std::vector<long> target(m);
+    std::vector<double> h(m);
+    auto locate = [&] (long i) {
+      target[i] = -1;
+      for (long f = first; f < first + count; f++) {
+        double d = height(facets[f], q[i]);
+        if (d > HULL3D_EPS) {
+          target[i] = f;
+          h[i] = d;
+          return;
+        }
+      }
+    };
+    if (m > HULL3D_SEQ_SIZE) {
+      parallel_for(0L, m, locate);
+    } else {
+      for (long i = 0; i < m; i++) {
+        locate(i);
+      }
+    }
+    for (long i = 0; i < m; i++) {
+      long f = target[i];
+      if (f < 0) {
+        continue;
+      }
+      outside[f].push_back(q[i]);
+      if (h[i] > facets[f].farthest) {
+        facets[f].farthest = h[i];
+        facets[f].apex = q[i];
+      }
+    }
+  }
+
+  // Sets active to the facets among candidates that are alive and have
+  // points
+  void activate(parray<int>& candidates) {
+    parray<int> next(candidates.size());
+    nb_active = dps::filter(candidates.cbegin(), candidates.cend(), next.begin(), [&] (int f) {
+      return facets[f].alive && !outside[f].empty();
+    });
+    active = next;
+  }
+
+  // The tetrahedron of the two extreme points in x, of the farthest point
+  // from their line, and of the farthest point from the plane of the three,
+  // with the points that see its facets
+  bool initial_simplex() {
+    if (n < 4) {
+      return false;
+    }
+    auto min_max = level1::reducei(p, p + n, std::make_pair(0L, 0L), [&] (std::pair<long, long> a, std::pair<long, long> b) {
+      return std::make_pair((p[b.first].x < p[a.first].x) ? b.first : a.first,
+                            (p[b.second].x > p[a.second].x) ? b.second : a.second);
+    }, [&] (long i, point3d) {
+      return std::make_pair(i, i);
+    });
+    int a = (int) min_max.first;
+    int b = (int) min_max.second;
+    vect3d ab = p[b] - p[a];
+    auto farthest = [&] (std::function<double(long)> f) {
+      return (int) max_index(p, p + n, 0.0, std::greater<double>(), [&] (long i, point3d) {
+        return f(i);
+      });
+    };
+    int c = farthest([&] (long i) {
+      return ab.cross(p[i] - p[a]).length();
+    });
+    vect3d e = ab.cross(p[c] - p[a]);
+    if (e.length() <= HULL3D_EPS) {
+      return false;
+    }
+    e = e / e.length();
+    int d = farthest([&] (long i) {
+      return std::abs(e.dot(p[i] - p[a]));
+    });
+    if (std::abs(e.dot(p[d] - p[a])) <= HULL3D_EPS) {
+      return false;
+    }
+    if (e.dot(p[d] - p[a]) > 0) {
+      std::swap(b, c);
+    }
+    // d is now below the facet (a, b, c)
+    int tv[4][3] = { {a, b, c}, {a, d, b}, {b, d, c}, {c, d, a} };
+    reserve_facets(64);
+    nb_facets = 4;
+    for (int f = 0; f < 4; f++) {
+      for (int j = 0; j < 3; j++) {
+        facets[f].v[j] = tv[f][j];
+      }
+      set_plane(facets[f]);
+    }
+    // the facet across every edge is the one with the reverse edge
+    for (int f = 0; f < 4; f++) {
+      for (int j = 0; j < 3; j++) {
+        int x = tv[f][j];
+        int y = tv[f][(j + 1) % 3];
+        for (int g = 0; g < 4; g++) {
+          for (int l = 0; l < 3; l++) {
+            if (tv[g][l] == y && tv[g][(l + 1) % 3] == x) {
+              facets[f].nb[j] = g;
+            }
+          }
+        }
+      }
+    }
+    parray<int> all(n, [&] (long q) {
+      return (int) q;
+    });
+    distribute(all.cbegin(), n, 0, 4);
+    parray<int> candidates(4, [&] (long f) {
+      return (int) f;
+    });
+    activate(candidates);
+    return true;
+  }
+
+  // The facets visible from the apex of c, from its start, and its horizon
+  void find_cone(cone& c) {
+    std::vector<int> stack(1, c.start);
+    std::unordered_set<int> seen;
+    auto visited = [&] (int f) {
+      if (c.visible.size() < 32) {
+        return std::find(c.visible.begin(), c.visible.end(), f) != c.visible.end();
+      }
+      if (seen.empty()) {
+        seen.insert(c.visible.begin(), c.visible.end());
+      }
+      return seen.count(f) > 0;
+    };
+    c.visible.push_back(c.start);
+    while (!stack.empty()) {
+      int f = stack.back();
+      stack.pop_back();
+      for (int j = 0; j < 3; j++) {
+        int g = facets[f].nb[j];
+        if (visited(g)) {
+          continue;
+        }
+        if (height(facets[g], c.apex) > HULL3D_EPS) {
+          c.visible.push_back(g);
+          if (!seen.empty()) {
+            seen.insert(g);
+          }
+          stack.push_back(g);
+        } else {
+          c.horizon.push_back(std::make_pair(f, j));
+        }
+      }
+    }
+  }
+
+  // Whether c holds its visible facets, and no cone of a smaller priority
+  // removes a facet across its horizon, whose neighbors c changes; the
+  // cones that only share facets across their horizons change distinct
+  // neighbors of them, and can be committed together
+  bool holds(cone& c) {
+    for (int f : c.visible) {
+      if (facets[f].reserved != c.priority) {
+        return false;
+      }
+    }
+    for (auto& e : c.horizon) {
+      if (facets[facets[e.first].nb[e.second]].reserved < c.priority) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  // Replaces the visible facets of c by the new facets c.offset + j over
+  // its horizon edges j, whose edges are (a, b), (b, apex) and (apex, a),
+  // and gives them the points of the visible facets
+  void commit(cone& c) {
+    long h = c.horizon.size();
+    std::vector<std::pair<int, int>> starts(h);
+    for (long j = 0; j < h; j++) {
+      facet& g = facets[c.horizon[j].first];
+      int e = c.horizon[j].second;
+      int a = g.v[e];
+      int b = g.v[(e + 1) % 3];
+      int outer = g.nb[e];
+      facet& f = facets[c.offset + j];
+      f.v[0] = a;
+      f.v[1] = b;
+      f.v[2] = c.apex;
+      f.nb[0] = outer;
+      set_plane(f);
+      for (int l = 0; l < 3; l++) {
+        if (facets[outer].nb[l] == c.horizon[j].first) {
+          facets[outer].nb[l] = (int) (c.offset + j);
+        }
+      }
+      starts[j] = std::make_pair(a, (int) j);
+    }
+    std::sort(starts.begin(), starts.end());
+    for (long j = 0; j < h; j++) {
+      facet& f = facets[c.offset + j];
+      auto next = std::lower_bound(starts.begin(), starts.end(), std::make_pair(f.v[1], -1));
+      int k = next->second;
+      f.nb[1] = (int) (c.offset + k);
+      facets[c.offset + k].nb[2] = (int) (c.offset + j);
+    }
+    std::vector<int> points;
+    for (int g : c.visible) {
+      facets[g].alive = false;
+      for (int q : outside[g]) {
+        if (q != c.apex) {
+          points.push_back(q);
+        }
+      }
+      std::vector<int>().swap(outside[g]);
+    }
+    distribute(points.data(), points.size(), c.offset, h);
+  }
+
+  void round() {
+    long nc = nb_active;
+    std::vector<cone> cones(nc);
+    parallel_for(0L, nc, [&] (long i) {
+      cone& c = cones[i];
+      c.start = active[i];
+      c.apex = facets[c.start].apex;
+      // a 31-bit hash, so that the shift stays within a long
+      c.priority = ((long) (prandgen::hashu((unsigned int) c.start) >> 1) << 32) | i;
+      find_cone(c);
+      for (int f : c.visible) {
+        utils::writeMin(&facets[f].reserved, c.priority);
+      }
+    });
+    parray<long> offsets(nc, [&] (long i) {
+      return holds(cones[i]) ? (long) cones[i].horizon.size() : -1L;
+    });
+    parray<bool> won(nc, [&] (long i) {
+      return offsets[i] >= 0;
+    });
+    parallel_for(0L, nc, [&] (long i) {
+      for (int f : cones[i].visible) {
+        facets[f].reserved = std::numeric_limits<long>::max();
+      }
+      offsets[i] = std::max(offsets[i], 0L);
+    });
+    long total = dps::scan(offsets.begin(), offsets.end(), 0L, [&] (long a, long b) {
+      return a + b;
+    }, offsets.begin(), forward_exclusive_scan);
+    reserve_facets(nb_facets + total);
+    parallel_for(0L, nc, [&] (long i) {
+      if (won[i]) {
+        cones[i].offset = nb_facets + offsets[i];
+        commit(cones[i]);
+      }
+    });
+    // the losers, unless removed by a winner, and the new facets
+    long first = nb_facets;
+    nb_facets += total;
+    parray<int> candidates(nc + total, [&] (long i) {
+      return (int) ((i < nc) ? active[i] : first + i - nc);
+    });
+    activate(candidates);
+  }
+
+};
+
+} // end namespace
+
+// The convex hull of the points, as a mesh of triangles oriented
+// counterclockwise seen from outside, over a copy of the points
+triangles<point3d> hull3d(parray<point3d>& points) {
+  quickhull3d::builder b(points);
+  parray<triangle> t = b.run();
+  long n = points.size();
+  point3d* rp = newA(point3d, n);
+  pmem::copy(points.cbegin(), points.cend(), rp);
+  triangle* rt = newA(triangle, t.size());
+  pmem::copy(t.cbegin(), t.cend(), rt);
+  return triangles<point3d>(n, t.size(), rp, rt);
+}
+
+} // end namespace
+} // end namespace
+
+#endif /*! _PCTL_PBBS_HULL3D_H_ */
@@ -0,0 +1,324 @@
+/* COPYRIGHT (c) 2015 Umut Acar, Arthur Chargueraud, and Michael
+ * Rainey
+ * All rights reserved.
+ *
+ * \file invertedindex.hpp
+ * \brief Parallel tokenizer, word count and inverted index
+ *
+ */
+
+#include <string>
+#include <cstring>
+#include <stdint.h>
+#include "datapar.hpp"
+#include "prandgen.hpp"
+#include "semisort.hpp"
+#include "samplesort.hpp"
+#include "blockradixsort.hpp"
+
+#ifndef _PBBS_PCTL_INVERTEDINDEX_H_
+#define _PBBS_PCTL_INVERTEDINDEX_H_
+
+namespace pasl {
+namespace pctl {
+
+/*---------------------------------------------------------------------*/
+/* Tokenizer */
+
+// Tokens are the maximal runs of letters and digits of a text
+inline bool is_token_char(char c) {
+  return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9');
+}
+
+// Token i is s[starts[i], ends[i]); both are found by a pack over the
+// flags of the first and last characters of the tokens
+class tokens {
+public:
+
+  const char* s;
+  parray<long> starts;
+  parray<long> ends;
+
+  tokens()
+  : s(nullptr) { }
+
+  tokens(const char* s, long n)
+  : s(s) {
+    parray<bool> is_start(n, [&] (long i) {
+      return is_token_char(s[i]) && (i == 0 || ! is_token_char(s[i - 1]));
+    });
+    starts = pack_index(is_start.cbegin(), is_start.cend());
+    parallel_for(0L, n, [&] (long i) {
+      is_start[i] = is_token_char(s[i]) && (i + 1 == n || ! is_token_char(s[i + 1]));
+    });
+    ends = pack_index(is_start.cbegin(), is_start.cend());
+    parallel_for(0L, (long) ends.size(), [&] (long i) {
+      ends[i]++;
+    });
+  }
+
+  long size() const {
+    return starts.size();
+  }
+
+  long length(long i) const {
+    return ends[i] - starts[i];
+  }
+
+  std::string operator[](long i) const {
+    return std::string(s + starts[i], length(i));
+  }
+
+};
+
+// A token as a key: equal when the characters are
+struct token_key {
+  const char* p;
+  long len;
+
+  bool operator==(const token_key& other) const {
+    return len == other.len && std::memcmp(p, other.p, len) == 0;
+  }
+};
+
+struct token_hash {
+  unsigned int operator()(const token_key& k) const {
+    // FNV-1a, then mixed
+    unsigned int h = 2166136261u;
+    for (long i = 0; i < k.len; i++) {
+      h = (h ^ (unsigned char) k.p[i]) * 16777619u;
+    }
+    return prandgen::hashu(h);
+  }
+};
+
+/*---------------------------------------------------------------------*/
+/* Word count */
+
+// Groups the token numbers by term with a semisort on the hash of the
+// tokens: order[groups[g], groups[g + 1]) are the tokens of term g
+parray<long> group_tokens(const tokens& toks, parray<long>& order) {
+  long m = toks.size();
+  order = parray<long>(m, [&] (long i) {
+    return i;
+  });
+  auto key_of = [&] (long i) {
+    token_key k;
+    k.p = toks.s + toks.starts[i];
+    k.len = toks.length(i);
+    return k;
+  };
+  return group_by(order.begin(), m, key_of, token_hash());
+}
+
+// One (token, count) pair per distinct term: the number of a token of the
+// term and the number of its occurrences, in no particular order
+parray<std::pair<long, long>> word_counts(const tokens& toks) {
+  parray<long> order;
+  parray<long> groups = group_tokens(toks, order);
+  return parray<std::pair<long, long>>(groups.size() - 1, [&] (long g) {
+    return std::make_pair(order[groups[g]], groups[g + 1] - groups[g]);
+  });
+}
+
+/*---------------------------------------------------------------------*/
+/* Inverted index */
+
+// The distinct terms of a text, with their number of occurrences and
+// their postings: the positions, in tokens, of their occurrences.
+//  - the token numbers are grouped by term as for word_counts;
+//  - the terms are then sorted by a sample sort, which numbers them in
+//    lexicographic order, and looked up by binary search;
+//  - a stable integer sort of the token numbers by term number gives the
+//    postings of every term in increasing order;
+//  - the postings are stored as the varint-coded gaps between successive
+//    positions, which takes a byte for most of the occurrences of the
+//    frequent terms.
+class inverted_index {
+private:
+
+  // terms, concatenated
+  std::string chars;
+  parray<long> term_offsets;
+  parray<long> counts;
+  parray<long> postings_offsets;
+  parray<unsigned char> postings_bytes;
+
+  static long varint_size(long x) {
+    long b = 1;
+    while (x >= 128) {
+      x >>= 7;
+      b++;
+    }
+    return b;
+  }
+
+  static long varint_write(unsigned char* out, long x) {
+    long b = 0;
+    while (x >= 128) {
+      out[b++] = (unsigned char) ((x & 127) | 128);
+      x >>= 7;
+    }
+    out[b++] = (unsigned char) x;
+    return b;
+  }
+
+  int compare_term(long t, const char* p, long m) const {
+    long len = term_offsets[t + 1] - term_offsets[t];
+    int c = std::memcmp(chars.data() + term_offsets[t], p, std::min(len, m));
+    if (c != 0) {
+      return c;
+    }
+    return (len < m) ? -1 : ((len > m) ? 1 : 0);
+  }
+
+public:
+
+  inverted_index() { }
+
+  inverted_index(const tokens& toks) {
+    long m = toks.size();
+    parray<long> order;
+    parray<long> groups = group_tokens(toks, order);
+    long nb_terms = groups.size() - 1;
+    // the groups, in the lexicographic order of their terms
+    parray<long> sorted(nb_terms, [&] (long g) {
+      return g;
+    });
+    sample_sort(sorted.begin(), (int) nb_terms, [&] (long g, long h) {
+      long i = order[groups[g]];
+      long j = order[groups[h]];
+      long li = toks.length(i);
+      long lj = toks.length(j);
+      int c = std::memcmp(toks.s + toks.starts[i], toks.s + toks.starts[j], std::min(li, lj));
+      return c < 0 || (c == 0 && li < lj);
+    });
+    term_offsets = parray<long>(nb_terms + 1, [&] (long t) {
+      return (t == nb_terms) ? 0L : toks.length(order[groups[sorted[t]]]);
+    });
+    long total = dps::scan(term_offsets.begin(), term_offsets.end(), 0L, [&] (long x, long y) {
+      return x + y;
+    }, term_offsets.begin(), forward_exclusive_scan);
+    chars = std::string(total, ' ');
+    parallel_for(0L, nb_terms, [&] (long t) {
+      long i = order[groups[sorted[t]]];
+      std::copy(toks.s + toks.starts[i], toks.s + toks.ends[i], &chars[term_offsets[t]]);
+    });
+    parray<int> term_of(m);
+    {
+      parray<int> term_of_group(nb_terms);
+      parallel_for(0L, nb_terms, [&] (long t) {
+        term_of_group[sorted[t]] = (int) t;
+      });
+      auto complexity_fct = [&] (long lo, long hi) {
+        return groups[hi] - groups[lo];
+      };
+      range::parallel_for(0L, nb_terms, complexity_fct, [&] (long g) {
+        for (long k = groups[g]; k < groups[g + 1]; k++) {
+          term_of[order[k]] = term_of_group[g];
+        }
+      });
+    }
+    sorted.clear();
+    groups.clear();
+    // postings, in increasing order for every term
+    parallel_for(0L, m, [&] (long i) {
+      order[i] = i;
+    });
+    parray<long> offsets(nb_terms + 1);
+    if (m > 0) {
+      intsort::integer_sort(order.begin(), offsets.begin(), m, std::max(1L, nb_terms), [&] (long i) {
+        return (long) term_of[i];
+      });
+    }
+    offsets[nb_terms] = m;
+    counts = parray<long>(nb_terms, [&] (long t) {
+      return offsets[t + 1] - offsets[t];
+    });
+    auto gap = [&] (long k, long t) {
+      return (k == offsets[t]) ? order[k] : order[k] - order[k - 1];
+    };
+    auto complexity_fct = [&] (long lo, long hi) {
+      return offsets[hi] - offsets[lo];
+    };
+    postings_offsets = parray<long>(nb_terms + 1, 0L);
+    range::parallel_for(0L, nb_terms, complexity_fct, [&] (long t) {
+      long b = 0;
+      for (long k = offsets[t]; k < offsets[t + 1]; k++) {
+        b += varint_size(gap(k, t));
+      }
+      postings_offsets[t] = b;
+    });
+    long nb_bytes = dps::scan(postings_offsets.begin(), postings_offsets.end(), 0L, [&] (long x, long y) {
+      return x + y;
+    }, postings_offsets.begin(), forward_exclusive_scan);
+    postings_bytes = parray<unsigned char>(nb_bytes);
+    range::parallel_for(0L, nb_terms, complexity_fct, [&] (long t) {
+      unsigned char* out = postings_bytes.begin() + postings_offsets[t];
+      for (long k = offsets[t]; k < offsets[t + 1]; k++) {
+        out += varint_write(out, gap(k, t));
+      }
+    });
+  }
+
+  long nb_terms() const {
+    return counts.size();
+  }
+
+  std::string term(long t) const {
+    return chars.substr(term_offsets[t], term_offsets[t + 1] - term_offsets[t]);
+  }
+
+  long count(long t) const {
+    return counts[t];
+  }
+
+  // Number of the term p[0, m), or -1
+  long find(const char* p, long m) const {
+    long lo = 0;
+    long hi = nb_terms();
+    while (lo < hi) {
+      long mid = lo + (hi - lo) / 2;
+      if (compare_term(mid, p, m) < 0) {
+        lo = mid + 1;
+      } else {
+        hi = mid;
+      }
+    }
+    return (lo < nb_terms() && compare_term(lo, p, m) == 0) ? lo : -1;
+  }
+
+  long find(const std::string& p) const {
+    return find(p.c_str(), p.length());
+  }
+
+  // Positions, in tokens, of the occurrences of term t, in increasing order
+  parray<long> postings(long t) const {
+    parray<long> result(counts[t]);
+    const unsigned char* in = postings_bytes.cbegin() + postings_offsets[t];
+    long pos = 0;
+    for (long k = 0; k < counts[t]; k++) {
+      long x = 0;
+      int shift = 0;
+      while (*in & 128) {
+        x |= (long) (*in++ & 127) << shift;
+        shift += 7;
+      }
+      x |= (long) (*in++) << shift;
+      pos = (k == 0) ? x : pos + x;
+      result[k] = pos;
+    }
+    return result;
+  }
+
+  long size_in_bytes() const {
+    return chars.size() + sizeof(long) * (term_offsets.size() + counts.size() + postings_offsets.size())
+         + postings_bytes.size();
+  }
+
+};
+
+} // end namespace
+} // end namespace
+
+#endif /*! _PBBS_PCTL_INVERTEDINDEX_H_ */
@@ -0,0 +1,278 @@
+/* COPYRIGHT (c) 2015 Umut Acar, Arthur Chargueraud, and Michael
+ * Rainey
+ * All rights reserved.
+ *
+ * \file knngraph.hpp
+ * \brief Approximate k-nearest neighbor graph of high-dimensional vectors
+ *
+ */
+
+#include <limits>
+#include <algorithm>
+#include "datapar.hpp"
+#include "prandgen.hpp"
+#include "selection.hpp"
+#include "graph.hpp"
+#include "distancekernel.hpp"
+
+#ifndef _PCTL_KNNGRAPH_H_
+#define _PCTL_KNNGRAPH_H_
+
+namespace pasl {
+namespace pctl {
+
+// The k nearest neighbors of every one of n vectors of dimension d, e.g.
+// d = 8 to 64 for embeddings, where the space partitions of octtree.hpp
+// and pointkdtree.hpp no longer prune. The graph is approximate:
+//
+// - every one of nb_trees random projection trees splits the vectors at
+//   the median of their projections on the line through two random ones
+//   of them, until the leaves hold at most KNNG_LEAF_SIZE vectors, and
+//   the vectors of a leaf are all compared with one another;
+// - then every iteration of neighbor descent compares every vector with
+//   the neighbors of its neighbors, forward and reverse, and stops when
+//   fewer than delta * n * k neighbors change.
+//
+// Each vector keeps its k best in the order of knn_insert, and is updated
+// by a single task at a time: the leaves of a tree are disjoint, and the
+// iterations of the descent read the candidates from a copy taken at the
+// start of the iteration. The distances are computed by squared_l2.
+
+#define KNNG_LEAF_SIZE 64
+// Size under which a subtree is built sequentially
+#define KNNG_SEQ_SIZE 4096
+
+template <class floatT>
+class knn_graph_builder {
+public:
+
+  knn_graph_builder(const floatT* data, long n, int d, int k)
+  : data(data), n(n), d(d), k(k),
+    dist(n * k, std::numeric_limits<floatT>::max()),
+    ngh(n * k, -1L),
+    projections(n) { }
+
+  // Adds the candidates of the leaves of a random projection tree
+  void add_tree(int seed) {
+    if (n == 0) {
+      return;
+    }
+    parray<int> perm(n, [&] (long i) {
+      return (int) i;
+    });
+    long leaf = std::max((long) KNNG_LEAF_SIZE, 2L * (k + 1));
+    split(perm.begin(), 0, n, leaf, prandgen::hashu((unsigned int) seed));
+  }
+
+  // Runs an iteration of neighbor descent and returns the number of
+  // neighbors that changed
+  long descend() {
+    long w = 2 * k;
+    // the candidates of every vector: its forward neighbors, new or old,
+    // then up to k reverse ones of each kind
+    parray<int> fresh(n * w, -1);
+    parray<int> old(n * w, -1);
+    parray<int> nb_fresh(n, 0);
+    parray<int> nb_old(n, 0);
+    parallel_for(0L, n, [&] (long u) {
+      for (int j = 0; j < k; j++) {
+        long e = ngh[u * k + j];
+        if (e < 0) {
+          continue;
+        }
+        if (is_new(e)) {
+          fresh[u * w + nb_fresh[u]++] = target(e);
+          ngh[u * k + j] = e & ~1L;
+        } else {
+          old[u * w + nb_old[u]++] = target(e);
+        }
+      }
+    });
+    parray<int> nb_forward_fresh(n, [&] (long u) {
+      return nb_fresh[u];
+    });
+    parray<int> nb_forward_old(n, [&] (long u) {
+      return nb_old[u];
+    });
+    parallel_for(0L, n, [&] (long u) {
+      for (int j = 0; j < nb_forward_fresh[u]; j++) {
+        add_reverse(fresh, nb_fresh, fresh[u * w + j], (int) u);
+      }
+      for (int j = 0; j < nb_forward_old[u]; j++) {
+        add_reverse(old, nb_old, old[u * w + j], (int) u);
+      }
+    });
+    parray<long> changes(n, [&] (long u) {
+      long c = 0;
+      const floatT* p = data + u * d;
+      int nf = std::min(nb_fresh[u], (int) w);
+      int no = std::min(nb_old[u], (int) w);
+      for (int a = 0; a < nf + no; a++) {
+        int v = (a < nf) ? fresh[u * w + a] : old[u * w + a - nf];
+        int vf = std::min(nb_fresh[v], (int) w);
+        int vo = std::min(nb_old[v], (int) w);
+        // pairs of old candidates were compared by earlier iterations
+        int end = (a < nf) ? vf + vo : vf;
+        for (int b = 0; b < end; b++) {
+          int x = (b < vf) ? fresh[v * w + b] : old[v * w + b - vf];
+          if (x != u) {
+            c += try_insert(u, x, squared_l2<floatT>::run(p, data + (long) x * d, d));
+          }
+        }
+      }
+      return c;
+    });
+    return level1::reduce(changes.cbegin(), changes.cend(), 0L, [&] (long a, long b) {
+      return a + b;
+    }, [&] (long c) {
+      return c;
+    });
+  }
+
+  // The graph, with the neighbors of every vector nearest first
+  graph::graph<int> to_graph() {
+    graph::vertex<int>* vertices = newA(graph::vertex<int>, n);
+    int* edges = newA(int, n * k);
+    parray<long> degrees(n, [&] (long u) {
+      int m = 0;
+      for (int j = k - 1; j >= 0; j--) {
+        long e = ngh[u * k + j];
+        if (e >= 0) {
+          edges[u * k + m++] = target(e);
+        }
+      }
+      vertices[u] = graph::vertex<int>(edges + u * k, m);
+      return (long) m;
+    });
+    long m = level1::reduce(degrees.cbegin(), degrees.cend(), 0L, [&] (long a, long b) {
+      return a + b;
+    }, [&] (long c) {
+      return c;
+    });
+    return graph::graph<int>(vertices, (int) n, (int) m, edges);
+  }
+
+private:
+
+  const floatT* data;
+  long n;
+  int d;
+  int k;
+  // the k best of every vector, farthest first: squared distances, and
+  // 2 * v + 1 for a neighbor v not yet used by the descent, 2 * v after
+  parray<floatT> dist;
+  parray<long> ngh;
+  parray<floatT> projections;
+
+  static int target(long e) {
+    return (int) (e >> 1);
+  }
+
+  static bool is_new(long e) {
+    return (e & 1L) != 0;
+  }
+
+  // Inserts v in the k best of u, if closer than the farthest of them and
+  // not already there, and returns 1 if so
+  long try_insert(long u, int v, floatT r) {
+    floatT* rn = dist.begin() + u * k;
+    long* pn = ngh.begin() + u * k;
+    if (r >= rn[0]) {
+      return 0;
+    }
+    for (int j = 0; j < k; j++) {
+      if (pn[j] >= 0 && target(pn[j]) == v) {
+        return 0;
+      }
+    }
+    knn_insert(rn, pn, k, r, 2L * v + 1);
+    return 1;
+  }
+
+  // Appends u to the candidates of v, past its forward ones, if there are
+  // fewer than 2k of them
+  void add_reverse(parray<int>& candidates, parray<int>& counts, int v, int u) {
+    int i = __sync_fetch_and_add(&counts[v], 1);
+    if (i < 2 * k) {
+      candidates[(long) v * 2 * k + i] = u;
+    }
+  }
+
+  void leaf_join(int* perm, long lo, long hi) {
+    for (long i = lo; i < hi; i++) {
+      const floatT* p = data + (long) perm[i] * d;
+      for (long j = i + 1; j < hi; j++) {
+        floatT r = squared_l2<floatT>::run(p, data + (long) perm[j] * d, d);
+        try_insert(perm[i], perm[j], r);
+        try_insert(perm[j], perm[i], r);
+      }
+    }
+  }
+
+  void split(int* perm, long lo, long hi, long leaf, unsigned int seed) {
+    if (hi - lo <= leaf) {
+      leaf_join(perm, lo, hi);
+      return;
+    }
+    long s = hi - lo;
+    const floatT* a = data + (long) perm[lo + prandgen::hashu(seed) % s] * d;
+    const floatT* b = data + (long) perm[lo + prandgen::hashu(seed + 1) % s] * d;
+    // the vectors are projected on the line through a and b; the side of
+    // a vector, against the median, is that of the hyperplane parallel to
+    // the bisector of a and b
+    auto project = [&] (long i) {
+      const floatT* p = data + (long) perm[i] * d;
+      floatT r = 0;
+      for (int j = 0; j < d; j++) {
+        r += p[j] * (a[j] - b[j]);
+      }
+      projections[perm[i]] = r;
+    };
+    auto less = [&] (int i, int j) {
+      return projections[i] < projections[j];
+    };
+    long mid = lo + s / 2;
+    unsigned int left = prandgen::hashu(2 * seed + 1);
+    unsigned int right = prandgen::hashu(2 * seed + 2);
+    if (s > KNNG_SEQ_SIZE) {
+      parallel_for(lo, hi, project);
+      pasl::pctl::nth_element(perm + lo, (int) s, (int) (mid - lo), less);
+      par::fork2([&] {
+        split(perm, lo, mid, leaf, left);
+      }, [&] {
+        split(perm, mid, hi, leaf, right);
+      });
+    } else {
+      for (long i = lo; i < hi; i++) {
+        project(i);
+      }
+      std::nth_element(perm + lo, perm + mid, perm + hi, less);
+      split(perm, lo, mid, leaf, left);
+      split(perm, mid, hi, leaf, right);
+    }
+  }
+
+};
+
+// The approximate k-nearest neighbor graph of the n vectors of dimension
+// d stored one after the other in data, from nb_trees random projection
+// trees and at most max_iterations iterations of neighbor descent
+template <class floatT>
+graph::graph<int> knn_graph(const floatT* data, long n, int d, int k, int nb_trees = 4,
+                            int max_iterations = 10, double delta = 0.001) {
+  knn_graph_builder<floatT> builder(data, n, d, k);
+  for (int t = 0; t < nb_trees; t++) {
+    builder.add_tree(t);
+  }
+  for (int i = 0; i < max_iterations; i++) {
+    if (builder.descend() <= delta * n * k) {
+      break;
+    }
+  }
+  return builder.to_graph();
+}
+
+} // end namespace
+} // end namespace
+
+#endif /*! _PCTL_KNNGRAPH_H_ */
@@ -0,0 +1,101 @@
+/* COPYRIGHT (c) 2015 Umut Acar, Arthur Chargueraud, and Michael
+ * Rainey
+ * All rights reserved.
+ *
+ * \file lcp.hpp
+ * \brief Parallel longest-common-prefix array of a suffix array
+ *
+ */
+
+#include <algorithm>
+#include "datapar.hpp"
+#include "rangemin.hpp"
+#include "uint40.hpp"
+
+#ifndef _PBBS_PCTL_LCP_H_
+#define _PBBS_PCTL_LCP_H_
+
+namespace pasl {
+namespace pctl {
+
+// LCP array of any suffix array, by the permuted LCP (PLCP) method of
+//   Juha Karkkainen, Giovanni Manzini and Simon J. Puglisi
+//   Permuted longest-common-prefix array
+//   Proc. CPM 2009
+// parallelized as in
+//   Julian Shun
+//   Fast parallel computation of longest common prefixes
+//   Proc. SC 2014
+// Phi[i] is the suffix that follows suffix i in the suffix array. In text
+// order, PLCP[i] = lcp(i, Phi[i]) is at least PLCP[i - 1] - 1, so a scan of
+// the text computes all of it with at most 2n character comparisons. The
+// text is cut into blocks of LCP_BLOCK positions. PLCP is first found at
+// the start of every block, in order, each from the lower bound given by
+// the previous one, PLCP[i] - LCP_BLOCK, so that these starts take at most
+// 2n comparisons in all, even on repetitive text, where a direct comparison
+// at every start would take O(n^2 / LCP_BLOCK). The blocks are then scanned
+// in parallel from their starts. PLCP overwrites Phi, then is permuted into
+// suffix array order.
+//
+// The result has the layout of the LCP given by DC3: LCP[i] is the length
+// of the longest common prefix of suffixes SA[i] and SA[i + 1], and
+// LCP[n - 1] = 0.
+
+// Number of text positions scanned sequentially
+#define LCP_BLOCK 8192
+
+template <class CharT, class Index>
+parray<Index> lcp_array(const CharT* s, const Index* SA, long n) {
+  using idx = typename index_arithmetic<Index>::type;
+  parray<Index> LCP;
+  if (n == 0) {
+    return LCP;
+  }
+  // n stands for the last suffix, which has no successor
+  parray<Index> plcp;
+  plcp.prefix_tabulate(n, 0);
+  parallel_for(0L, n, [&] (long i) {
+    plcp[(idx) SA[i]] = (i + 1 < n) ? (idx) SA[i + 1] : (idx) n;
+  });
+  long nb_blocks = (n + LCP_BLOCK - 1) / LCP_BLOCK;
+  auto extend = [&] (long i, long l) {
+    long j = (idx) plcp[i];
+    if (j == n) {
+      return 0L;
+    }
+    while (i + l < n && j + l < n && s[i + l] == s[j + l]) {
+      l++;
+    }
+    return l;
+  };
+  long bound = 0;
+  for (long b = 0; b < nb_blocks; b++) {
+    long i = b * LCP_BLOCK;
+    long l = extend(i, bound);
+    plcp[i] = (idx) l;
+    bound = std::max(l - LCP_BLOCK, 0L);
+  }
+  parallel_for(0L, nb_blocks, [&] (long b) {
+    long lo = b * LCP_BLOCK;
+    long hi = std::min(n, lo + LCP_BLOCK);
+    long l = (idx) plcp[lo];
+    for (long i = lo + 1; i < hi; i++) {
+      l = extend(i, std::max(l - 1, 0L));
+      plcp[i] = (idx) l;
+    }
+  });
+  LCP = parray<Index>(n, [&] (long i) {
+    return plcp[(idx) SA[i]];
+  });
+  return LCP;
+}
+
+template <class CharT, class Index>
+parray<Index> lcp_array(const CharT* s, const parray<Index>& SA) {
+  return lcp_array(s, SA.cbegin(), SA.size());
+}
+
+} // end namespace
+} // end namespace
+
+#endif /*! _PBBS_PCTL_LCP_H_ */
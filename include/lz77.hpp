@@ -0,0 +1,247 @@
+/* COPYRIGHT (c) 2015 Umut Acar, Arthur Chargueraud, and Michael
+ * Rainey
+ * All rights reserved.
+ *
+ * \file lz77.hpp
+ * \brief Parallel Lempel-Ziv (LZ77) factorization over a suffix array
+ *
+ */
+
+#include <string>
+#include <vector>
+#include <algorithm>
+#include "datapar.hpp"
+#include "suffixarray.hpp"
+#include "lcp.hpp"
+#include "rangemin.hpp"
+
+#ifndef _PBBS_PCTL_LZ77_H_
+#define _PBBS_PCTL_LZ77_H_
+
+namespace pasl {
+namespace pctl {
+
+// LZ77 factorization from the suffix array, as in
+//   Julian Shun and Fuyao Zhao
+//   Practical parallel Lempel-Ziv factorization
+//   Proc. DCC 2013
+// The longest previous factor of position p = SA[i] is shared with one of
+// the two nearest suffixes of rank around i that start before p, which are
+// the previous and next smaller values of SA around i. Their lcps with p
+// come from range-minimum queries over the LCP. The phrases then start at
+// the positions met by jumping from 0 to p + max(1, LPF[p]).
+//
+// Nearest smaller values and phrase starts are both computed by blocks of
+// LZ77_BLOCK positions in parallel: a stack finds the nearest smaller
+// values inside each block and a galloping search over range minima the
+// others; the jumps leaving each block are found from right to left, so
+// that a sequential walk visits at most one position per block.
+
+#define LZ77_BLOCK 4096
+
+// A phrase copies length characters from position source of the text, or,
+// when length is 0, is the single character source
+template <class Index>
+struct lz77_phrase {
+  Index source;
+  Index length;
+};
+
+// The value of left[i] in nearest_smaller_values when there is no smaller
+// value before i: -1, or 2^40 - 1 for uint40
+template <class Index>
+typename index_arithmetic<Index>::type lz77_none() {
+  return (typename index_arithmetic<Index>::type) (Index) -1;
+}
+
+// left[i] is the largest j < i with a[j] < a[i], or lz77_none, and right[i]
+// the smallest j > i with a[j] < a[i], or n. The items of a are distinct.
+template <class Index>
+void nearest_smaller_values(const Index* a, long n, parray<Index>& left, parray<Index>& right) {
+  left.prefix_tabulate(n, 0);
+  right.prefix_tabulate(n, 0);
+  if (n == 0) {
+    return;
+  }
+  basic_compact_rmq<Index> rmq(a, (Index) n);
+  auto smaller_before = [&] (long start, Index v) {
+    // smallest len with a minimum below v in [start - len, start)
+    if (start == 0) {
+      return (Index) -1;
+    }
+    long len = 1;
+    while (len < start && a[rmq.query((Index) (start - len), (Index) (start - 1))] > v) {
+      len *= 2;
+    }
+    long lo = len / 2;
+    long hi = std::min(len, start);
+    if (a[rmq.query((Index) (start - hi), (Index) (start - 1))] > v) {
+      return (Index) -1;
+    }
+    while (hi - lo > 1) {
+      long mid = lo + (hi - lo) / 2;
+      if (a[rmq.query((Index) (start - mid), (Index) (start - 1))] < v) {
+        hi = mid;
+      } else {
+        lo = mid;
+      }
+    }
+    return (Index) (start - hi);
+  };
+  auto smaller_after = [&] (long end, Index v) {
+    // smallest len with a minimum below v in [end, end + len)
+    if (end == n) {
+      return (Index) n;
+    }
+    long len = 1;
+    while (len < n - end && a[rmq.query((Index) end, (Index) (end + len - 1))] > v) {
+      len *= 2;
+    }
+    long lo = len / 2;
+    long hi = std::min(len, n - end);
+    if (a[rmq.query((Index) end, (Index) (end + hi - 1))] > v) {
+      return (Index) n;
+    }
+    while (hi - lo > 1) {
+      long mid = lo + (hi - lo) / 2;
+      if (a[rmq.query((Index) end, (Index) (end + mid - 1))] < v) {
+        hi = mid;
+      } else {
+        lo = mid;
+      }
+    }
+    return (Index) (end + hi - 1);
+  };
+  long nb_blocks = (n + LZ77_BLOCK - 1) / LZ77_BLOCK;
+  parallel_for(0L, nb_blocks, [&] (long b) {
+    long start = b * LZ77_BLOCK;
+    long end = std::min(n, start + LZ77_BLOCK);
+    std::vector<long> stack;
+    for (long i = start; i < end; i++) {
+      while (!stack.empty() && a[stack.back()] > a[i]) {
+        stack.pop_back();
+      }
+      left[i] = stack.empty() ? smaller_before(start, a[i]) : (Index) stack.back();
+      stack.push_back(i);
+    }
+    stack.clear();
+    for (long i = end - 1; i >= start; i--) {
+      while (!stack.empty() && a[stack.back()] > a[i]) {
+        stack.pop_back();
+      }
+      right[i] = stack.empty() ? smaller_after(end, a[i]) : (Index) stack.back();
+      stack.push_back(i);
+    }
+  });
+}
+
+// Factorization of s[0, n) given its suffix array, compared as unsigned
+// characters
+template <class CharT, class Index>
+parray<lz77_phrase<Index>> lz77_factorize(const CharT* s, const parray<Index>& SA) {
+  long n = SA.size();
+  parray<Index> LCP = lcp_array(s, SA);
+  parray<Index> left;
+  parray<Index> right;
+  nearest_smaller_values(SA.cbegin(), n, left, right);
+  // lengths and sources of the longest previous factors, in text order
+  parray<Index> lpf(n);
+  parray<Index> source(n);
+  {
+    basic_compact_rmq<Index> rmq(LCP.cbegin(), (Index) std::max(1L, n - 1));
+    auto lcp_of_ranks = [&] (long i, long j) {
+      return (j == i + 1) ? LCP[i] : LCP[rmq.query((Index) i, (Index) (j - 1))];
+    };
+    parallel_for(0L, n, [&] (long i) {
+      long p = SA[i];
+      Index l = (left[i] != lz77_none<Index>()) ? lcp_of_ranks(left[i], i) : Index(0);
+      Index r = (right[i] < n) ? lcp_of_ranks(i, right[i]) : Index(0);
+      if (l == 0 && r == 0) {
+        lpf[p] = 0;
+        source[p] = (Index) (unsigned char) s[p];
+      } else if (l >= r) {
+        lpf[p] = l;
+        source[p] = SA[left[i]];
+      } else {
+        lpf[p] = r;
+        source[p] = SA[right[i]];
+      }
+    });
+  }
+  LCP.clear();
+  left.clear();
+  right.clear();
+  auto next = [&] (long p) {
+    return p + std::max((long) lpf[p], 1L);
+  };
+  // jump[p] is the first position reached from p outside of its block
+  long nb_blocks = (n + LZ77_BLOCK - 1) / LZ77_BLOCK;
+  parray<long> jump(n);
+  parallel_for(0L, nb_blocks, [&] (long b) {
+    long start = b * LZ77_BLOCK;
+    long end = std::min(n, start + LZ77_BLOCK);
+    for (long p = end - 1; p >= start; p--) {
+      long q = next(p);
+      jump[p] = (q >= end) ? q : jump[q];
+    }
+  });
+  parray<long> entry(nb_blocks, -1L);
+  for (long p = 0; p < n; p = jump[p]) {
+    entry[p / LZ77_BLOCK] = p;
+  }
+  parray<bool> is_start(n, false);
+  parallel_for(0L, nb_blocks, [&] (long b) {
+    long end = std::min(n, (b + 1) * LZ77_BLOCK);
+    for (long p = entry[b]; p >= 0 && p < end; p = next(p)) {
+      is_start[p] = true;
+    }
+  });
+  parray<long> starts = pack_index(is_start.cbegin(), is_start.cend());
+  return parray<lz77_phrase<Index>>(starts.size(), [&] (long k) {
+    long p = starts[k];
+    lz77_phrase<Index> phrase;
+    phrase.source = source[p];
+    phrase.length = lpf[p];
+    return phrase;
+  });
+}
+
+template <class CharT>
+parray<lz77_phrase<intT>> lz77_factorize(const CharT* s, long n) {
+  // ordered as unsigned characters, as are the literals
+  parray<intT> SA = suffix_array((unsigned char*) s, (intT) n);
+  return lz77_factorize(s, SA);
+}
+
+// Decodes a factorization. The positions of the phrases come from a scan;
+// the copies are made in order, since a phrase may read the output of the
+// phrases before it, and itself when it overlaps its source.
+template <class Index>
+std::string lz77_decode(const parray<lz77_phrase<Index>>& phrases) {
+  long z = phrases.size();
+  parray<long> offsets(z + 1, [&] (long k) {
+    return (k == z) ? 0L : std::max((long) phrases[k].length, 1L);
+  });
+  long n = dps::scan(offsets.begin(), offsets.end(), 0L, [&] (long x, long y) {
+    return x + y;
+  }, offsets.begin(), forward_exclusive_scan);
+  std::string s(n, '\0');
+  for (long k = 0; k < z; k++) {
+    long p = offsets[k];
+    long len = phrases[k].length;
+    if (len == 0) {
+      s[p] = (char) (unsigned char) phrases[k].source;
+    } else {
+      long src = phrases[k].source;
+      for (long j = 0; j < len; j++) {
+        s[p + j] = s[src + j];
+      }
+    }
+  }
+  return s;
+}
+
+} // end namespace
+} // end namespace
+
+#endif /*! _PBBS_PCTL_LZ77_H_ */
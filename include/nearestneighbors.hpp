@@ -23,6 +23,7 @@
 #include <iostream>
 #include <limits>
 #include "octtree.hpp"
+#include "distancekernel.hpp"
 #include "parray.hpp"
 
 #ifndef _PCTL_PBBS_NEAREST_NEIGHBORS_H_
@@ -35,6 +36,12 @@ namespace pctl {
   
   // A k-nearest neighbor structure
   // requires vertexT to have pointT and vectT typedefs
+  //
+  // The searches take an approximation factor eps and a budget of leaves:
+  // with eps > 0, a box is searched only if it may hold a point closer
+  // than rn[0] / (1 + eps), so that the neighbors found are within 1 + eps
+  // of the exact ones, and with max_leaves >= 0, the search stops after
+  // max_leaves leaves, as soon as k neighbors are found.
   template <class intT, class vertexT, int maxK>
   struct nearest_neighbours_ds {
     typedef vertexT vertex;
@@ -65,6 +72,8 @@ namespace pctl {
       double rn[maxK]; // radius of current k nearest neighbors
       int quads;
       int k;
+      double radius_scale; // 1 / (1 + eps)
+      long leaves; // leaves left to search, or -1 for no limit
       kNN() {}
       
       // returns the ith smallest element (0 is smallest) up to k-1
@@ -72,12 +81,14 @@ namespace pctl {
         return pn[k - i - 1];
       }
       
-      kNN(vertex *p, int kk) {
+      kNN(vertex *p, int kk, double eps = 0.0, long max_leaves = -1) {
         if (kk > maxK) {
           cout << "k too large in kNN" << endl;
           abort();
         }
         k = kk;
+        radius_scale = 1.0 / (1.0 + eps);
+        leaves = max_leaves;
         quads = (1 << (p->pt).dimension());
         ps = p;
         for (int i=0; i < k; i++) {
@@ -102,10 +113,18 @@ namespace pctl {
         }
       }
       
+      // true once the budget of leaves is spent and k neighbors are found
+      bool exhausted() {
+        return leaves == 0 && pn[0] != NULL;
+      }
+      
       // looks for nearest neighbors in boxes for which ps is not in
       void nearest_ngh_trim(qotree* tree) {
-        if (!(tree->center).out_of_box(ps->pt, (tree->size / 2) + rn[0])) {
+        if (!exhausted() && !(tree->center).out_of_box(ps->pt, (tree->size / 2) + rn[0] * radius_scale)) {
           if (tree->is_leaf()) {
+            if (leaves > 0) {
+              leaves--;
+            }
             for (int i = 0; i < tree->count; i++) {
               update(tree->vertices[i]);
             }
@@ -120,6 +139,9 @@ namespace pctl {
       // looks for nearest neighbors in box for which ps is in
       void nearest_ngh(qotree* tree) {
         if (tree->is_leaf()) {
+          if (leaves > 0) {
+            leaves--;
+          }
           for (int i = 0; i < tree->count; i++) {
             vertex* pb = tree->vertices[i];
             if (pb != ps) {
@@ -145,8 +167,8 @@ namespace pctl {
     }
     
     // version that writes into result
-    void nearest_k(vertex* p, vertex** result, int k) {
-      kNN nn(p, k);
+    void nearest_k(vertex* p, vertex** result, int k, double eps = 0.0, long max_leaves = -1) {
+      kNN nn(p, k, eps, max_leaves);
       nn.nearest_ngh(tree);
       for (int i = 0; i < k; i++) {
         result[i] = NULL;
@@ -167,9 +189,14 @@ namespace pctl {
   
   // find the k nearest neighbors for all points in tree
   // places pointers to them in the .ngh field of each vertex
+  // (approximate ones with eps > 0 or max_leaves >= 0, as in kNN)
   template <class intT, int maxK, class vertexT>
-  void ANN(vertexT** v, int n, int k) {
+  void ANN(vertexT** v, int n, int k, double eps = 0.0, long max_leaves = -1) {
     typedef nearest_neighbours_ds<intT, vertexT, maxK> kNNT;
+    // the tree needs a point to take its bounding box from
+    if (n == 0) {
+      return;
+    }
 
 #ifdef TIME_MEASURE
       auto start = std::chrono::system_clock::now();
@@ -199,7 +226,7 @@ namespace pctl {
     
     // find nearest k neighbors for each point
     parallel_for(int(0), n, [&] (int i) {
-      ds.nearest_k(vr[i], vr[i]->ngh, k);
+      ds.nearest_k(vr[i], vr[i]->ngh, k, eps, max_leaves);
     });
 
 #ifdef TIME_MEASURE
@@ -233,8 +260,10 @@ namespace pctl {
     vertexNN() {}
   };
 
+  // The search over a tree of vertex pointers, as used by the Delaunay
+  // triangulation, on a copy of the points
   template <class intT, int maxK, class Point>
-  parray<intT> ANN(parray<Point>& points, int n, int k) {
+  parray<intT> ANN_vertices(parray<Point>& points, int n, int k, double eps = 0.0, long max_leaves = -1) {
 #ifdef TIME_MEASURE
     auto start = std::chrono::system_clock::now();
 #endif
@@ -256,7 +285,7 @@ namespace pctl {
     printf("exectime preliminary execution %.3lf\n", diff.count());
 #endif
 
-    ANN<intT, maxK, vertexNN<Point, maxK>>(vertices.begin(), n, k);
+    ANN<intT, maxK, vertexNN<Point, maxK>>(vertices.begin(), n, k, eps, max_leaves);
 #ifdef TIME_MEASURE
     start = std::chrono::system_clock::now();
 #endif
@@ -273,6 +302,204 @@ namespace pctl {
     return result;
   }
 
+  // A k-nearest neighbor structure over a point cloud, in which the points
+  // are numbered in Morton order: the candidates of a leaf are a range of
+  // the coordinate arrays, whose squared distances are computed by the
+  // kernels of distancekernel.hpp, vectorized for point2d and point3d
+  template <int maxK, class Point>
+  struct cloud_nearest_neighbours_ds {
+    typedef Point point;
+    typedef typename Point::floatT floatT;
+    typedef point_cloud<Point> cloud_type;
+    typedef cloud_dimtree_node<Point> qotree;
+    static const int dim = Point::dim;
+
+    const cloud_type& cloud;
+    qotree* tree;
+
+    cloud_nearest_neighbours_ds(const cloud_type& cloud)
+    : cloud(cloud) {
+      tree = qotree::dimtree(cloud);
+    }
+
+    void del() {
+      tree->del();
+      delete tree;
+    }
+
+    struct kNN {
+      const floatT* x;
+      const floatT* y;
+      const floatT* z;
+      long ps;  // the point for which we are trying to find a NN
+      floatT q[3];
+      long pn[maxK];  // the current k nearest neighbors (nearest last)
+      floatT rn[maxK]; // squared distance of current k nearest neighbors
+      int k;
+      floatT box_scale; // (1 + eps)^2, see nearest_neighbours_ds
+      long leaves; // leaves left to search, or -1 for no limit
+
+      // returns the ith smallest element (0 is smallest) up to k-1
+      long operator[] (const int i) {
+        return pn[k - i - 1];
+      }
+
+      kNN(const cloud_type& cloud, long p, int kk, double eps = 0.0, long max_leaves = -1) {
+        if (kk > maxK) {
+          cout << "k too large in kNN" << endl;
+          abort();
+        }
+        k = kk;
+        box_scale = (floatT) ((1.0 + eps) * (1.0 + eps));
+        leaves = max_leaves;
+        x = cloud.x.cbegin();
+        y = cloud.y.cbegin();
+        z = cloud.z.cbegin();
+        ps = p;
+        q[0] = x[p];
+        q[1] = y[p];
+        q[2] = (dim == 3) ? z[p] : 0.0;
+        for (int i = 0; i < k; i++) {
+          pn[i] = -1;
+          rn[i] = numeric_limits<floatT>::max();
+        }
+      }
+
+      // tries the points [lo, hi) but ps, KNN_BLOCK at a time
+      void update_range(long lo, long hi) {
+        floatT d[KNN_BLOCK];
+        for (long s = lo; s < hi; s += KNN_BLOCK) {
+          long e = std::min(hi, s + KNN_BLOCK);
+          squared_distances<floatT, dim>::run(x, y, z, s, e, q, d);
+          if (s <= ps && ps < e) {
+            d[ps - s] = numeric_limits<floatT>::max();
+          }
+          for (long i = s; i < e; i++) {
+            if (d[i - s] < rn[0]) {
+              knn_insert(rn, pn, k, d[i - s], i);
+            }
+          }
+        }
+      }
+
+      // squared distance from ps to the box of tree
+      floatT box_distance(qotree* tree) {
+        floatT h = tree->size / 2;
+        floatT ex = std::max(std::abs(q[0] - tree->center.x) - h, (floatT) 0);
+        floatT ey = std::max(std::abs(q[1] - tree->center.y) - h, (floatT) 0);
+        floatT r = ex * ex + ey * ey;
+        if (dim == 3) {
+          floatT ez = std::max(std::abs(q[2] - tree->center[2]) - h, (floatT) 0);
+          r += ez * ez;
+        }
+        return r;
+      }
+
+      // true once the budget of leaves is spent and k neighbors are found
+      bool exhausted() {
+        return leaves == 0 && pn[0] >= 0;
+      }
+
+      void update_leaf(qotree* tree) {
+        if (leaves > 0) {
+          leaves--;
+        }
+        update_range(tree->lo, tree->hi);
+      }
+
+      // looks for nearest neighbors in boxes for which ps is not in
+      void nearest_ngh_trim(qotree* tree) {
+        if (!exhausted() && box_distance(tree) * box_scale < rn[0]) {
+          if (tree->is_leaf()) {
+            update_leaf(tree);
+          } else {
+            for (int j = 0; j < tree->nb_children; j++) {
+              nearest_ngh_trim(tree->children[j]);
+            }
+          }
+        }
+      }
+
+      // looks for nearest neighbors in box for which ps is in
+      void nearest_ngh(qotree* tree) {
+        if (tree->is_leaf()) {
+          update_leaf(tree);
+        } else {
+          int i = tree->find_child(ps);
+          nearest_ngh(tree->children[i]);
+          for (int j = 0; j < tree->nb_children; j++) {
+            if (j != i) {
+              nearest_ngh_trim(tree->children[j]);
+            }
+          }
+        }
+      }
+    };
+
+    // writes the numbers in the cloud of the k nearest neighbors of the
+    // point of number p, nearest first, or -1 when there are fewer
+    void nearest_k(long p, long* result, int k, double eps = 0.0, long max_leaves = -1) {
+      kNN nn(cloud, p, k, eps, max_leaves);
+      nn.nearest_ngh(tree);
+      for (int i = 0; i < k; i++) {
+        result[i] = nn[i];
+      }
+    }
+
+  };
+
+  // find the k nearest neighbors for all points, in the Morton order of
+  // a point cloud built from them (approximate ones with eps > 0 or
+  // max_leaves >= 0, as in nearest_neighbours_ds)
+  template <class intT, int maxK, class Point>
+  parray<intT> ANN(parray<Point>& points, int n, int k, double eps = 0.0, long max_leaves = -1) {
+#ifdef TIME_MEASURE
+    auto start = std::chrono::system_clock::now();
+#endif
+
+    parray<intT> result;
+    result.prefix_tabulate(n * k, 0);
+
+    point_cloud<Point> cloud(points.begin(), n);
+
+#ifdef TIME_MEASURE
+    auto end = std::chrono::system_clock::now();
+    std::chrono::duration<float> diff = end - start;
+    printf("exectime ANN build point cloud %.3lf\n", diff.count());
+
+    start = std::chrono::system_clock::now();
+#endif
+
+    cloud_nearest_neighbours_ds<maxK, Point> ds(cloud);
+
+#ifdef TIME_MEASURE
+    end = std::chrono::system_clock::now();
+    diff = end - start;
+    printf("exectime ANN build tree %.3lf\n", diff.count());
+
+    start = std::chrono::system_clock::now();
+#endif
+
+    // find nearest k neighbors for each point
+    parallel_for(0, n, [&] (int i) {
+      long ngh[maxK];
+      ds.nearest_k(i, ngh, k, eps, max_leaves);
+      intT* out = result.begin() + (long) cloud.ids[i] * k;
+      for (int j = 0; j < std::min(n - 1, k); j++) {
+        out[j] = cloud.ids[ngh[j]];
+      }
+    });
+
+#ifdef TIME_MEASURE
+    end = std::chrono::system_clock::now();
+    diff = end - start;
+    printf("exectime ANN find nearest %.3lf\n", diff.count());
+#endif
+
+    ds.del();
+    return result;
+  }
+
 } // end namespace
 } // end namespace
 
@@ -26,6 +26,7 @@
 #include <cstdlib>
 #include "geometry.hpp"
 #include "blockradixsort.hpp"
+#include "pointcloud.hpp"
 
 #ifndef _PCTL_BENCH_OCTTREE_INCLUDED
 #define _PCTL_BENCH_OCTTREE_INCLUDED
@@ -450,6 +451,98 @@ constexpr char octtree_file[] = "octtree";
     }
   };
 
+  // *************************************************************
+  //    QUAD/OCT TREE OVER A POINT CLOUD
+  // *************************************************************
+
+  // The same tree over the Morton order of a point_cloud: every cell is the
+  // range [lo, hi) of the points of the cloud, the cells of its children are
+  // found by binary search on the next dim bits of the codes, and the empty
+  // ones are not stored. Leaves hold at most max_leaf_size points, or points
+  // with equal codes.
+  template <class Point>
+  class cloud_dimtree_node {
+    public :
+    typedef Point point;
+    typedef point_cloud<Point> cloud_type;
+
+    point center; // center of the box
+    double size;   // width of each dimension
+    long lo;
+    long hi;
+    int nb_children;
+    cloud_dimtree_node* children[8];
+
+    static cloud_dimtree_node* dimtree(const cloud_type& cloud) {
+      return new cloud_dimtree_node(cloud, 0, cloud.size(), cloud.center(), cloud.width, 0);
+    }
+
+    cloud_dimtree_node(const cloud_type& cloud, long lo, long hi, point cnt, double sz, int level)
+    : center(cnt), size(sz), lo(lo), hi(hi), nb_children(0) {
+      const int dim = cloud_type::dim;
+      // lowest bit of the digit of the children in the codes
+      int shift = dim * (cloud_type::morton_bits - level - 1);
+      if (hi - lo <= max_leaf_size || shift < 0) {
+        return;
+      }
+      const long* codes = cloud.codes.cbegin();
+      long prefix = codes[lo] & ~((1L << (shift + dim)) - 1);
+      long bounds[9];
+      int quads[8];
+      bounds[0] = lo;
+      for (int q = 1; q < (1 << dim); q++) {
+        bounds[q] = std::lower_bound(codes + bounds[q - 1], codes + hi, prefix | ((long) q << shift)) - codes;
+      }
+      bounds[1 << dim] = hi;
+      for (int q = 0; q < (1 << dim); q++) {
+        if (bounds[q] < bounds[q + 1]) {
+          quads[nb_children++] = q;
+        }
+      }
+      auto comp_fct = [&] (int l, int r) {
+        return bounds[quads[r - 1] + 1] - bounds[quads[l]];
+      };
+      range::parallel_for(0, nb_children, comp_fct, [&] (int i) {
+        int q = quads[i];
+        children[i] = new cloud_dimtree_node(cloud, bounds[q], bounds[q + 1], center.offset_point(q, size / 4.0), size / 2.0, level + 1);
+      });
+    }
+
+    bool is_leaf() {
+      return nb_children == 0;
+    }
+
+    long count() {
+      return hi - lo;
+    }
+
+    // Child holding the point of number i of the cloud
+    int find_child(long i) {
+      int c = 0;
+      while (children[c]->hi <= i) {
+        c++;
+      }
+      return c;
+    }
+
+    void del() {
+      for (int i = 0; i < nb_children; i++) {
+        children[i]->del();
+        delete children[i];
+      }
+      nb_children = 0;
+    }
+
+    // Returns the depth of the tree rooted at this node
+    int depth() {
+      int res = 0;
+      for (int i = 0; i < nb_children; i++) {
+        res = max(res, children[i]->depth());
+      }
+      return res + 1;
+    }
+  };
+
 template <class intT, class pointT, class vectT, class vertexT, class dataT>
 vertexT** dimtree_node<intT, pointT, vectT, vertexT, dataT>::wv = NULL;
 /*parray<vertexT*> dimtree_node<intT, pointT, vectT, vertexT, dataT>::wv;*/
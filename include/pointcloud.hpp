@@ -0,0 +1,175 @@
+/* COPYRIGHT (c) 2015 Umut Acar, Arthur Chargueraud, and Michael
+ * Rainey
+ * All rights reserved.
+ *
+ * \file pointcloud.hpp
+ * \brief Structure-of-arrays point cloud in Morton order
+ *
+ */
+
+#include <stdint.h>
+#include <algorithm>
+#include "datapar.hpp"
+#include "geometry.hpp"
+#include "blockradixsort.hpp"
+
+#ifndef _PCTL_POINTCLOUD_H_
+#define _PCTL_POINTCLOUD_H_
+
+namespace pasl {
+namespace pctl {
+
+// Points stored as one array per coordinate, in the order of their Morton
+// codes: the codes interleave the bits of the coordinates, quantized to
+// morton_bits bits on the bounding cube of the points, x in the lowest bit
+// of every group of dim bits, as in point::quadrant. Every cell of the
+// implicit quad/octree over the cube is thus a contiguous range of the
+// arrays, and a scan over a range of points reads the coordinates one after
+// the other instead of chasing a pointer per point.
+//
+// The points are sorted by a parallel radix sort of (code, index) pairs;
+// ids[i] is the index, in the input, of the i-th point.
+
+#define MORTON_CODE_BITS 60
+
+namespace morton {
+
+// Spreads the lowest 30 bits of x to the even bits
+inline uint64_t spread2(uint64_t x) {
+  x &= 0x3fffffffULL;
+  x = (x | (x << 16)) & 0x0000ffff0000ffffULL;
+  x = (x | (x << 8)) & 0x00ff00ff00ff00ffULL;
+  x = (x | (x << 4)) & 0x0f0f0f0f0f0f0f0fULL;
+  x = (x | (x << 2)) & 0x3333333333333333ULL;
+  x = (x | (x << 1)) & 0x5555555555555555ULL;
+  return x;
+}
+
+// Spreads the lowest 20 bits of x to the bits multiple of 3
+inline uint64_t spread3(uint64_t x) {
+  x &= 0xfffffULL;
+  x = (x | (x << 32)) & 0x001f00000000ffffULL;
+  x = (x | (x << 16)) & 0x001f0000ff0000ffULL;
+  x = (x | (x << 8)) & 0x100f00f00f00f00fULL;
+  x = (x | (x << 4)) & 0x10c30c30c30c30c3ULL;
+  x = (x | (x << 2)) & 0x1249249249249249ULL;
+  return x;
+}
+
+inline uint64_t code(const uint64_t* cell, int dim) {
+  if (dim == 2) {
+    return spread2(cell[0]) | (spread2(cell[1]) << 1);
+  }
+  return spread3(cell[0]) | (spread3(cell[1]) << 1) | (spread3(cell[2]) << 2);
+}
+
+} // end namespace
+
+template <class Point>
+class point_cloud {
+public:
+
+  using point = Point;
+  using floatT = typename Point::floatT;
+  static const int dim = Point::dim;
+  // bits per coordinate in the Morton codes
+  static const int morton_bits = MORTON_CODE_BITS / dim;
+
+  parray<floatT> x;
+  parray<floatT> y;
+  // empty in 2d
+  parray<floatT> z;
+  parray<int> ids;
+  parray<long> codes;
+  // bounding cube of the points
+  Point min_pt;
+  double width;
+
+  point_cloud()
+  : width(0.0) { }
+
+  point_cloud(Point* p, long n) {
+    build(p, n);
+  }
+
+  point_cloud(parray<Point>& p) {
+    build(p.begin(), p.size());
+  }
+
+  long size() const {
+    return ids.size();
+  }
+
+  floatT coordinate(long i, int d) const {
+    return (d == 0) ? x[i] : ((d == 1) ? y[i] : z[i]);
+  }
+
+  Point operator[](long i) const {
+    floatT c[3];
+    for (int d = 0; d < dim; d++) {
+      c[d] = coordinate(i, d);
+    }
+    return Point(c);
+  }
+
+  // Center of the bounding cube
+  Point center() const {
+    Point m = min_pt;
+    floatT c[3];
+    for (int d = 0; d < dim; d++) {
+      c[d] = m[d] + width / 2;
+    }
+    return Point(c);
+  }
+
+private:
+
+  void build(Point* p, long n) {
+    if (n == 0) {
+      width = 0.0;
+      return;
+    }
+    std::pair<Point, Point> id = std::make_pair(p[0], p[0]);
+    std::pair<Point, Point> borders = level1::reduce(p, p + n, id, [&] (std::pair<Point, Point> a, std::pair<Point, Point> b) {
+      return std::make_pair(a.first.min_coord(b.first), a.second.max_coord(b.second));
+    }, [&] (Point q) { return std::make_pair(q, q); });
+    min_pt = borders.first;
+    width = (borders.second - borders.first).max_dim();
+    double scale = (width > 0.0) ? (double) (1L << morton_bits) / width : 0.0;
+    uint64_t max_cell = (1UL << morton_bits) - 1;
+    parray<std::pair<long, int>> keyed(n, [&] (long i) {
+      uint64_t cell[3];
+      for (int d = 0; d < dim; d++) {
+        double c = (p[i][d] - min_pt[d]) * scale;
+        cell[d] = std::min((uint64_t) c, max_cell);
+      }
+      return std::make_pair((long) morton::code(cell, dim), (int) i);
+    });
+    intsort::integer_sort(keyed.begin(), (long*) NULL, n, 1L << MORTON_CODE_BITS, [&] (const std::pair<long, int>& k) {
+      return k.first;
+    });
+    codes = parray<long>(n, [&] (long i) {
+      return keyed[i].first;
+    });
+    ids = parray<int>(n, [&] (long i) {
+      return keyed[i].second;
+    });
+    x = parray<floatT>(n, [&] (long i) {
+      return p[keyed[i].second][0];
+    });
+    y = parray<floatT>(n, [&] (long i) {
+      return p[keyed[i].second][1];
+    });
+    if (dim == 3) {
+      z = parray<floatT>(n, [&] (long i) {
+        return p[keyed[i].second][2];
+      });
+    }
+  }
+
+};
+
+} // end namespace
+} // end namespace
+
+#endif /*! _PCTL_POINTCLOUD_H_ */
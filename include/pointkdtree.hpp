@@ -0,0 +1,465 @@
+/* COPYRIGHT (c) 2015 Umut Acar, Arthur Chargueraud, and Michael
+ * Rainey
+ * All rights reserved.
+ *
+ * \file pointkdtree.hpp
+ * \brief Parallel k-d tree over points, with k-nearest neighbor, radius
+ * and range queries
+ *
+ */
+
+#include <limits>
+#include <numeric>
+#include <algorithm>
+#include "datapar.hpp"
+#include "geometry.hpp"
+#include "selection.hpp"
+#include "distancekernel.hpp"
+
+#ifndef _PCTL_POINTKDTREE_H_
+#define _PCTL_POINTKDTREE_H_
+
+namespace pasl {
+namespace pctl {
+
+// A k-d tree split at the median of the widest dimension of the bounding
+// box of every node, so that the tree stays balanced on clustered inputs
+// where the cells of an octree get deep. The median is found by the
+// parallel selection of selection.hpp, and the two halves are built in
+// parallel. The tree is complete: node v has children 2v + 1 and 2v + 2,
+// all leaves are at the same depth and hold at most KDTREE_LEAF_SIZE
+// points, and node v at depth l holds the points [lo, hi) of the range of
+// its parent cut in the middle.
+//
+// The points are kept, in the order of the leaves, in one array per
+// coordinate, as in point_cloud; ids[i] is the index in the input of the
+// i-th point. The nodes keep the bounding box of their points, which is
+// tighter than the cell cut by the splits, for pruning. The queries come
+// in batches, answered in parallel, and return the indices in the input.
+//
+// The k-nearest neighbor searches take eps and max_leaves with the same
+// meaning as in nearest_neighbours_ds (see nearestneighbors.hpp), with
+// the nodes of the tree in place of its boxes.
+
+#define KDTREE_LEAF_SIZE 16
+// Size under which a subtree is built sequentially
+#define KDTREE_SEQ_SIZE 8192
+
+template <class Point>
+class point_kdtree {
+public:
+
+  using point = Point;
+  using floatT = typename Point::floatT;
+  static const int dim = Point::dim;
+
+  struct node {
+    floatT box_min[3];
+    floatT box_max[3];
+    long lo;
+    long hi;
+    int split_dim;
+  };
+
+  parray<floatT> x;
+  parray<floatT> y;
+  // empty in 2d
+  parray<floatT> z;
+  parray<int> ids;
+  parray<node> nodes;
+  int depth;
+
+  point_kdtree()
+  : depth(0) { }
+
+  point_kdtree(Point* p, long n) {
+    build(p, n);
+  }
+
+  point_kdtree(parray<Point>& p) {
+    build(p.begin(), p.size());
+  }
+
+  long size() const {
+    return ids.size();
+  }
+
+  bool is_leaf(long v) const {
+    return 2 * v + 1 >= (long) nodes.size();
+  }
+
+  /*---------------------------------------------------------------------*/
+  /* Queries */
+
+  // The k nearest neighbors of each of the m queries: result[i * k + j]
+  // is the index of the j-th nearest, or -1 if there are fewer than k
+  // points
+  template <int maxK>
+  parray<int> knn(Point* q, long m, int k, double eps = 0.0, long max_leaves = -1) const {
+    parray<int> result(m * k);
+    parallel_for(0L, m, [&] (long i) {
+      floatT c[3];
+      coordinates(q[i], c);
+      nearest<maxK>(c, -1, k, result.begin() + i * k, eps, max_leaves);
+    });
+    return result;
+  }
+
+  // The k nearest neighbors of every point of the tree other than itself,
+  // in the format of ANN: result[ids[i] * k + j]
+  template <int maxK>
+  parray<int> all_knn(int k, double eps = 0.0, long max_leaves = -1) const {
+    long n = size();
+    parray<int> result(n * k);
+    parallel_for(0L, n, [&] (long i) {
+      floatT c[3];
+      for (int d = 0; d < dim; d++) {
+        c[d] = coordinate(i, d);
+      }
+      nearest<maxK>(c, i, k, result.begin() + (long) ids[i] * k, eps, max_leaves);
+    });
+    return result;
+  }
+
+  // The points at distance at most r of each of the m queries, in no
+  // particular order: those of query i are result[offsets[i], offsets[i + 1])
+  parray<int> radius_search(Point* q, long m, floatT r, parray<long>& offsets) const {
+    return batch(m, offsets, ball_query(*this, q, r * r));
+  }
+
+  // The points in the box [lo[i], hi[i]] of each of the m queries, in no
+  // particular order: those of query i are result[offsets[i], offsets[i + 1])
+  parray<int> range_query(Point* lo, Point* hi, long m, parray<long>& offsets) const {
+    return batch(m, offsets, box_query(*this, lo, hi));
+  }
+
+  floatT coordinate(long i, int d) const {
+    return (d == 0) ? x[i] : ((d == 1) ? y[i] : z[i]);
+  }
+
+  // The coordinates of p, with 0 for z in 2d, as taken by search
+  static void coordinates(Point p, floatT* c) {
+    for (int d = 0; d < dim; d++) {
+      c[d] = p[d];
+    }
+    if (dim == 2) {
+      c[2] = 0;
+    }
+  }
+
+private:
+
+  /*---------------------------------------------------------------------*/
+  /* Construction */
+
+  void build(Point* p, long n) {
+    depth = 0;
+    while ((n >> depth) + ((n & ((1L << depth) - 1)) != 0) > KDTREE_LEAF_SIZE) {
+      depth++;
+    }
+    nodes = parray<node>((n == 0) ? 0L : (2L << depth) - 1);
+    parray<int> perm(n, [&] (long i) {
+      return (int) i;
+    });
+    if (n > 0) {
+      build(p, perm.begin(), 0, 0, n, 0);
+    }
+    ids = perm;
+    x = parray<floatT>(n, [&] (long i) {
+      return p[perm[i]][0];
+    });
+    y = parray<floatT>(n, [&] (long i) {
+      return p[perm[i]][1];
+    });
+    if (dim == 3) {
+      z = parray<floatT>(n, [&] (long i) {
+        return p[perm[i]][2];
+      });
+    }
+  }
+
+  void build(Point* p, int* perm, long v, long lo, long hi, int level) {
+    node& t = nodes[v];
+    t.lo = lo;
+    t.hi = hi;
+    std::pair<Point, Point> id = std::make_pair(p[perm[lo]], p[perm[lo]]);
+    auto combine = [&] (std::pair<Point, Point> a, std::pair<Point, Point> b) {
+      return std::make_pair(a.first.min_coord(b.first), a.second.max_coord(b.second));
+    };
+    auto lift = [&] (int i) {
+      return std::make_pair(p[i], p[i]);
+    };
+    std::pair<Point, Point> box = (hi - lo > KDTREE_SEQ_SIZE)
+      ? level1::reduce(perm + lo, perm + hi, id, combine, lift)
+      : std::accumulate(perm + lo, perm + hi, id, [&] (std::pair<Point, Point> a, int i) {
+          return combine(a, lift(i));
+        });
+    t.split_dim = 0;
+    for (int d = 0; d < dim; d++) {
+      t.box_min[d] = box.first[d];
+      t.box_max[d] = box.second[d];
+      if (t.box_max[d] - t.box_min[d] > t.box_max[t.split_dim] - t.box_min[t.split_dim]) {
+        t.split_dim = d;
+      }
+    }
+    if (level == depth) {
+      return;
+    }
+    int d = t.split_dim;
+    long mid = lo + (hi - lo) / 2;
+    auto less = [&] (int i, int j) {
+      return p[i][d] < p[j][d];
+    };
+    if (hi - lo > KDTREE_SEQ_SIZE) {
+      pasl::pctl::nth_element(perm + lo, (int) (hi - lo), (int) (mid - lo), less);
+      par::fork2([&] {
+        build(p, perm, 2 * v + 1, lo, mid, level + 1);
+      }, [&] {
+        build(p, perm, 2 * v + 2, mid, hi, level + 1);
+      });
+    } else {
+      std::nth_element(perm + lo, perm + mid, perm + hi, less);
+      build(p, perm, 2 * v + 1, lo, mid, level + 1);
+      build(p, perm, 2 * v + 2, mid, hi, level + 1);
+    }
+  }
+
+  /*---------------------------------------------------------------------*/
+  /* Searches */
+
+  // squared distance from c to the bounding box of node v
+  floatT box_distance(long v, const floatT* c) const {
+    const node& t = nodes[v];
+    floatT r = 0;
+    for (int d = 0; d < dim; d++) {
+      floatT e = std::max(t.box_min[d] - c[d], c[d] - t.box_max[d]);
+      if (e > 0) {
+        r += e * e;
+      }
+    }
+    return r;
+  }
+
+  // The k nearest neighbors of c other than the point self, nearest first,
+  // written to out
+  template <int maxK>
+  void nearest(const floatT* c, long self, int k, int* out, double eps, long max_leaves) const {
+    if (k > maxK) {
+      std::cout << "k too large in kNN" << std::endl;
+      abort();
+    }
+    floatT rn[maxK];
+    long pn[maxK];
+    for (int j = 0; j < k; j++) {
+      rn[j] = std::numeric_limits<floatT>::max();
+      pn[j] = -1;
+    }
+    search(c, k, rn, pn, [&] (long i) {
+      return i == self;
+    }, [&] (long i) {
+      return i;
+    }, eps, max_leaves);
+    for (int j = 0; j < k; j++) {
+      long i = pn[k - j - 1];
+      out[j] = (i < 0) ? -1 : ids[i];
+    }
+  }
+
+public:
+
+  // Updates the k best, rn and pn, sorted by decreasing distance as in
+  // knn_insert, with the points of the tree closer to c, leaving out the
+  // points i (in the order of the leaves) for which skip(i) holds. The
+  // point i enters pn as lift(i), so that the k best can be carried over
+  // several trees. The child closer to c is searched first.
+  template <class Skip, class Lift>
+  void search(const floatT* c, int k, floatT* rn, long* pn, const Skip& skip, const Lift& lift,
+              double eps = 0.0, long max_leaves = -1) const {
+    floatT box_scale = (floatT) ((1.0 + eps) * (1.0 + eps));
+    long leaves = max_leaves;
+    long stack[64];
+    int top = 0;
+    if (nodes.size() > 0) {
+      stack[top++] = 0;
+    }
+    while (top > 0 && ! (leaves == 0 && pn[0] >= 0)) {
+      long v = stack[--top];
+      if (box_distance(v, c) * box_scale >= rn[0]) {
+        continue;
+      }
+      if (is_leaf(v)) {
+        if (leaves > 0) {
+          leaves--;
+        }
+        floatT dist[KDTREE_LEAF_SIZE];
+        const node& t = nodes[v];
+        squared_distances<floatT, dim>::run(x.cbegin(), y.cbegin(), z.cbegin(), t.lo, t.hi, c, dist);
+        for (long i = t.lo; i < t.hi; i++) {
+          if (dist[i - t.lo] < rn[0] && !skip(i)) {
+            knn_insert(rn, pn, k, dist[i - t.lo], lift(i));
+          }
+        }
+      } else {
+        long a = 2 * v + 1;
+        long b = 2 * v + 2;
+        if (box_distance(a, c) > box_distance(b, c)) {
+          std::swap(a, b);
+        }
+        stack[top++] = b;
+        stack[top++] = a;
+      }
+    }
+  }
+
+private:
+
+  template <class Report>
+  void in_ball(long v, const floatT* c, floatT r2, const Report& report) const {
+    if (box_distance(v, c) > r2) {
+      return;
+    }
+    const node& t = nodes[v];
+    if (is_leaf(v)) {
+      floatT dist[KDTREE_LEAF_SIZE];
+      squared_distances<floatT, dim>::run(x.cbegin(), y.cbegin(), z.cbegin(), t.lo, t.hi, c, dist);
+      for (long i = t.lo; i < t.hi; i++) {
+        if (dist[i - t.lo] <= r2) {
+          report(i, i + 1);
+        }
+      }
+    } else {
+      in_ball(2 * v + 1, c, r2, report);
+      in_ball(2 * v + 2, c, r2, report);
+    }
+  }
+
+  template <class Report>
+  void in_box(long v, const floatT* a, const floatT* b, const Report& report) const {
+    const node& t = nodes[v];
+    bool inside = true;
+    for (int d = 0; d < dim; d++) {
+      if (t.box_max[d] < a[d] || t.box_min[d] > b[d]) {
+        return;
+      }
+      inside = inside && a[d] <= t.box_min[d] && t.box_max[d] <= b[d];
+    }
+    if (inside) {
+      report(t.lo, t.hi);
+    } else if (is_leaf(v)) {
+      for (long i = t.lo; i < t.hi; i++) {
+        bool in = true;
+        for (int d = 0; d < dim; d++) {
+          floatT e = coordinate(i, d);
+          in = in && a[d] <= e && e <= b[d];
+        }
+        if (in) {
+          report(i, i + 1);
+        }
+      }
+    } else {
+      in_box(2 * v + 1, a, b, report);
+      in_box(2 * v + 2, a, b, report);
+    }
+  }
+
+  // The searches of a batch: query(i, report) calls report(s, e) for the
+  // ranges [s, e) of the points found by query i
+  struct ball_query {
+    const point_kdtree& tree;
+    Point* q;
+    floatT r2;
+
+    ball_query(const point_kdtree& tree, Point* q, floatT r2)
+    : tree(tree), q(q), r2(r2) { }
+
+    template <class Report>
+    void operator()(long i, const Report& report) const {
+      floatT c[3];
+      coordinates(q[i], c);
+      tree.in_ball(0, c, r2, report);
+    }
+  };
+
+  struct box_query {
+    const point_kdtree& tree;
+    Point* lo;
+    Point* hi;
+
+    box_query(const point_kdtree& tree, Point* lo, Point* hi)
+    : tree(tree), lo(lo), hi(hi) { }
+
+    template <class Report>
+    void operator()(long i, const Report& report) const {
+      floatT a[3];
+      floatT b[3];
+      coordinates(lo[i], a);
+      coordinates(hi[i], b);
+      tree.in_box(0, a, b, report);
+    }
+  };
+
+  struct count_report {
+    long& count;
+
+    count_report(long& count)
+    : count(count) { }
+
+    void operator()(long s, long e) const {
+      count += e - s;
+    }
+  };
+
+  struct write_report {
+    const int* ids;
+    mutable int* out;
+
+    write_report(const int* ids, int* out)
+    : ids(ids), out(out) { }
+
+    void operator()(long s, long e) const {
+      for (long l = s; l < e; l++) {
+        *out++ = ids[l];
+      }
+    }
+  };
+
+  // Runs every query twice, to count its points and then to write them at
+  // the offset given by a scan of the counts
+  template <class Query>
+  parray<int> batch(long m, parray<long>& offsets, const Query& query) const {
+    offsets = parray<long>(m + 1, 0L);
+    if (nodes.size() == 0) {
+      return parray<int>(0);
+    }
+    parallel_for(0L, m, [&] (long i) {
+      long c = 0;
+      query(i, count_report(c));
+      offsets[i] = c;
+    });
+    long total = dps::scan(offsets.begin(), offsets.end(), 0L, [&] (long a, long b) {
+      return a + b;
+    }, offsets.begin(), forward_exclusive_scan);
+    parray<int> result(total);
+    parallel_for(0L, m, [&] (long i) {
+      query(i, write_report(ids.cbegin(), result.begin() + offsets[i]));
+    });
+    return result;
+  }
+
+};
+
+// find the k nearest neighbors of all points with a k-d tree, in the
+// format of ANN (approximate ones with eps > 0 or max_leaves >= 0)
+template <class intT, int maxK, class Point>
+parray<intT> kdtree_ANN(parray<Point>& points, int n, int k, double eps = 0.0, long max_leaves = -1) {
+  point_kdtree<Point> tree(points.begin(), n);
+  parray<int> result = tree.template all_knn<maxK>(k, eps, max_leaves);
+  return parray<intT>(result.size(), [&] (long i) {
+    return (intT) result[i];
+  });
+}
+
+} // end namespace
+} // end namespace
+
+#endif /*! _PCTL_POINTKDTREE_H_ */
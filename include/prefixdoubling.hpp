@@ -0,0 +1,219 @@
+/* COPYRIGHT (c) 2015 Umut Acar, Arthur Chargueraud, and Michael
+ * Rainey
+ * All rights reserved.
+ *
+ * \file prefixdoubling.hpp
+ * \brief Parallel prefix-doubling suffix array
+ *
+ */
+
+#include <algorithm>
+#include <type_traits>
+#include <utility>
+#include "datapar.hpp"
+#include "utils.hpp"
+#include "blockradixsort.hpp"
+#include "rangemin.hpp"
+#include "uint40.hpp"
+
+#ifndef _PBBS_PCTL_PREFIXDOUBLING_H_
+#define _PBBS_PCTL_PREFIXDOUBLING_H_
+
+namespace pasl {
+namespace pctl {
+
+// Suffix array by prefix doubling, in the style of
+//   N. Jesper Larsson and Kunihiko Sadakane
+//   Faster suffix sorting
+//   Theoretical Computer Science 387(3), 2007
+// The suffixes are first sorted by as many characters as fit in a 64-bit
+// key. Suffixes that share their first h characters form a group, whose
+// rank is the position of its first suffix in the suffix array. Each round
+// then sorts every group of more than one suffix by the rank of the suffix
+// h positions further, which orders it by the first 2h characters, and
+// doubles h. Only unresolved groups are touched, so the work of a round is
+// proportional to the number of suffixes that are not yet placed.
+//
+// Compared to DC3 (suffix_array_rec) there is no recursion and no
+// reduced string. Besides the text, the working set is one 64-bit key per
+// suffix and the buffer of the radix sort for the first sort, then the
+// suffix array, the ranks, and per unresolved suffix a head flag and an
+// index: the groups are sorted in place in the suffix array, by a key read
+// from the ranks. With int indices this peaks at 18 to 20 bytes per
+// character, against about 40 for DC3. The price is on highly periodic
+// texts, where groups stay large for log n rounds.
+
+// Groups smaller than this are sorted sequentially
+#define SA_DOUBLING_SEQ_THR 16384
+
+// The engine is parameterized by the type Index of the suffix array and of
+// the ranks: int, long, or uint40 for inputs of more than 2^31 characters
+// that should cost 5 bytes per index rather than 8. Computations are done
+// in index_arithmetic<Index>::type.
+
+template <class CharT>
+intT sa_doubling_code(CharT c) {
+  return (intT) (typename std::make_unsigned<CharT>::type) c + 1;
+}
+
+// Sorts in place, by key, the suffixes of a group
+template <class Index, class Key>
+void sa_doubling_sort_group(Index* suffixes, long len, long max_key, const Key& key) {
+  using idx = typename index_arithmetic<Index>::type;
+  if (len > SA_DOUBLING_SEQ_THR) {
+    intsort::integer_sort(suffixes, (idx) len, (idx) max_key, [&] (Index i) {
+      return key(i);
+    });
+  } else {
+    std::sort(suffixes, suffixes + len, [&] (Index i, Index j) {
+      return key(i) < key(j);
+    });
+  }
+}
+
+// Takes the groups of a round, given as (position, length) pairs and now
+// sorted in SA, and heads, which tells which of their suffixes start a new
+// group, with group g at offsets[g]. Sets the ranks of the suffixes and
+// returns the new groups of more than one suffix.
+template <class Index>
+parray<std::pair<Index, Index>> sa_doubling_split(Index* SA, Index* rank, const parray<std::pair<Index, Index>>& groups,
+                                                  const parray<typename index_arithmetic<Index>::type>& offsets,
+                                                  const parray<bool>& heads) {
+  using idx = typename index_arithmetic<Index>::type;
+  idx total = (idx) heads.size();
+  idx nb_groups = (idx) groups.size();
+  auto complexity_fct = [&] (idx lo, idx hi) {
+    return offsets[hi] - offsets[lo];
+  };
+  // the groups of a round are in increasing order of position, so the
+  // running maximum of the heads is the start of the current group
+  parray<Index> head;
+  head.prefix_tabulate(total, 0);
+  range::parallel_for((idx) 0, nb_groups, complexity_fct, [&] (idx g) {
+    idx l = groups[g].first;
+    idx o = offsets[g];
+    parallel_for((idx) 0, (idx) groups[g].second, [&] (idx t) {
+      head[o + t] = heads[o + t] ? (Index) (l + t) : (Index) 0;
+    });
+  });
+  dps::scan(head.begin(), head.end(), (Index) 0, [&] (idx x, idx y) {
+    return (Index) std::max(x, y);
+  }, head.begin(), forward_inclusive_scan);
+  range::parallel_for((idx) 0, nb_groups, complexity_fct, [&] (idx g) {
+    idx l = groups[g].first;
+    idx o = offsets[g];
+    parallel_for((idx) 0, (idx) groups[g].second, [&] (idx t) {
+      rank[(idx) SA[l + t]] = head[o + t];
+    });
+  });
+  parray<bool> unresolved(total, [&] (idx x) {
+    return heads[x] && x + 1 < total && ! heads[x + 1];
+  });
+  parray<long> starts = pack_index(unresolved.cbegin(), unresolved.cend());
+  unresolved.clear();
+  parray<std::pair<Index, Index>> result(starts.size(), [&] (long g) {
+    return std::make_pair(head[starts[g]], (Index) 0);
+  });
+  // the lengths, from the index of the next head
+  parallel_for((idx) 0, total, [&] (idx x) {
+    head[x] = heads[x] ? x : total;
+  });
+  dps::scan(head.begin(), head.end(), (Index) total, [&] (idx x, idx y) {
+    return (Index) std::min(x, y);
+  }, head.begin(), backward_inclusive_scan);
+  parallel_for(0L, (long) starts.size(), [&] (long g) {
+    idx x = (idx) starts[g];
+    result[g].second = ((x + 1 < total) ? (idx) head[x + 1] : total) - x;
+  });
+  return result;
+}
+
+template <class CharT, class Index = intT>
+parray<Index> suffix_array_doubling(CharT* s, long n) {
+  using idx = typename index_arithmetic<Index>::type;
+  parray<Index> SA;
+  if (n == 0) {
+    return SA;
+  }
+  intT max_code = level1::reduce(s, s + n, 0, [&] (intT x, intT y) {
+    return std::max(x, y);
+  }, [&] (CharT c) {
+    return sa_doubling_code(c);
+  });
+  int bits = utils::log2Up(max_code + 1);
+  // a key packs the first c characters of a suffix above its index
+  int index_bits = std::max(1, utils::log2Up(n));
+  int c = std::max(1, (64 - index_bits) / bits);
+  int key_bits = c * bits;
+  unsigned long index_mask = (1UL << index_bits) - 1;
+
+  // sort by the first c characters, with stable passes of a radix sort
+  // over the digits of the packed characters, least significant first
+  parray<unsigned long> initial(n, [&] (long i) {
+    unsigned long key = 0;
+    for (int t = 0; t < c; t++) {
+      unsigned long code = (i + t < n) ? (unsigned long) sa_doubling_code(s[i + t]) : 0UL;
+      key = (key << bits) | code;
+    }
+    return (key << index_bits) | (unsigned long) i;
+  });
+  int rounds = (key_bits + 29) / 30;
+  int digit_bits = (key_bits + rounds - 1) / rounds;
+  for (int shift = index_bits; shift < index_bits + key_bits; shift += digit_bits) {
+    intsort::integer_sort_bottom_up(initial.begin(), (idx) n, (idx) 1 << digit_bits, [&] (unsigned long x) {
+      return (idx) ((x >> shift) & ((1UL << digit_bits) - 1));
+    });
+  }
+  SA = parray<Index>(n, [&] (long j) {
+    return (Index) (idx) (initial[j] & index_mask);
+  });
+  parray<std::pair<Index, Index>> groups(1, std::make_pair((Index) 0, (Index) (idx) n));
+  parray<Index> rank;
+  rank.prefix_tabulate(n, 0);
+  {
+    parray<idx> offsets(2, [&] (long g) {
+      return (idx) (g * n);
+    });
+    parray<bool> heads(n, [&] (long j) {
+      return j == 0 || (initial[j] >> index_bits) != (initial[j - 1] >> index_bits);
+    });
+    initial.clear();
+    groups = sa_doubling_split(SA.begin(), rank.begin(), groups, offsets, heads);
+  }
+
+  for (long h = c; groups.size() > 0; h *= 2) {
+    idx nb_groups = (idx) groups.size();
+    parray<idx> offsets(nb_groups + 1, [&] (idx g) {
+      return (g == nb_groups) ? (idx) 0 : (idx) groups[g].second;
+    });
+    idx total = dps::scan(offsets.begin(), offsets.end(), (idx) 0, [&] (idx x, idx y) {
+      return x + y;
+    }, offsets.begin(), forward_exclusive_scan);
+    auto complexity_fct = [&] (idx lo, idx hi) {
+      return offsets[hi] - offsets[lo];
+    };
+    // sort each group, in place in SA, by the rank h characters further;
+    // all the ranks are read before any of them is updated
+    auto key = [&] (Index i) {
+      return ((idx) i + h < n) ? (idx) rank[(idx) i + h] + 1 : (idx) 0;
+    };
+    parray<bool> heads;
+    heads.prefix_tabulate(total, 0);
+    range::parallel_for((idx) 0, nb_groups, complexity_fct, [&] (idx g) {
+      idx l = groups[g].first;
+      idx len = groups[g].second;
+      idx o = offsets[g];
+      sa_doubling_sort_group(SA.begin() + l, len, n + 1, key);
+      parallel_for((idx) 0, len, [&] (idx t) {
+        heads[o + t] = t == 0 || key(SA[l + t]) != key(SA[l + t - 1]);
+      });
+    });
+    groups = sa_doubling_split(SA.begin(), rank.begin(), groups, offsets, heads);
+  }
+  return SA;
+}
+
+} // end namespace
+} // end namespace
+
+#endif /*! _PBBS_PCTL_PREFIXDOUBLING_H_ */
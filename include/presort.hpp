@@ -0,0 +1,155 @@
+/* COPYRIGHT (c) 2015 Umut Acar, Arthur Chargueraud, and Michael
+ * Rainey
+ * All rights reserved.
+ *
+ * \file presort.hpp
+ * \brief Presortedness detection and natural merge sort
+ *
+ */
+
+#include <algorithm>
+#include "datapar.hpp"
+#include "psort.hpp"
+
+#ifndef _PBBS_PCTL_PRESORT_H_
+#define _PBBS_PCTL_PRESORT_H_
+
+namespace pasl {
+namespace pctl {
+
+// Inputs shorter than this are not checked by the comparison sorts
+#define PRESORT_THR 100000
+// The run-merging path is taken when runs are at least this long on average
+#define PRESORT_MIN_AVG_RUN 256
+
+enum presortedness_type {
+  presorted_random,
+  presorted_sorted,
+  presorted_reverse_sorted,
+  presorted_few_runs
+};
+
+static const char* presortedness_names[] = {
+  "random", "sorted", "reverse_sorted", "few_runs"
+};
+
+struct presortedness {
+  presortedness_type type;
+  long nb_runs; // number of maximal non-decreasing runs
+
+  const char* name() const {
+    return presortedness_names[type];
+  }
+};
+
+// Counts, in one parallel pass, the descents (a[i] < a[i - 1]) and the
+// ascents (a[i - 1] < a[i]) of a[0, n) to classify the input.
+template <class E, class BinPred, class intT>
+presortedness detect_presortedness(E* a, intT n, BinPred compare) {
+  presortedness result;
+  if (n <= 1) {
+    result.type = presorted_sorted;
+    result.nb_runs = n;
+    return result;
+  }
+  auto id = std::make_pair(0L, 0L);
+  auto counts = level1::reducei(a + 1, a + n, id, [&] (std::pair<long, long> x, std::pair<long, long> y) {
+    return std::make_pair(x.first + y.first, x.second + y.second);
+  }, [&] (long i, const E& x) {
+    const E& prev = a[i];
+    return std::make_pair(compare(x, prev) ? 1L : 0L, compare(prev, x) ? 1L : 0L);
+  });
+  long descents = counts.first;
+  long ascents = counts.second;
+  result.nb_runs = descents + 1;
+  if (descents == 0) {
+    result.type = presorted_sorted;
+  } else if (ascents == 0) {
+    result.type = presorted_reverse_sorted;
+  } else if (result.nb_runs * PRESORT_MIN_AVG_RUN <= (long) n) {
+    result.type = presorted_few_runs;
+  } else {
+    result.type = presorted_random;
+  }
+  return result;
+}
+
+// Merges the sorted runs src[starts[i], starts[i + 1]), for i < nb_runs, of
+// src[0, n) pairwise, in parallel, until one run is left. tmp provides n
+// cells of scratch space; the result ends up in src or in tmp and the
+// function returns which. starts holds nb_runs + 1 entries, the last being
+// n, and is consumed.
+template <class E, class BinPred>
+E* merge_sorted_runs(E* src, E* tmp, parray<long>& starts, BinPred compare) {
+  long nb_runs = starts.size() - 1;
+  E* dst = tmp;
+  while (nb_runs > 1) {
+    long nb_pairs = (nb_runs + 1) / 2;
+    auto complexity_fct = [&] (long lo, long hi) {
+      return starts[std::min(2 * hi, nb_runs)] - starts[2 * lo];
+    };
+    range::parallel_for(0L, nb_pairs, complexity_fct, [&] (long j) {
+      long lo = starts[2 * j];
+      long mid = starts[std::min(2 * j + 1, nb_runs)];
+      long hi = starts[std::min(2 * j + 2, nb_runs)];
+      if (mid == hi) {
+        pmem::copy(src + lo, src + hi, dst + lo);
+      } else {
+        merge(src + lo, src + mid, src + mid, src + hi, dst + lo, compare);
+      }
+    });
+    parray<long> next_starts(nb_pairs + 1, [&] (long j) {
+      return starts[std::min(2 * j, nb_runs)];
+    });
+    starts.swap(next_starts);
+    nb_runs = nb_pairs;
+    std::swap(src, dst);
+  }
+  return src;
+}
+
+// Natural merge sort: finds the maximal non-decreasing runs of a[0, n) and
+// merges neighbouring runs pairwise, in parallel, until one run is left.
+template <class E, class BinPred, class intT>
+void natural_merge_sort(E* a, intT n, BinPred compare) {
+  if (n <= 1) {
+    return;
+  }
+  parray<bool> is_run_start(n, [&] (intT i) {
+    return i == 0 || compare(a[i], a[i - 1]);
+  });
+  parray<long> starts = pack_index(is_run_start.cbegin(), is_run_start.cend());
+  is_run_start.clear();
+  starts.resize(starts.size() + 1, (long) n);
+  parray<E> tmp;
+  tmp.prefix_tabulate(n, 0);
+  E* result = merge_sorted_runs(a, tmp.begin(), starts, compare);
+  if (result != a) {
+    pmem::copy(result, result + n, a);
+  }
+}
+
+// Sorts a[0, n) and returns true when the input is sorted, reverse sorted
+// or made of few long runs; otherwise leaves a untouched and returns false,
+// in which case the caller should run its general algorithm.
+template <class E, class BinPred, class intT>
+bool sort_if_presorted(E* a, intT n, BinPred compare) {
+  presortedness p = detect_presortedness(a, n, compare);
+  if (p.type == presorted_sorted) {
+    return true;
+  } else if (p.type == presorted_reverse_sorted) {
+    parallel_for((intT) 0, n / 2, [&] (intT i) {
+      std::swap(a[i], a[n - 1 - i]);
+    });
+    return true;
+  } else if (p.type == presorted_few_runs) {
+    natural_merge_sort(a, n, compare);
+    return true;
+  }
+  return false;
+}
+
+} // end namespace
+} // end namespace
+
+#endif /*! _PBBS_PCTL_PRESORT_H_ */
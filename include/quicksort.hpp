@@ -24,6 +24,9 @@
 #define _PBBS_PCTL_QSORT_H_
 #include <algorithm>
 #include "datapar.hpp"
+#include "utils.hpp"
+#include "presort.hpp"
+#include "sortingnetwork.hpp"
 
 namespace pasl {
 namespace pctl {
@@ -62,17 +65,82 @@ E median(E a, E b, E c, BinPred f) {
   : (f(a,c) ? a : (f(b,c) ? c : b));
 }
 
+// Moves the elements of A[0, n) that satisfy pred to the front, without
+// branching on pred, and returns their number. Meant for small element types
+// on which mispredicted branches, not moves, dominate the cost.
+template <class E, class Pred, class intT>
+intT quick_sort_branchless_partition(E* A, intT n, const Pred& pred) {
+  intT l = 0;
+  for (intT r = 0; r < n; r++) {
+    E x = A[r];
+    bool c = pred(x);
+    A[r] = A[l];
+    A[l] = x;
+    l += c;
+  }
+  return l;
+}
+
+// Sequential sort used at the leaves of the parallel sorts. For the element
+// types and comparators handled by sortingnetwork.hpp, it is a quicksort
+// that stops at blocks of sorting_network_leaf_size() elements and sorts them
+// with the vectorized network, falling back to std::sort when the recursion
+// gets too deep; otherwise it is std::sort.
+template <class E, class BinPred, class intT>
+void seq_sort(E* A, intT n, BinPred f) {
+  intT leaf = std::min((intT) sorting_network_leaf_size(), (intT) SORTNET_MAX);
+  if (! sorting_network_enabled<E, BinPred>::value || leaf <= 1) {
+    std::sort(A, A + n, f);
+    return;
+  }
+  int depth = 2 * utils::log2Up(n + 1);
+  while (n > leaf) {
+    if (depth-- == 0) {
+      std::sort(A, A + n, f);
+      return;
+    }
+    // branchless partition: A[0, nl) is less than the pivot and A[nl, n)
+    // not less. When nothing is less than the pivot, which is then the
+    // minimum, the elements equal to it are split off instead.
+    E p = median(A[n/4],A[n/2],A[(3*n)/4],f);
+    intT nl = quick_sort_branchless_partition(A, n, [&] (const E& x) {
+      return f(x, p);
+    });
+    if (nl == 0) {
+      intT ne = quick_sort_branchless_partition(A, n, [&] (const E& x) {
+        return ! f(p, x);
+      });
+      A += ne;
+      n -= ne;
+      continue;
+    }
+    intT nr = n - nl;
+    // recurse on the smaller side, loop on the larger one
+    if (nl < nr) {
+      seq_sort(A, nl, f);
+      A += nl;
+      n = nr;
+    } else {
+      seq_sort(A + nl, nr, f);
+      n = nl;
+    }
+  }
+  sorting_network_sort(A, n, f);
+}
+
 constexpr char quicksort_file[] = "quicksort";
 
 // Quicksort based on median of three elements as pivot
-//  and uses insertionSort for small inputs
+//  and uses seq_sort (or insertionSort, under manual control) for small inputs
 template <class E, class BinPred, class intT>
-void quick_sort(E* A, intT n, BinPred f) {
+void quick_sort_rec(E* A, intT n, BinPred f) {
   
   par::cstmt<quicksort_file, E, BinPred, intT>([&] { return n * log(n); }, [&] {
 #ifdef MANUAL_CONTROL
     if (n < ISORT) {
-      insertion_sort(A, n, f);
+      if (n > sorting_network_leaf_size() || ! sorting_network_sort(A, n, f)) {
+        insertion_sort(A, n, f);
+      }
       return;
     }
 #endif
@@ -97,14 +165,24 @@ void quick_sort(E* A, intT n, BinPred f) {
       M++;
     }
     par::fork2([&] {
-      quick_sort(A, L-A, f);
+      quick_sort_rec(A, L-A, f);
     }, [&] {
-      quick_sort(M, A+n-M, f); // Exclude all elts that equal pivot
+      quick_sort_rec(M, A+n-M, f); // Exclude all elts that equal pivot
     });
   }, [&] {
-    std::sort(A, A + n, f);
+    seq_sort(A, n, f);
   });
 }
+
+// Large inputs that are already sorted, reverse sorted or made of few
+// runs are handled by the presortedness pass instead
+template <class E, class BinPred, class intT>
+void quick_sort(E* A, intT n, BinPred f) {
+  if (n > PRESORT_THR && sort_if_presorted(A, n, f)) {
+    return;
+  }
+  quick_sort_rec(A, n, f);
+}
   
 } // end namespace
 } // end namespace
@@ -26,6 +26,9 @@
 
 #include <iostream>
 #include <math.h>
+#include <stdint.h>
+#include <utility>
+#include "uint40.hpp"
 //#include "merge.hpp"
 #define BSIZE 16
 
@@ -36,8 +39,12 @@ using intT = int;
     
 using namespace std;
 
-class myRMQ{
+// Sparse table over the minima of blocks of BSIZE items. Index is the type
+// of positions: int, or long for arrays of more than 2^31 items.
+template <class Index>
+class basic_myRMQ{
 protected:
+  using intT = Index;
   intT* a;
   intT n;
   intT m;
@@ -45,20 +52,25 @@ protected:
   intT depth;
   
 public:
-  myRMQ(intT* _A, intT _n);
+  basic_myRMQ(intT* _A, intT _n);
   void precomputeQueries();
   intT query(intT,intT);
-  ~myRMQ();
+  long size_in_bytes() const { return (long) depth * n * sizeof(intT); }
+  ~basic_myRMQ();
 };
 
-myRMQ::myRMQ(intT* _a, intT _n){
+using myRMQ = basic_myRMQ<intT>;
+
+template <class Index>
+basic_myRMQ<Index>::basic_myRMQ(intT* _a, intT _n){
   a = _a;
   n = _n;
   m = 1 + (n-1)/BSIZE;
   precomputeQueries();
 }
 
-void myRMQ::precomputeQueries(){
+template <class Index>
+void basic_myRMQ<Index>::precomputeQueries(){
   depth = log2(m) + 1;
   table = new intT*[depth];
   parallel_for((intT)0, depth, [&] (intT k) {
@@ -88,7 +100,8 @@ void myRMQ::precomputeQueries(){
   
 }
 
-intT myRMQ::query(intT i, intT j){
+template <class Index>
+Index basic_myRMQ<Index>::query(intT i, intT j){
   //same block
   if (j-i < BSIZE) {
     intT r = i;
@@ -115,7 +128,7 @@ intT myRMQ::query(intT i, intT j){
     else if(block_j == block_i + 1) outOfBlockMin = table[1][block_i];
     else {
       intT k = log2(block_j - block_i);
-      intT p = 1<<k; //2^k
+      intT p = (intT)1<<k; //2^k
       outOfBlockMin = a[table[k][block_i]] <= a[table[k][block_j+1-p]]
       ? table[k][block_i] : table[k][block_j+1-p];
     }
@@ -125,7 +138,8 @@ intT myRMQ::query(intT i, intT j){
   
 }
 
-myRMQ::~myRMQ(){
+template <class Index>
+basic_myRMQ<Index>::~basic_myRMQ(){
   
   parallel_for((intT)0, depth, [&] (intT i) {
     delete[] table[i];
@@ -133,6 +147,222 @@ myRMQ::~myRMQ(){
   delete[] table;
 }
   
+// Range minimum in O(n) bits and O(1) time, on three levels:
+//  - blocks of RMQ_BLOCK items: for each item i, a mask of the items of
+//    its block up to i that are not greater than any item after them up to
+//    i (the stack of the Cartesian tree of the prefix), so that the lowest
+//    bit of the mask of j at or above i gives the minimum of [i, j];
+//  - superblocks of RMQ_SUPERBLOCK items: for each block, the offsets in
+//    its superblock of the minima of the spans of 2, 4, ..., 32 blocks
+//    starting at it, and of the spans from the start of the superblock to
+//    it and from it to the end of the superblock, two bytes each;
+//  - a sparse table over the minima of the superblocks, which keeps their
+//    values next to their positions.
+// A query spanning several superblocks then reads one entry of each level
+// on each side and two of the sparse table, about as many cache lines as
+// myRMQ. With 8 and 512, it takes about 24 bits per item, against
+// 32 * log2(n / BSIZE) for the sparse table of myRMQ. query returns the
+// leftmost minimum.
+//
+// Index is the type of the items and of the positions: int, long, or
+// uint40 for arrays of more than 2^31 items; computations are done in
+// index_arithmetic<Index>::type.
+#define RMQ_BLOCK 8
+#define RMQ_SUPERBLOCK 512
+// log2(RMQ_SUPERBLOCK / RMQ_BLOCK) - 1
+#define RMQ_BLOCK_LEVELS 5
+
+template <class Index>
+class basic_compact_rmq {
+public:
+  using intT = typename index_arithmetic<Index>::type;
+
+protected:
+  enum { blocks_per_superblock = RMQ_SUPERBLOCK / RMQ_BLOCK };
+  const Index* a;
+  intT n;
+  intT nb_blocks;
+  intT nb_superblocks;
+  int depth;
+  uint8_t* masks;
+  uint16_t* block_table;
+  uint16_t* prefix_table;
+  uint16_t* suffix_table;
+  // (value, position) of the minimum of 2^t superblocks, level t after
+  // level t - 1
+  std::pair<Index, Index>* superblock_table;
+
+  static int log2_floor(intT x) {
+    return 63 - __builtin_clzl((unsigned long) x);
+  }
+
+  // minimum of i and j, where i < j
+  intT min_of(intT i, intT j) const {
+    return (a[j] < a[i]) ? j : i;
+  }
+
+  static std::pair<Index, Index> min_of(const std::pair<Index, Index>& x, const std::pair<Index, Index>& y) {
+    return ((intT) y.first < (intT) x.first) ? y : x;
+  }
+
+  // [i, j] within one block
+  intT in_block(intT i, intT j) const {
+    intT start = i - i % RMQ_BLOCK;
+    unsigned m = (unsigned) masks[j] >> (i - start);
+    return i + __builtin_ctz(m);
+  }
+
+  intT block_min(intT k) const {
+    intT start = k * RMQ_BLOCK;
+    return in_block(start, std::min(n - 1, start + RMQ_BLOCK - 1));
+  }
+
+  intT superblock_start(intT k) const {
+    return (k - k % blocks_per_superblock) * RMQ_BLOCK;
+  }
+
+  // blocks [k, l] within one superblock
+  intT blocks_min(intT k, intT l) const {
+    if (k == l) {
+      return block_min(k);
+    }
+    int t = std::min(RMQ_BLOCK_LEVELS, log2_floor(l - k + 1));
+    intT base = superblock_start(k);
+    intT x = base + block_table[k * RMQ_BLOCK_LEVELS + t - 1];
+    intT y = base + block_table[(l - ((intT) 1 << t) + 1) * RMQ_BLOCK_LEVELS + t - 1];
+    return min_of(x, y);
+  }
+
+  // superblocks [s, u]
+  std::pair<Index, Index> superblocks_min(intT s, intT u) const {
+    int t = log2_floor(u - s + 1);
+    std::pair<Index, Index>* level = superblock_table + (long) t * nb_superblocks;
+    return min_of(level[s], level[u - ((intT) 1 << t) + 1]);
+  }
+
+  void build() {
+    parallel_for((intT)0, nb_blocks, [&] (intT k) {
+      intT start = k * RMQ_BLOCK;
+      intT end = std::min(n, start + RMQ_BLOCK);
+      unsigned m = 0;
+      for (intT i = start; i < end; i++) {
+        while (m != 0 && a[start + 31 - __builtin_clz(m)] > a[i]) {
+          m &= ~(1u << (31 - __builtin_clz(m)));
+        }
+        m |= 1u << (i - start);
+        masks[i] = (uint8_t) m;
+      }
+    });
+    parallel_for((intT)0, nb_superblocks, [&] (intT s) {
+      intT first = s * blocks_per_superblock;
+      intT nb = std::min(nb_blocks - first, (intT) blocks_per_superblock);
+      intT base = first * RMQ_BLOCK;
+      intT best[blocks_per_superblock];
+      for (intT k = 0; k < nb; k++) {
+        best[k] = block_min(first + k);
+      }
+      intT r = best[0];
+      for (intT k = 0; k < nb; k++) {
+        r = min_of(r, best[k]);
+        prefix_table[first + k] = (uint16_t) (r - base);
+      }
+      superblock_table[s] = std::make_pair(a[r], (Index) r);
+      r = best[nb - 1];
+      for (intT k = nb - 1; k >= 0; k--) {
+        r = (k == nb - 1) ? r : min_of(best[k], r);
+        suffix_table[first + k] = (uint16_t) (r - base);
+      }
+      for (int t = 1; t <= RMQ_BLOCK_LEVELS; t++) {
+        intT half = (intT) 1 << (t - 1);
+        for (intT k = 0; k < nb; k++) {
+          intT x = best[k];
+          intT y = (k + half < nb) ? best[k + half] : x;
+          intT z = min_of(x, y);
+          best[k] = z;
+          block_table[(first + k) * RMQ_BLOCK_LEVELS + t - 1] = (uint16_t) (z - base);
+        }
+      }
+    });
+    for (int t = 1; t < depth; t++) {
+      intT half = (intT) 1 << (t - 1);
+      std::pair<Index, Index>* prev = superblock_table + (long) (t - 1) * nb_superblocks;
+      std::pair<Index, Index>* cur = superblock_table + (long) t * nb_superblocks;
+      parallel_for((intT)0, nb_superblocks, [&] (intT s) {
+        cur[s] = (s + half < nb_superblocks) ? min_of(prev[s], prev[s + half]) : prev[s];
+      });
+    }
+  }
+
+public:
+
+  basic_compact_rmq(const Index* _a, intT _n)
+  : a(_a), n(_n) {
+    nb_blocks = (n + RMQ_BLOCK - 1) / RMQ_BLOCK;
+    nb_superblocks = (n + RMQ_SUPERBLOCK - 1) / RMQ_SUPERBLOCK;
+    depth = (nb_superblocks > 0) ? log2_floor(nb_superblocks) + 1 : 0;
+    masks = new uint8_t[n];
+    block_table = new uint16_t[(long) nb_blocks * RMQ_BLOCK_LEVELS];
+    prefix_table = new uint16_t[nb_blocks];
+    suffix_table = new uint16_t[nb_blocks];
+    superblock_table = new std::pair<Index, Index>[(long) depth * nb_superblocks];
+    build();
+  }
+
+  basic_compact_rmq(const basic_compact_rmq&) = delete;
+  basic_compact_rmq& operator=(const basic_compact_rmq&) = delete;
+
+  ~basic_compact_rmq() {
+    delete[] masks;
+    delete[] block_table;
+    delete[] prefix_table;
+    delete[] suffix_table;
+    delete[] superblock_table;
+  }
+
+  // Position of the leftmost minimum of a[i, j], for i <= j
+  intT query(intT i, intT j) const {
+    intT bi = i / RMQ_BLOCK;
+    intT bj = j / RMQ_BLOCK;
+    if (bi == bj) {
+      return in_block(i, j);
+    }
+    intT r = in_block(i, bi * RMQ_BLOCK + RMQ_BLOCK - 1);
+    if (bj > bi + 1) {
+      intT si = (bi + 1) / blocks_per_superblock;
+      intT sj = (bj - 1) / blocks_per_superblock;
+      if (si == sj) {
+        r = min_of(r, blocks_min(bi + 1, bj - 1));
+      } else {
+        r = min_of(r, superblock_start(bi + 1) + suffix_table[bi + 1]);
+        if (sj > si + 1) {
+          std::pair<Index, Index> m = superblocks_min(si + 1, sj - 1);
+          if ((intT) m.first < (intT) a[r]) {
+            r = m.second;
+          }
+        }
+        r = min_of(r, superblock_start(bj - 1) + prefix_table[bj - 1]);
+      }
+    }
+    return min_of(r, in_block(bj * RMQ_BLOCK, j));
+  }
+
+  // Answers the queries [lo[k].first, lo[k].second] for lo + k in
+  // [lo, hi), in parallel, into out
+  void query(const std::pair<intT, intT>* lo, const std::pair<intT, intT>* hi, intT* out) const {
+    parallel_for(0L, (long) (hi - lo), [&] (long k) {
+      out[k] = query(lo[k].first, lo[k].second);
+    });
+  }
+
+  long size_in_bytes() const {
+    return (long) n + (long) nb_blocks * (RMQ_BLOCK_LEVELS + 2) * sizeof(uint16_t)
+      + (long) depth * nb_superblocks * sizeof(std::pair<Index, Index>);
+  }
+
+};
+
+using compact_rmq = basic_compact_rmq<intT>;
+
 } // end namespace
 } // end namespace
 
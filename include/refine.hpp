@@ -26,6 +26,7 @@
 #include "geometry.hpp"
 #include "nearestneighbors.hpp"
 #include "topology.hpp"
+#include "halfedge.hpp"
 #include "deterministichash.hpp"
 #include "delaunay.hpp"
 #include "timer.hpp"
@@ -39,20 +40,9 @@
 namespace pasl {
 namespace pctl {
 
-struct hash_triangles {
-  typedef tri* eType;
-  typedef tri* kType;
-  eType empty() {return NULL;}
-  kType get_key(eType v) { return v;}
-  uintT hash(kType s) { return prandgen::hashi(s->id); }
-  int cmp(kType s, kType s2) {
-    return (s->id > s2->id) ? 1 : ((s->id == s2->id) ? 0 : -1);
-  }
-  bool replaceQ(eType s, eType s2) {return 0;}
-};
-
-typedef Table<hash_triangles,intT> TriangleTable;
-TriangleTable make_triangle_table(intT m) {return TriangleTable(m,hash_triangles());}
+// the triangles are given by their ids
+typedef Table<hash_int<intT>,intT> TriangleTable;
+TriangleTable make_triangle_table(intT m) {return TriangleTable(m,hash_int<intT>());}
 
 // *************************************************************
 //   THESE ARE TAKEN FROM delaunay.C
@@ -115,107 +105,145 @@ void reserveForInsert(vertex *v, simplex t, Qs *q) {
 //   DEALING WITH THE CAVITY
 // *************************************************************
 
-inline bool skinny_triangle(tri *t) {
+// The mesh being refined, with the skinny triangle every new vertex is
+// to refine (-1 once the vertex is inserted), and the state of every
+// triangle: 0 if fine, 1 if skinny, and 2 if skinny and given to a vertex
+// by the current round. The new vertex v uses the triangles spare(v) and
+// spare(v) + 1.
+struct refinement {
+  halfedge_mesh mesh;
+  parray<intT> badT;
+  parray<char> bad;
+  intT num_points;
+  intT num_triangles;
+
+  refinement(triangles<point2d> Tri, intT extra_vertices, intT extra_triangles)
+  : mesh(Tri, extra_vertices, extra_triangles),
+    badT(Tri.num_points + extra_vertices, -1),
+    bad(Tri.num_triangles + extra_triangles, 0),
+    num_points(Tri.num_points),
+    num_triangles(Tri.num_triangles) { }
+
+  intT spare(intT v) const {
+    return num_triangles + 2 * (v - num_points);
+  }
+};
+
+inline bool skinny_triangle(const halfedge_mesh& mesh, int t) {
   double minAngle = 30;
-  if (minAngleCheck(t->vtx[0]->pt, t->vtx[1]->pt, t->vtx[2]->pt, minAngle))
+  const int* o = mesh.origin.cbegin() + 3 * t;
+  if (minAngleCheck(mesh.points[o[0]], mesh.points[o[1]], mesh.points[o[2]], minAngle))
     return 1;
   return 0;
 }
 
-inline bool obtuse(simplex t) {
-  int o = t.o;
-  point2d p0 = t.t->vtx[(o+1)%3]->pt;
-  vect2d v1 = t.t->vtx[o]->pt - p0;
-  vect2d v2 = t.t->vtx[(o+2)%3]->pt - p0;
+// true if the angle facing h in its triangle is obtuse
+inline bool obtuse(const halfedge_mesh& mesh, int h) {
+  point2d p0 = mesh.points[mesh.apex(h)];
+  point2d p1 = mesh.points[mesh.target(h)];
+  point2d p2 = mesh.points[mesh.origin[h]];
+  vect2d v1 = p1 - p0;
+  vect2d v2 = p2 - p0;
   return (v1.dot(v2) < 0.0);
 }
 
-inline point2d circumcenter(simplex t) {
-  if (t.isTriangle())
-    return triangleCircumcenter(t.t->vtx[0]->pt, t.t->vtx[1]->pt, t.t->vtx[2]->pt);
-  else { // t.isBoundary()
-    point2d p0 = t.t->vtx[(t.o+2)%3]->pt;
-    point2d p1 = t.t->vtx[t.o]->pt;
+// the angle facing h in its triangle
+inline double far_angle(const halfedge_mesh& mesh, int h) {
+  return angle(mesh.points[mesh.apex(h)], mesh.points[mesh.target(h)], mesh.points[mesh.origin[h]]);
+}
+
+inline point2d circumcenter(const halfedge_mesh& mesh, int h, bool boundary) {
+  if (!boundary) {
+    int t = 3 * halfedge_mesh::face(h);
+    return triangleCircumcenter(mesh.points[mesh.origin[t]], mesh.points[mesh.origin[t + 1]],
+                                mesh.points[mesh.origin[t + 2]]);
+  } else { // the middle of the boundary half-edge h
+    point2d p0 = mesh.points[mesh.origin[h]];
+    point2d p1 = mesh.points[mesh.target(h)];
     return p0 + (p1-p0)/2.0;
   }
 }
 
-// this side affects the simplex by moving it into the right orientation
-// and setting the boundary if the circumcenter encroaches on a boundary
-inline bool checkEncroached(simplex& t) {
-  if (t.isBoundary()) return 0;
+// this side affects the half-edge by moving it around its triangle and
+// setting boundary if the circumcenter encroaches on a boundary
+inline bool checkEncroached(const halfedge_mesh& mesh, int& h, bool& boundary) {
+  if (boundary) return 0;
   int i;
   for (i=0; i < 3; i++) {
-    if (t.across().isBoundary() && (t.farAngle() > 45.0)) break;
-    t = t.rotClockwise();
+    if (mesh.twin[h] < 0 && (far_angle(mesh, h) > 45.0)) break;
+    h = halfedge_mesh::next(h);
   }
-  if (i < 3) return t.boundary = 1;
+  if (i < 3) return boundary = 1;
   else return 0;
 }
 
-bool find_and_reserve_cavity(vertex* v, simplex& t, queues* q) {
-  t = simplex(v->badT,0);
-  if (t.t == NULL) {cout << "refine: nothing in badT" << endl; abort();}
-  if (t.t->bad == 0) return 0;
-  //t.t->bad = 0;
+bool find_and_reserve_cavity(refinement& r, intT v, int& h, bool& boundary, queues* q) {
+  halfedge_mesh& mesh = r.mesh;
+  if (r.badT[v] < 0) {cout << "refine: nothing in badT" << endl; abort();}
+  h = 3 * r.badT[v];
+  boundary = 0;
+  if (r.bad[r.badT[v]] == 0) return 0;
+  
+  // moves h to its twin, or marks it as the boundary if it has none
+  auto across = [&] {
+    if (mesh.twin[h] < 0) boundary = 1;
+    else h = mesh.twin[h];
+  };
   
   // if there is an obtuse angle then move across to opposite triangle, repeat
-  if (obtuse(t)) t = t.across();
-  while (t.isTriangle()) {
+  if (obtuse(mesh, h)) across();
+  while (!boundary) {
     int i;
     for (i=0; i < 2; i++) {
-      t = t.rotClockwise();
-      if (obtuse(t)) { t = t.across(); break; }
+      h = halfedge_mesh::next(h);
+      if (obtuse(mesh, h)) { across(); break; }
     }
     if (i==2) break;
   }
   
   // if encroaching on boundary, move to boundary
-  checkEncroached(t);
+  checkEncroached(mesh, h, boundary);
   
   // use circumcenter to add (if it is a boundary then its middle)
-  v->pt = circumcenter(t);
-  reserve_for_insert(v, t, q);
+  mesh.points[v] = circumcenter(mesh, h, boundary);
+  reserve_for_insert(mesh, v, h, q);
   return 1;
 }
 
 // checks if v "won" on all adjacent vertices and inserts point if so
 // returns true if "won" and cavity was updated
-bool add_cavity(vertex *v, simplex t, queues *q, TriangleTable TT) {
+bool add_cavity(refinement& r, intT v, int h, bool boundary, queues *q, TriangleTable TT) {
+  halfedge_mesh& mesh = r.mesh;
   bool flag = 1;
   for (intT i = 0; i < q->vertex_queue.size(); i++) {
-    vertex* u = (q->vertex_queue)[i];
-    if (u->reserve == v->id) u->reserve = -1; // reset to -1
+    int u = (q->vertex_queue)[i];
+    if (mesh.reserve[u] == v) mesh.reserve[u] = -1; // reset to -1
     else flag = 0; // someone else with higher priority reserved u
   }
   if (flag) {
-    tri* t0 = t.t;
-    tri* t1 = v->t;  // the memory for the two new triangles
-    tri* t2 = t1 + 1;
-    t1->initialized = 1;
-    if (t.isBoundary()) t.splitBoundary(v, t1);
-    else {
-      t2->initialized = 1;
-      t.split(v, t1, t2);
-    }
+    int t0 = halfedge_mesh::face(h);
+    int t1 = r.spare(v);  // the memory for the two new triangles
+    int t2 = t1 + 1;
+    if (boundary) mesh.split_boundary(h, v, t1);
+    else mesh.split(h, v, t1, t2);
     
     // update the cavity
-    for (intT i = 0; i<q->simplex_queue.size(); i++)
-      (q->simplex_queue)[i].flip();
-    q->simplex_queue.push_back(simplex(t0,0));
-    q->simplex_queue.push_back(simplex(t1,0));
-    if (!t.isBoundary()) q->simplex_queue.push_back(simplex(t2,0));
+    for (intT i = 0; i<q->edge_queue.size(); i++)
+      mesh.flip((q->edge_queue)[i]);
+    q->edge_queue.push_back(3 * t0);
+    q->edge_queue.push_back(3 * t1);
+    if (!boundary) q->edge_queue.push_back(3 * t2);
     
-    for (intT i = 0; i<q->simplex_queue.size(); i++) {
-      tri* t = (q->simplex_queue)[i].t;
-      if (skinny_triangle(t)) {
+    for (intT i = 0; i<q->edge_queue.size(); i++) {
+      int t = halfedge_mesh::face((q->edge_queue)[i]);
+      if (skinny_triangle(mesh, t)) {
         TT.insert(t);
-        t->bad = 1;}
-      else t->bad = 0;
+        r.bad[t] = 1;}
+      else r.bad[t] = 0;
     }
-    v->badT = NULL;
+    r.badT[v] = -1;
   }
-  q->simplex_queue.clear();
+  q->edge_queue.clear();
   q->vertex_queue.clear();
   return flag;
 }
@@ -224,33 +252,34 @@ bool add_cavity(vertex *v, simplex t, queues *q, TriangleTable TT) {
 //    MAIN REFINEMENT LOOP
 // *************************************************************
 
-intT add_refining_vertices(vertex** v, intT n, intT nTotal, TriangleTable TT) {
+intT add_refining_vertices(refinement& r, intT* v, intT n, intT nTotal, TriangleTable TT) {
   intT maxR = (intT) (nTotal / 500) + 1; // maximum number to try in parallel
 #ifdef MANUAL_ALLOCATION
   queues* qqs = (queues*) malloc(sizeof(queues) * maxR);
   queues** qs = (queues**) malloc(sizeof(queues*) * maxR);
   for (intT i = 0; i < maxR; i++) qs[i] = new (&qqs[i]) queues;
-  simplex* t = (simplex*) malloc(sizeof(simplex) * maxR);
+  int* t = (int*) malloc(sizeof(int) * maxR);
+  bool* b = (bool*) malloc(sizeof(bool) * maxR);
   bool* flags = (bool*) malloc(sizeof(flags) * maxR);
-  vertex** h = (vertex**) malloc(sizeof(vertex*) * maxR);
+  intT* h = (intT*) malloc(sizeof(intT) * maxR);
 //  int* comp = (int*) malloc(sizeof(int) * maxR);
   auto flags_ref = flags;
-  auto t_ref = t;auto qs_ref = qs;
+  auto t_ref = t;auto b_ref = b;auto qs_ref = qs;
 #else
   parray<queues> qqs;
   qqs.prefix_tabulate(maxR, 0);
   parray<queues*> qs;
   qs.prefix_tabulate(maxR, 0);
   for (intT i=0; i < maxR; i++) qs[i] = new (&qqs[i]) queues;
-  parray<simplex> t;
-  t.prefix_tabulate(maxR, 0);
+  parray<int> t(maxR);
+  parray<bool> b(maxR);
   parray<bool> flags;
   flags.prefix_tabulate(maxR, 0);
-  parray<vertex*> h;
-  h.prefix_tabulate(maxR, 0);
+  parray<intT> h(maxR);
 //  parray<int> comp; comp.prefix_tabulate(maxR, 0);
   auto flags_ref = flags.begin();
   auto t_ref = t.begin();
+  auto b_ref = b.begin();
   auto qs_ref = qs.begin();
 #endif
   
@@ -259,19 +288,19 @@ intT add_refining_vertices(vertex** v, intT n, intT nTotal, TriangleTable TT) {
   // process all vertices starting just below the top
   while(top > 0) {
     intT cnt = std::min<intT>(size,top);
-    vertex** vv = v+top-cnt;
-    range::parallel_for((intT)0, cnt, [&] (int l, int r) { return r - l; }, [&, flags_ref, vv, t_ref, qs_ref] (intT j) {
+    intT* vv = v+top-cnt;
+    range::parallel_for((intT)0, cnt, [&] (int l, int r) { return r - l; }, [&, flags_ref, vv, t_ref, b_ref, qs_ref] (intT j) {
 //    cilk_for (int j = 0; j < cnt; j++)
-      flags_ref[j] = find_and_reserve_cavity(vv[j],t_ref[j],qs_ref[j]);
-    }, [&, flags_ref, vv, t_ref, qs_ref] (int l, int r) {
-      for (int j = l; j < r; j++) {
-        flags_ref[j] = find_and_reserve_cavity(vv[j], t_ref[j], qs_ref[j]);
-//        std::cerr << qs_ref[j]->vertex_queue.size() + qs_ref[j]->simplex_queue.size() << std::endl; 
+      flags_ref[j] = find_and_reserve_cavity(r, vv[j], t_ref[j], b_ref[j], qs_ref[j]);
+    }, [&, flags_ref, vv, t_ref, b_ref, qs_ref] (int lo, int hi) {
+      for (int j = lo; j < hi; j++) {
+        flags_ref[j] = find_and_reserve_cavity(r, vv[j], t_ref[j], b_ref[j], qs_ref[j]);
+//        std::cerr << qs_ref[j]->vertex_queue.size() + qs_ref[j]->edge_queue.size() << std::endl; 
       }
     });
 /*    //TODO: wrong complexity -> qs[j].vq.size() + qs[j].sq.size()
     parallel_for(0, cnt, [&] (int i) {
-      comp[i] = std::max((int)qs[i]->vertex_queue.size() + (int)qs[i]->simplex_queue.size(), 1);
+      comp[i] = std::max((int)qs[i]->vertex_queue.size() + (int)qs[i]->edge_queue.size(), 1);
     });
 #ifdef MANUAL_ALLOCATION
     dps::scan(comp, comp + cnt, 0, [&] (int x, int y) { return x + y; }, comp, forward_inclusive_scan);
@@ -280,12 +309,12 @@ intT add_refining_vertices(vertex** v, intT n, intT nTotal, TriangleTable TT) {
 #endif*/
     
 //    range::parallel_for((intT)0, cnt, [&] (int l, int r) { return comp[r - 1] - (l == 0 ? 0 : comp[l - 1]); }, [&] (intT j) {
-    range::parallel_for((intT)0, cnt, [&] (int l, int r) { return r - l; }, [&, flags_ref, vv, t_ref, qs_ref] (intT j) {
+    range::parallel_for((intT)0, cnt, [&] (int l, int r) { return r - l; }, [&, flags_ref, vv, t_ref, b_ref, qs_ref] (intT j) {
 //    cilk_for (int j = 0; j < cnt; j++)
-      flags_ref[j] = flags_ref[j] && !add_cavity(vv[j], t_ref[j], qs_ref[j], TT);
-    }, [&, flags_ref, vv, t_ref, qs_ref] (intT l, intT r) {
-      for (int j = l; j < r; j++) {
-        flags_ref[j] = flags_ref[j] && !add_cavity(vv[j], t_ref[j], qs_ref[j], TT);
+      flags_ref[j] = flags_ref[j] && !add_cavity(r, vv[j], t_ref[j], b_ref[j], qs_ref[j], TT);
+    }, [&, flags_ref, vv, t_ref, b_ref, qs_ref] (intT lo, intT hi) {
+      for (int j = lo; j < hi; j++) {
+        flags_ref[j] = flags_ref[j] && !add_cavity(r, vv[j], t_ref[j], b_ref[j], qs_ref[j], TT);
       }
     });
     
@@ -327,28 +356,15 @@ triangles<point2d> refine(triangles<point2d> Tri) {
   intT totalVertices = n + extraVertices;
   intT totalTriangles = m + 2 * extraVertices;
   
-  parray<vertex*> v;
-  v.prefix_tabulate(extraVertices, 0);
-  parray<vertex> vv;
-  vv.prefix_tabulate(totalVertices, 0);
-  parray<tri> Triangs;  Triangs.prefix_tabulate(totalTriangles, 0);
-  topologyFromTriangles(Tri, vv, Triangs);
+  refinement r(Tri, extraVertices, 2 * extraVertices);
+  halfedge_mesh& mesh = r.mesh;
 
     timer.end("from triangles");
     timer.start();
 
-
-  //  set up extra triangles
-  parallel_for((intT)m, totalTriangles, [&] (intT i) {
-    Triangs[i].id = i;
-    Triangs[i].initialized = 0;
-  });
-  
   //  set up extra vertices
-  parallel_for((intT)0, totalVertices - n, [&] (intT i) {
-    v[i] = new (&vv[i + n]) vertex(point2d(0,0), i + n);
-    // give each one a pointer to two triangles to use
-    v[i]->t = Triangs.begin() + m + 2*i;
+  parray<intT> v(extraVertices, [&] (intT i) {
+    return i + n;
   });
 
     timer.end("initialization");
@@ -360,9 +376,9 @@ triangles<point2d> refine(triangles<point2d> Tri) {
   
   TriangleTable workQ = make_triangle_table(numTriangs);
   parallel_for((intT)0, numTriangs, [&] (intT i) {
-    if (skinny_triangle(&Triangs[i])) {
-      workQ.insert(&Triangs[i]);
-      Triangs[i].bad = 1;
+    if (skinny_triangle(mesh, i)) {
+      workQ.insert(i);
+      r.bad[i] = 1;
     }
   });
 
@@ -377,16 +393,16 @@ triangles<point2d> refine(triangles<point2d> Tri) {
   // adding new bad triangles to a new queue
   while (1) {
     entries_timer.start();
-    parray<tri*> badTT = workQ.entries();
+    parray<intT> badTT = workQ.entries();
     workQ.del();
     entries_timer.end();
     
     pack_timer.start();
     // packs out triangles that are no longer bad
     parray<bool> flags(badTT.size(), [&] (intT i) {
-      return badTT[i]->bad;
+      return r.bad[badTT[i]];
     });
-    parray<tri*> badT = pack(badTT.cbegin(), badTT.cend(), flags.cbegin());
+    parray<intT> badT = pack(badTT.cbegin(), badTT.cend(), flags.cbegin());
     intT numBad = (intT)badT.size();
     pack_timer.end();
     
@@ -400,8 +416,8 @@ triangles<point2d> refine(triangles<point2d> Tri) {
     table_timer.start();
     // allocate 1 vertex per bad triangle and assign triangle to it
     parallel_for((intT)0, numBad, [&] (intT i) {
-      badT[i]->bad = 2; // used to detect whether touched
-      v[i + numPoints - n]->badT = badT[i];
+      r.bad[badT[i]] = 2; // used to detect whether touched
+      r.badT[v[i + numPoints - n]] = badT[i];
     });
     
     // the new work queue
@@ -410,12 +426,12 @@ triangles<point2d> refine(triangles<point2d> Tri) {
 
     refining_timer.start();
     // This does all the work
-    add_refining_vertices(v.begin() + numPoints - n, numBad, numPoints, workQ);
+    add_refining_vertices(r, v.begin() + numPoints - n, numBad, numPoints, workQ);
     refining_timer.end();
     
     // push any bad triangles that were left untouched onto the Q
     parallel_for((intT)0, numBad, [&] (intT i) {
-      if (badT[i]->bad==2) workQ.insert(badT[i]);
+      if (r.bad[badT[i]]==2) workQ.insert(badT[i]);
     });
 
     numPoints += numBad;
@@ -424,38 +440,32 @@ triangles<point2d> refine(triangles<point2d> Tri) {
   timer.end("refine");
   timer.start();
   // Extract Vertices for result
-  parray<bool> flag;
-  flag.prefix_tabulate(numTriangs, numPoints, [&] (intT i) {
-    return (vv[i].badT == NULL);
+  parray<bool> flag(numPoints, [&] (intT i) {
+    return (r.badT[i] < 0);
   });
-  parray<long> I = pack_index(flag.cbegin(), flag.cbegin() + numPoints);
+  parray<long> I = pack_index(flag.cbegin(), flag.cend());
   intT nO = (intT)I.size();
   point2d* rp = newA(point2d, nO);
+  parray<intT> id(numPoints);
   parallel_for((intT)0, nO, [&] (intT i) {
-    vv[I[i]].id = i;
-    rp[i] = vv[I[i]].pt;
+    id[I[i]] = i;
+    rp[i] = mesh.points[I[i]];
   });
   //cout << "total points = " << nO << endl;
   
   // Extract Triangles for result
-  parallel_for((intT)0, numTriangs, [&] (intT i) {
-    flag[i] = Triangs[i].initialized;
-  });
-  I = pack_index(flag.cbegin(), flag.cbegin() + numTriangs);
-  triangle* rt = newA(triangle, I.size());
-  parallel_for((intT)0, (intT)I.size(), [&] (intT i) {
-    tri t = Triangs[I[i]];
-    rt[i] = triangle(t.vtx[0]->id, t.vtx[1]->id, t.vtx[2]->id);
+  triangles<point2d> result = mesh.to_triangles(nO, rp, [&] (int u) {
+    return id[u];
   });
-  //cout << "total triangles = " << I.n << endl;
+  //cout << "total triangles = " << result.num_triangles << endl;
   timer.end("finalization");
   entries_timer.report_total("entries");
   pack_timer.report_total("pack");
   table_timer.report_total("table");  refining_timer.report_total("refining");
-  return triangles<point2d>(nO, (intT)I.size(), rp, rt);
+  return result;
 }
   
 } // end namespace
 } // end namespace
 
-#endif /*! _PCTL_DELAUNAY_REFINE_H_ */
\ No newline at end of file
+#endif /*! _PCTL_DELAUNAY_REFINE_H_ */
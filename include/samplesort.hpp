@@ -74,6 +74,20 @@ void split_positions(E* a, E* b, intT* c, intT length_a, intT length_b, BinPred
   c[pos_c] = length_a - pos_a;
 }
 
+// Returns a sorted random sample of size sample_set_size drawn from a[0, n).
+// The seed shifts the positions drawn, so that callers that sample the same
+// array repeatedly do not keep picking the same elements.
+template<class E, class BinPred, class intT>
+parray<E> sorted_sample(E* a, intT n, intT sample_set_size, BinPred compare, intT seed = 0) {
+  parray<E> sample_set(sample_set_size, [&] (intT j) {
+    intT o = prandgen::hashi(j + seed) % n;
+    return a[o];
+  });
+  quick_sort(sample_set.begin(), sample_set_size, compare);
+//  std::sort(sample_set.begin(), sample_set.end(), compare);
+  return sample_set;
+}
+
 #define SSORT_THR 100000
 #define AVG_SEG_SIZE 2
 #define PIVOT_QUOT 2
@@ -82,7 +96,7 @@ void split_positions(E* a, E* b, intT* c, intT length_a, intT length_b, BinPred
 constexpr char samplesort_file[] = "samplesort";
 
 template<class E, class BinPred, class intT>
-void sample_sort (E* a, intT n, BinPred compare) {
+void sample_sort_rec (E* a, intT n, BinPred compare) {
 //  par::cstmt<samplesort_file, E, BinPred, intT>([&] { return (90 * n * log(n) + 1); }, [&] { return (n * log(n) + 1); }, [&] {
 //#ifdef MANUAL_CONTROL
     if (n <= SSORT_THR) {
@@ -114,21 +128,13 @@ void sample_sort (E* a, intT n, BinPred compare) {
       intT o = prandgen::hashi(i) % n;
       sample_set[i] = a[o];
     });
-#else
-    parray<E> sample_set(sample_set_size, [&] (intT j) {
-      intT o = prandgen::hashi(j) % n;
-      return a[o];
-    });
-#endif
     //cout << "n=" << n << " num_segs=" << segments << endl;
       
     // sort the samples
-#ifdef MANUAL_ALLOCATION
     quick_sort(sample_set, sample_set_size, compare);
 //    std::sort(sample_set, sample_set + sample_set_size, compare);
 #else
-    quick_sort(sample_set.begin(), sample_set_size, compare);
-//    std::sort(sample_set.begin(), sample_set.end(), compare);
+    parray<E> sample_set = sorted_sample(a, n, sample_set_size, compare);
 #endif
       
     // subselect samples at even stride
@@ -176,7 +182,7 @@ void sample_sort (E* a, intT n, BinPred compare) {
     range::parallel_for((intT)0, rows, [&] (intT lo, intT hi) { return (hi - lo) * row_length; }, [&] (intT r) {
       intT offset = r * row_length;
       intT size = (r < rows - 1) ? row_length : n - offset;
-      sample_sort(a + offset, size, compare);
+      sample_sort_rec(a + offset, size, compare);
 //      std::sort(a + offset, a + offset + size, compare);
 #ifdef MANUAL_ALLOCATION
       split_positions(a + offset, pivots, segments_sizes + r * segments, size, pivots_size, compare);
@@ -242,13 +248,13 @@ void sample_sort (E* a, intT n, BinPred compare) {
     range::parallel_for((intT)0, (intT)(pivots_size + 1), complexity_fct, [&] (intT i) {
       intT offset = offset_b[(2 * i) * rows];
       if (i == 0) {
-          sample_sort(a, offset_b[rows], compare); // first segment
+          sample_sort_rec(a, offset_b[rows], compare); // first segment
       } else if (i < pivots_size) { // middle segments
         if (compare(pivots[i - 1], pivots[i])) {
-          sample_sort(a + offset, offset_b[(2 * i + 1) * rows] - offset, compare);
+          sample_sort_rec(a + offset, offset_b[(2 * i + 1) * rows] - offset, compare);
         }
       } else { // last segment
-        sample_sort(a + offset, n - offset, compare);
+        sample_sort_rec(a + offset, n - offset, compare);
       }
     });
 /*    auto complexity_fct = [&] (intT lo, intT hi) {
@@ -287,6 +293,17 @@ void sample_sort (E* a, intT n, BinPred compare) {
     std::sort(a, a + n, compare);
   });*/
 }
+
+// Large inputs that are already sorted, reverse sorted or made of few
+// runs are handled by the presortedness pass, once, instead of at every
+// level of the recursion
+template <class E, class BinPred, class intT>
+void sample_sort(E* a, intT n, BinPred compare) {
+  if (n > PRESORT_THR && sort_if_presorted(a, n, compare)) {
+    return;
+  }
+  sample_sort_rec(a, n, compare);
+}
   
 } // end namespace
 } // end namespace
@@ -0,0 +1,155 @@
+/* COPYRIGHT (c) 2015 Umut Acar, Arthur Chargueraud, and Michael
+ * Rainey
+ * All rights reserved.
+ *
+ * \file selection.hpp
+ * \brief Parallel selection, partial sort and top-k
+ *
+ */
+
+#include <algorithm>
+#include <math.h>
+#include "datapar.hpp"
+#include "samplesort.hpp"
+
+#ifndef _PBBS_PCTL_SELECTION_H_
+#define _PBBS_PCTL_SELECTION_H_
+
+namespace pasl {
+namespace pctl {
+
+#define SELECT_THR 20000
+#define SELECT_OVER_SAMPLE 8
+
+/*---------------------------------------------------------------------*/
+/* Selection */
+
+// Picks, from a sorted random sample of a[0, n), two pivots lo and hi such
+// that with high probability the element of rank k lies between them.
+// The sample has SELECT_OVER_SAMPLE * sqrt(n) elements and the pivots are
+// taken 2 * sqrt(sample size) positions away from the expected rank, which
+// is about four standard deviations.
+template <class E, class BinPred, class intT>
+std::pair<E, E> select_pivots(E* a, intT n, intT k, BinPred compare, intT seed) {
+  intT sample_set_size = std::min(n, (intT) (SELECT_OVER_SAMPLE * sqrt(n)));
+  parray<E> sample_set = sorted_sample(a, n, sample_set_size, compare, seed);
+  intT r = (intT) (((double) k / n) * sample_set_size);
+  intT delta = (intT) (2 * sqrt(sample_set_size)) + 1;
+  intT lo = std::max((intT) 0, r - delta);
+  intT hi = std::min(sample_set_size - 1, r + delta);
+  return std::make_pair(sample_set[lo], sample_set[hi]);
+}
+
+// Rearranges a[0, n) in three parts: the elements less than lo, then the
+// elements between lo and hi (inclusive), then the elements greater than hi.
+// b is temporary space of length n. The sizes of the first two parts are
+// returned.
+template <class E, class BinPred, class intT>
+std::pair<intT, intT> three_way_partition(E* a, E* b, intT n, const E& lo, const E& hi, BinPred compare) {
+  parray<bool> flags(n, [&] (intT i) {
+    return compare(a[i], lo);
+  });
+  intT n1 = (intT) dps::pack(flags.begin(), a, a + n, b);
+  parallel_for((intT) 0, n, [&] (intT i) {
+    flags[i] = compare(hi, a[i]);
+  });
+  intT n3 = (intT) dps::pack(flags.begin(), a, a + n, b + n1);
+  parallel_for((intT) 0, n, [&] (intT i) {
+    flags[i] = !compare(a[i], lo) && !compare(hi, a[i]);
+  });
+  intT n2 = (intT) dps::pack(flags.begin(), a, a + n, b + n1 + n3);
+  pmem::copy(b, b + n1, a);
+  pmem::copy(b + n1 + n3, b + n, a + n1);
+  pmem::copy(b + n1, b + n1 + n3, a + n1 + n2);
+  return std::make_pair(n1, n2);
+}
+
+// Rearranges a[0, n) so that a[k] is the element that would be at position
+// k if a were sorted, every element before it is not greater and every
+// element after it is not less (same contract as std::nth_element).
+// Each round samples two pivots around rank k, partitions the array around
+// them and continues only on the part that holds rank k, which is small
+// with high probability.
+template <class E, class BinPred, class intT>
+void nth_element(E* a, intT n, intT k, BinPred compare) {
+  if (k < 0 || k >= n) {
+    return;
+  }
+  parray<E> b;
+  b.prefix_tabulate(n, 0);
+  intT seed = 0;
+  while (n > SELECT_THR) {
+    std::pair<E, E> pivots = select_pivots(a, n, k, compare, seed);
+    std::pair<intT, intT> sizes = three_way_partition(a, b.begin(), n, pivots.first, pivots.second, compare);
+    intT n1 = sizes.first;
+    intT n2 = sizes.second;
+    if (k < n1) {
+      n = n1;
+    } else if (k < n1 + n2) {
+      if (! compare(pivots.first, pivots.second)) {
+        return; // the middle part holds only copies of the pivot
+      }
+      if (n2 == n) {
+        // the sample did not shrink the range: give up on selection
+        sample_sort(a, n, compare);
+        return;
+      }
+      a = a + n1;
+      k = k - n1;
+      n = n2;
+    } else {
+      a = a + n1 + n2;
+      k = k - n1 - n2;
+      n = n - n1 - n2;
+    }
+    seed += n;
+  }
+  std::nth_element(a, a + k, a + n, compare);
+}
+
+/*---------------------------------------------------------------------*/
+/* Partial sort and top-k */
+
+// Sorts the k smallest elements of a[0, n) into a[0, k); the order of the
+// remaining elements is unspecified (same contract as std::partial_sort).
+template <class E, class BinPred, class intT>
+void partial_sort(E* a, intT n, intT k, BinPred compare) {
+  k = std::min(k, n);
+  if (k <= 0) {
+    return;
+  }
+  nth_element(a, n, k - 1, compare);
+  sample_sort(a, k - 1, compare);
+}
+
+// Returns, in sorted order, the k smallest elements of a[0, n) with respect
+// to compare (use std::greater to get the k largest), leaving a untouched.
+// A sampled threshold slightly above rank k filters the candidates first, so
+// only about k elements are copied and sorted.
+template <class E, class BinPred, class intT>
+parray<E> top_k(E* a, intT n, intT k, BinPred compare) {
+  k = std::min(k, n);
+  if (k <= 0) {
+    return parray<E>();
+  }
+  parray<E> result;
+  if (n > SELECT_THR) {
+    std::pair<E, E> pivots = select_pivots(a, n, k, compare, (intT) 0);
+    result = filter(a, a + n, [&] (const E& x) {
+      return ! compare(pivots.second, x);
+    });
+  }
+  if ((intT) result.size() < k) {
+    result = parray<E>(n, [&] (intT i) {
+      return a[i];
+    });
+  }
+  partial_sort(result.begin(), (intT) result.size(), k, compare);
+  result.resize(k);
+  return result;
+}
+
+} // end namespace
+} // end namespace
+
+#endif /*! _PBBS_PCTL_SELECTION_H_ */
@@ -0,0 +1,236 @@
+/* COPYRIGHT (c) 2015 Umut Acar, Arthur Chargueraud, and Michael
+ * Rainey
+ * All rights reserved.
+ *
+ * \file semisort.hpp
+ * \brief Parallel semisort, group-by and reduce-by-key
+ *
+ */
+
+#include <algorithm>
+#include <math.h>
+#include "datapar.hpp"
+#include "prandgen.hpp"
+#include "utils.hpp"
+#include "samplesort.hpp"
+#include "blockradixsort.hpp"
+
+#ifndef _PBBS_PCTL_SEMISORT_H_
+#define _PBBS_PCTL_SEMISORT_H_
+
+namespace pasl {
+namespace pctl {
+
+// Semisort reorders a sequence so that elements with equal keys are
+// contiguous, without ordering the groups themselves. It follows
+//   Yan Gu, Julian Shun, Yihan Sun, Guy E. Blelloch
+//   A Top-Down Parallel Semisort
+//   SPAA 2015
+// Keys are hashed; a sample of the hashes identifies heavy keys, which get
+// one bucket each, and the remaining (light) keys are spread over buckets
+// by the high bits of their hash. A single integer sort on the bucket ids
+// scatters the elements, and every light bucket, which is small, is then
+// grouped sequentially by sorting its hashes.
+
+#define SEMISORT_THR 16384
+#define SEMISORT_BUCKET_SIZE 2048
+#define SEMISORT_MAX_LIGHT_BUCKETS (1 << 16)
+
+using semisort_tag = std::pair<unsigned int, int>;
+
+// Groups tags[lo, hi), which all have the same hash, by key. The cost is
+// the length of the run times the number of distinct keys in it, which is
+// one unless the hash collides.
+template <class E, class Key_fct, class intT>
+void semisort_collisions(E* a, semisort_tag* tags, intT lo, intT hi, const Key_fct& get_key) {
+  intT i = lo;
+  while (i < hi) {
+    auto key = get_key(a[tags[i].second]);
+    intT j = i + 1;
+    for (intT l = i + 1; l < hi; l++) {
+      if (get_key(a[tags[l].second]) == key) {
+        std::swap(tags[l], tags[j++]);
+      }
+    }
+    i = j;
+  }
+}
+
+// Sequentially groups the tags of a light bucket: sorts them by hash and then
+// separates the keys that share a hash.
+template <class E, class Key_fct, class intT>
+void semisort_bucket(E* a, semisort_tag* tags, intT n, const Key_fct& get_key) {
+  std::sort(tags, tags + n, [&] (const semisort_tag& x, const semisort_tag& y) {
+    return x.first < y.first;
+  });
+  intT i = 0;
+  while (i < n) {
+    intT j = i + 1;
+    while (j < n && tags[j].first == tags[i].first) {
+      j++;
+    }
+    if (j - i > 1) {
+      semisort_collisions(a, tags, i, j, get_key);
+    }
+    i = j;
+  }
+}
+
+// Reorders a[0, n) so that elements with equal keys (get_key(x) == get_key(y))
+// are contiguous. hash maps a key to an unsigned int and must agree with ==.
+template <class E, class Key_fct, class Hash_fct, class intT>
+void semisort(E* a, intT n, const Key_fct& get_key, const Hash_fct& hash) {
+  if (n <= 1) {
+    return;
+  }
+  parray<semisort_tag> tags(n, [&] (intT i) {
+    return semisort_tag((unsigned int) hash(get_key(a[i])), (int) i);
+  });
+  if (n <= SEMISORT_THR) {
+    semisort_bucket(a, tags.begin(), n, get_key);
+  } else {
+    // heavy hashes are the ones seen at least log n times in a sample of
+    // n / log n hashes
+    intT log_n = std::max(2, utils::log2Up(n));
+    intT sample_set_size = n / log_n;
+    parray<unsigned int> hashes(n, [&] (intT i) {
+      return tags[i].first;
+    });
+    parray<unsigned int> sample_set = sorted_sample(hashes.begin(), n, sample_set_size, std::less<unsigned int>());
+    hashes.clear();
+    parray<bool> is_heavy(sample_set_size, [&] (intT i) {
+      return (i == 0 || sample_set[i] != sample_set[i - 1])
+          && i + log_n - 1 < sample_set_size
+          && sample_set[i + log_n - 1] == sample_set[i];
+    });
+    parray<unsigned int> heavy = pack(sample_set.cbegin(), sample_set.cend(), is_heavy.cbegin());
+    sample_set.clear();
+    is_heavy.clear();
+    intT nb_heavy = (intT) heavy.size();
+    intT nb_light = std::max((intT) 1, std::min((intT) SEMISORT_MAX_LIGHT_BUCKETS, n / SEMISORT_BUCKET_SIZE));
+    intT nb_buckets = nb_heavy + nb_light;
+
+    // scatter the tags to their buckets; the bucket id is kept in the tag
+    // only for the duration of the integer sort
+    parray<unsigned int> tag_hashes(n, [&] (intT i) {
+      return tags[i].first;
+    });
+    parallel_for((intT) 0, n, [&] (intT i) {
+      unsigned int h = tags[i].first;
+      const unsigned int* it = std::lower_bound(heavy.cbegin(), heavy.cend(), h);
+      if (it != heavy.cend() && *it == h) {
+        tags[i].first = (unsigned int) (it - heavy.cbegin());
+      } else {
+        tags[i].first = (unsigned int) (nb_heavy + (((unsigned long) h * nb_light) >> 32));
+      }
+    });
+    parray<intT> offsets;
+    offsets.prefix_tabulate(nb_buckets + 1, 0);
+    intsort::integer_sort(tags.begin(), offsets.begin(), n, nb_buckets, [&] (semisort_tag x) {
+      return (intT) x.first;
+    });
+    offsets[nb_buckets] = n;
+    parallel_for((intT) 0, n, [&] (intT i) {
+      tags[i].first = tag_hashes[tags[i].second];
+    });
+    tag_hashes.clear();
+
+    // group inside the buckets
+    auto complexity_fct = [&] (intT lo, intT hi) {
+      return offsets[hi] - offsets[lo];
+    };
+    range::parallel_for((intT) 0, nb_buckets, complexity_fct, [&] (intT b) {
+      intT lo = offsets[b];
+      intT hi = offsets[b + 1];
+      if (hi - lo <= 1) {
+        return;
+      }
+      if (b >= nb_heavy) {
+        semisort_bucket(a, tags.begin() + lo, hi - lo, get_key);
+        return;
+      }
+      // a heavy bucket holds a single hash, so almost always a single key
+      auto key = get_key(a[tags[lo].second]);
+      bool same = level1::reduce(tags.cbegin() + lo, tags.cbegin() + hi, true, [&] (bool x, bool y) {
+        return x && y;
+      }, [&] (const semisort_tag& t) {
+        return get_key(a[t.second]) == key;
+      });
+      if (! same) {
+        semisort_collisions(a, tags.begin(), lo, hi, get_key);
+      }
+    });
+  }
+  parray<E> result(n, [&] (intT i) {
+    return a[tags[i].second];
+  });
+  pmem::copy(result.cbegin(), result.cend(), a);
+}
+
+/*---------------------------------------------------------------------*/
+/* Group-by and reduce-by-key */
+
+// Semisorts a[0, n) and returns the offsets of the groups: group i occupies
+// [offsets[i], offsets[i + 1]) and the last entry of offsets is n.
+template <class E, class Key_fct, class Hash_fct, class intT>
+parray<intT> group_by(E* a, intT n, const Key_fct& get_key, const Hash_fct& hash) {
+  semisort(a, n, get_key, hash);
+  parray<bool> is_first(n, [&] (intT i) {
+    return i == 0 || ! (get_key(a[i]) == get_key(a[i - 1]));
+  });
+  parray<long> starts = pack_index(is_first.cbegin(), is_first.cend());
+  intT nb_groups = (intT) starts.size();
+  return parray<intT>(nb_groups + 1, [&] (intT i) {
+    return (i == nb_groups) ? n : (intT) starts[i];
+  });
+}
+
+// Combines the values of the pairs in a[0, n) that share a key and returns
+// one (key, combined value) pair per distinct key. a is left semisorted.
+template <class K, class V, class Hash_fct, class Combine, class intT>
+parray<std::pair<K, V>> reduce_by_key(std::pair<K, V>* a, intT n, V id, const Combine& combine, const Hash_fct& hash) {
+  auto get_key = [&] (const std::pair<K, V>& x) {
+    return x.first;
+  };
+  parray<intT> offsets = group_by(a, n, get_key, hash);
+  intT nb_groups = (intT) offsets.size() - 1;
+  parray<std::pair<K, V>> result(nb_groups);
+  auto complexity_fct = [&] (intT lo, intT hi) {
+    return offsets[hi] - offsets[lo];
+  };
+  range::parallel_for((intT) 0, nb_groups, complexity_fct, [&] (intT i) {
+    std::pair<K, V>* lo = a + offsets[i];
+    std::pair<K, V>* hi = a + offsets[i + 1];
+    V v = level1::reduce(lo, hi, id, combine, [&] (const std::pair<K, V>& x) {
+      return x.second;
+    });
+    result[i] = std::make_pair(lo->first, v);
+  });
+  return result;
+}
+
+struct semisort_hash_int {
+  unsigned int operator()(int x) const {
+    return prandgen::hashu((unsigned int) x);
+  }
+};
+
+// Versions for pairs keyed by integers, as produced by
+// load_random_bounded_seq_with_int
+
+template <class V, class intT>
+void semisort(std::pair<int, V>* a, intT n) {
+  semisort(a, n, [&] (const std::pair<int, V>& x) {
+    return x.first;
+  }, semisort_hash_int());
+}
+
+template <class V, class Combine, class intT>
+parray<std::pair<int, V>> reduce_by_key(std::pair<int, V>* a, intT n, V id, const Combine& combine) {
+  return reduce_by_key(a, n, id, combine, semisort_hash_int());
+}
+
+} // end namespace
+} // end namespace
+
+#endif /*! _PBBS_PCTL_SEMISORT_H_ */
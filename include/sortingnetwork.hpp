@@ -0,0 +1,370 @@
+/* COPYRIGHT (c) 2015 Umut Acar, Arthur Chargueraud, and Michael
+ * Rainey
+ * All rights reserved.
+ *
+ * \file sortingnetwork.hpp
+ * \brief Vectorized bitonic sorting networks for small blocks
+ *
+ */
+
+#include <stdint.h>
+#include <string.h>
+#include <limits>
+#include <functional>
+#include <utility>
+#if defined(__AVX2__) || defined(__AVX512F__)
+#include <immintrin.h>
+#endif
+
+#ifndef _PBBS_PCTL_SORTINGNETWORK_H_
+#define _PBBS_PCTL_SORTINGNETWORK_H_
+
+namespace pasl {
+namespace pctl {
+
+// Small blocks of 4- and 8-byte keys are sorted by a bitonic network run on
+// AVX-512 (when compiled with __AVX512F__) or AVX2 (with __AVX2__) vectors.
+// An element is first encoded into a lane value (int32_t or int64_t) whose
+// ascending order is the order of the comparator, the block is
+// padded with the largest lane value up to a power of two, sorted, and
+// decoded back. The dispatch is resolved at compile time: for any other
+// element type, comparator or instruction set, sorting_network_sort returns
+// false and the caller keeps its usual leaf sort.
+
+// Largest block handled by the network
+#define SORTNET_MAX 64
+
+// Size under which the sequential sorts hand blocks to the network; 0
+// disables the network. It is a reference to a single variable, shared by
+// all translation units, so that benchmarks can sweep it.
+inline int& sorting_network_leaf_size() {
+  static int leaf_size = 32;
+  return leaf_size;
+}
+
+/*---------------------------------------------------------------------*/
+/* Encodings */
+
+template <class Lane>
+inline Lane sortnet_flip(Lane x) {
+  return ~x;
+}
+
+template <class E, class BinPred>
+struct sortnet_codec {
+  static constexpr bool enabled = false;
+  typedef int32_t lane_type;
+  static lane_type encode(const E&) { return 0; }
+  static E decode(lane_type) { return E(); }
+};
+
+template <class E, class Lane>
+struct sortnet_identity_codec {
+  static constexpr bool enabled = true;
+  typedef Lane lane_type;
+  static lane_type encode(const E& x) { return (lane_type) x; }
+  static E decode(lane_type x) { return (E) x; }
+};
+
+// unsigned keys are shifted into the signed range by flipping the top bit
+template <class E, class Lane>
+struct sortnet_unsigned_codec {
+  static constexpr bool enabled = true;
+  typedef Lane lane_type;
+  static constexpr E top_bit = (E) 1 << (8 * sizeof(E) - 1);
+  static lane_type encode(const E& x) { return (lane_type) (x ^ top_bit); }
+  static E decode(lane_type x) { return ((E) x) ^ top_bit; }
+};
+
+// floating-point keys are sorted as integers: the magnitude bits of the
+// negative ones are flipped, so that the integer order is the order of the
+// values, with -0.0 before +0.0 and the NaNs at the ends. The network then
+// only moves whole lanes, and its output is a permutation of its input even
+// with signed zeros and NaNs, which the float min and max instructions do
+// not guarantee.
+template <class E, class Lane>
+struct sortnet_float_codec {
+  static constexpr bool enabled = true;
+  typedef Lane lane_type;
+  static lane_type flip_magnitude(lane_type b) {
+    return b ^ ((b >> (8 * sizeof(Lane) - 1)) & std::numeric_limits<Lane>::max());
+  }
+  static lane_type encode(const E& x) {
+    lane_type b;
+    memcpy(&b, &x, sizeof(E));
+    return flip_magnitude(b);
+  }
+  static E decode(lane_type x) {
+    lane_type b = flip_magnitude(x);
+    E r;
+    memcpy(&r, &b, sizeof(E));
+    return r;
+  }
+};
+
+template <>
+struct sortnet_codec<int, std::less<int>> : sortnet_identity_codec<int, int32_t> {};
+template <>
+struct sortnet_codec<unsigned int, std::less<unsigned int>> : sortnet_unsigned_codec<unsigned int, int32_t> {};
+template <>
+struct sortnet_codec<long, std::less<long>> : sortnet_identity_codec<long, int64_t> {};
+template <>
+struct sortnet_codec<unsigned long, std::less<unsigned long>> : sortnet_unsigned_codec<unsigned long, int64_t> {};
+template <>
+struct sortnet_codec<float, std::less<float>> : sortnet_float_codec<float, int32_t> {};
+template <>
+struct sortnet_codec<double, std::less<double>> : sortnet_float_codec<double, int64_t> {};
+
+// (key, value) pairs of ints are ordered lexicographically by packing the
+// key in the high half and the value, shifted to unsigned, in the low half
+template <>
+struct sortnet_codec<std::pair<int, int>, std::less<std::pair<int, int>>> {
+  static constexpr bool enabled = true;
+  typedef int64_t lane_type;
+  static lane_type encode(const std::pair<int, int>& x) {
+    return (lane_type) (((uint64_t) (uint32_t) x.first << 32) | ((uint32_t) x.second ^ 0x80000000u));
+  }
+  static std::pair<int, int> decode(lane_type x) {
+    return std::make_pair((int) (x >> 32), (int) ((uint32_t) x ^ 0x80000000u));
+  }
+};
+
+// descending orders reuse the ascending encoding with the lane order reversed
+template <class E>
+struct sortnet_codec<E, std::greater<E>> {
+  typedef sortnet_codec<E, std::less<E>> ascending;
+  static constexpr bool enabled = ascending::enabled;
+  typedef typename ascending::lane_type lane_type;
+  static lane_type encode(const E& x) { return sortnet_flip(ascending::encode(x)); }
+  static E decode(lane_type x) { return ascending::decode(sortnet_flip(x)); }
+};
+
+/*---------------------------------------------------------------------*/
+/* Vector operations */
+
+// Each instance of sortnet_vec gives, for one lane type on one instruction
+// set, the width and the load, store, min, max, lane permutation (lane l
+// reads lane l ^ j) and blend (take the max in the lanes set in a bit mask)
+// used by the network.
+template <class Lane>
+struct sortnet_vec {
+  static constexpr bool enabled = false;
+  static constexpr int width = 1;
+};
+
+#if defined(__AVX512F__)
+
+template <>
+struct sortnet_vec<int32_t> {
+  static constexpr bool enabled = true;
+  static constexpr int width = 16;
+  typedef __m512i vec;
+  typedef __m512i index;
+  typedef __mmask16 mask;
+  static vec load(const int32_t* p) { return _mm512_loadu_si512((const void*) p); }
+  static void store(int32_t* p, vec v) { _mm512_storeu_si512((void*) p, v); }
+  static vec min(vec a, vec b) { return _mm512_min_epi32(a, b); }
+  static vec max(vec a, vec b) { return _mm512_max_epi32(a, b); }
+  static index xor_index(int j) {
+    __m512i iota = _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+    return _mm512_xor_si512(iota, _mm512_set1_epi32(j));
+  }
+  static vec permute(vec v, index idx) { return _mm512_permutexvar_epi32(idx, v); }
+  static mask make_mask(unsigned bits) { return (mask) bits; }
+  static vec blend(vec mn, vec mx, mask m) { return _mm512_mask_blend_epi32(m, mn, mx); }
+};
+
+template <>
+struct sortnet_vec<int64_t> {
+  static constexpr bool enabled = true;
+  static constexpr int width = 8;
+  typedef __m512i vec;
+  typedef __m512i index;
+  typedef __mmask8 mask;
+  static vec load(const int64_t* p) { return _mm512_loadu_si512((const void*) p); }
+  static void store(int64_t* p, vec v) { _mm512_storeu_si512((void*) p, v); }
+  static vec min(vec a, vec b) { return _mm512_min_epi64(a, b); }
+  static vec max(vec a, vec b) { return _mm512_max_epi64(a, b); }
+  static index xor_index(int j) {
+    __m512i iota = _mm512_setr_epi64(0, 1, 2, 3, 4, 5, 6, 7);
+    return _mm512_xor_si512(iota, _mm512_set1_epi64(j));
+  }
+  static vec permute(vec v, index idx) { return _mm512_permutexvar_epi64(idx, v); }
+  static mask make_mask(unsigned bits) { return (mask) bits; }
+  static vec blend(vec mn, vec mx, mask m) { return _mm512_mask_blend_epi64(m, mn, mx); }
+};
+
+#elif defined(__AVX2__)
+
+// AVX2 masks are vectors with all bits set in the selected lanes. Masks and
+// indices are computed in registers rather than loaded from the stack, which
+// would stall on store forwarding at every stage.
+inline __m256i sortnet_avx2_mask32(unsigned bits) {
+  __m256i lane_bit = _mm256_setr_epi32(1, 2, 4, 8, 16, 32, 64, 128);
+  return _mm256_cmpeq_epi32(_mm256_and_si256(_mm256_set1_epi32(bits), lane_bit), lane_bit);
+}
+
+inline __m256i sortnet_avx2_mask64(unsigned bits) {
+  __m256i lane_bit = _mm256_setr_epi64x(1, 2, 4, 8);
+  return _mm256_cmpeq_epi64(_mm256_and_si256(_mm256_set1_epi64x(bits), lane_bit), lane_bit);
+}
+
+// 64-bit lanes are permuted as pairs of 32-bit lanes: 32-bit lane 2l + s
+// reads 2(l ^ j) + s = (2l + s) ^ 2j
+template <int width>
+__m256i sortnet_avx2_xor_index(int j) {
+  __m256i iota = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+  return _mm256_xor_si256(iota, _mm256_set1_epi32(j * (8 / width)));
+}
+
+template <>
+struct sortnet_vec<int32_t> {
+  static constexpr bool enabled = true;
+  static constexpr int width = 8;
+  typedef __m256i vec;
+  typedef __m256i index;
+  typedef __m256i mask;
+  static vec load(const int32_t* p) { return _mm256_loadu_si256((const __m256i*) p); }
+  static void store(int32_t* p, vec v) { _mm256_storeu_si256((__m256i*) p, v); }
+  static vec min(vec a, vec b) { return _mm256_min_epi32(a, b); }
+  static vec max(vec a, vec b) { return _mm256_max_epi32(a, b); }
+  static index xor_index(int j) { return sortnet_avx2_xor_index<8>(j); }
+  static vec permute(vec v, index idx) { return _mm256_permutevar8x32_epi32(v, idx); }
+  static mask make_mask(unsigned bits) { return sortnet_avx2_mask32(bits); }
+  static vec blend(vec mn, vec mx, mask m) { return _mm256_blendv_epi8(mn, mx, m); }
+};
+
+// AVX2 has no 64-bit min and max: they are built from a comparison
+template <>
+struct sortnet_vec<int64_t> {
+  static constexpr bool enabled = true;
+  static constexpr int width = 4;
+  typedef __m256i vec;
+  typedef __m256i index;
+  typedef __m256i mask;
+  static vec load(const int64_t* p) { return _mm256_loadu_si256((const __m256i*) p); }
+  static void store(int64_t* p, vec v) { _mm256_storeu_si256((__m256i*) p, v); }
+  static vec min(vec a, vec b) { return _mm256_blendv_epi8(a, b, _mm256_cmpgt_epi64(a, b)); }
+  static vec max(vec a, vec b) { return _mm256_blendv_epi8(b, a, _mm256_cmpgt_epi64(a, b)); }
+  static index xor_index(int j) { return sortnet_avx2_xor_index<4>(j); }
+  static vec permute(vec v, index idx) { return _mm256_permutevar8x32_epi32(v, idx); }
+  static mask make_mask(unsigned bits) { return sortnet_avx2_mask64(bits); }
+  static vec blend(vec mn, vec mx, mask m) { return _mm256_blendv_epi8(mn, mx, m); }
+};
+
+#endif
+
+/*---------------------------------------------------------------------*/
+/* Network */
+
+// Bit mask of the lanes l with l & j != 0, for j a power of two below 16
+inline unsigned sortnet_lane_bits(int j) {
+  switch (j) {
+    case 1: return 0xAAAA;
+    case 2: return 0xCCCC;
+    case 4: return 0xF0F0;
+    default: return 0xFF00;
+  }
+}
+
+// Bitonic sort of buf[0, p) in ascending order, where p is a power of two
+// and a multiple of the vector width. Stage (k, j) compares lanes at
+// distance j inside blocks of k lanes sorted alternately up and down. When
+// j is at least the width the two lanes sit in different vectors; otherwise
+// the partner lanes are brought in by a permutation and a blend picks, in
+// each lane, the min or the max.
+template <class Lane, int p>
+inline void sortnet_bitonic(Lane* buf) {
+  typedef sortnet_vec<Lane> V;
+  const int w = V::width;
+  for (int k = 2; k <= p; k *= 2) {
+    for (int j = k / 2; j > 0; j /= 2) {
+      if (j >= w) {
+        for (int i = 0; i < p; i += w) {
+          if (i & j) {
+            continue;
+          }
+          auto a = V::load(buf + i);
+          auto b = V::load(buf + i + j);
+          auto mn = V::min(a, b);
+          auto mx = V::max(a, b);
+          bool up = (i & k) == 0;
+          V::store(buf + i, up ? mn : mx);
+          V::store(buf + i + j, up ? mx : mn);
+        }
+      } else {
+        unsigned all = (1u << w) - 1;
+        unsigned up_bits = (sortnet_lane_bits(j) ^ ((k < w) ? sortnet_lane_bits(k) : 0)) & all;
+        auto idx = V::xor_index(j);
+        auto up_mask = V::make_mask(up_bits);
+        auto down_mask = V::make_mask(~up_bits & all);
+        for (int i = 0; i < p; i += w) {
+          auto a = V::load(buf + i);
+          auto b = V::permute(a, idx);
+          bool up = (k < w) || (i & k) == 0;
+          V::store(buf + i, V::blend(V::min(a, b), V::max(a, b), up ? up_mask : down_mask));
+        }
+      }
+    }
+  }
+}
+
+// The network is only instantiated for the lane types that have vector
+// operations on the target
+template <class Lane, bool enabled = sortnet_vec<Lane>::enabled>
+struct sortnet_kernel {
+  // the size is made a constant so that the stages get unrolled
+  static void sort(Lane* buf, int p) {
+    switch (p) {
+      case 4: sortnet_bitonic<Lane, 4>(buf); break;
+      case 8: sortnet_bitonic<Lane, 8>(buf); break;
+      case 16: sortnet_bitonic<Lane, 16>(buf); break;
+      case 32: sortnet_bitonic<Lane, 32>(buf); break;
+      default: sortnet_bitonic<Lane, SORTNET_MAX>(buf); break;
+    }
+  }
+};
+
+template <class Lane>
+struct sortnet_kernel<Lane, false> {
+  static void sort(Lane*, int) {}
+};
+
+// True when blocks of E ordered by BinPred can be sorted by the network
+template <class E, class BinPred>
+struct sorting_network_enabled {
+  typedef sortnet_codec<E, BinPred> codec;
+  static constexpr bool value = codec::enabled && sortnet_vec<typename codec::lane_type>::enabled;
+};
+
+// Sorts a[0, n) with the network and returns true, or returns false without
+// touching a if the type is not supported or n exceeds SORTNET_MAX.
+template <class E, class BinPred, class intT>
+bool sorting_network_sort(E* a, intT n, BinPred) {
+  typedef sortnet_codec<E, BinPred> codec;
+  typedef typename codec::lane_type lane_type;
+  if (! sorting_network_enabled<E, BinPred>::value || n > SORTNET_MAX) {
+    return false;
+  }
+  lane_type buf[SORTNET_MAX];
+  int p = sortnet_vec<lane_type>::width;
+  while (p < n) {
+    p *= 2;
+  }
+  for (intT i = 0; i < n; i++) {
+    buf[i] = codec::encode(a[i]);
+  }
+  for (int i = (int) n; i < p; i++) {
+    buf[i] = std::numeric_limits<lane_type>::max();
+  }
+  sortnet_kernel<lane_type>::sort(buf, p);
+  for (intT i = 0; i < n; i++) {
+    a[i] = codec::decode(buf[i]);
+  }
+  return true;
+}
+
+} // end namespace
+} // end namespace
+
+#endif /*! _PBBS_PCTL_SORTINGNETWORK_H_ */
@@ -0,0 +1,174 @@
+/* COPYRIGHT (c) 2015 Umut Acar, Arthur Chargueraud, and Michael
+ * Rainey
+ * All rights reserved.
+ *
+ * \file stringintern.hpp
+ * \brief Parallel string interning (dictionary encoding)
+ *
+ */
+
+#include <cstring>
+#include <stdint.h>
+#include <utility>
+#include "datapar.hpp"
+#include "prandgen.hpp"
+#include "deterministichash.hpp"
+#include "samplesort.hpp"
+
+#ifndef _PBBS_PCTL_STRINGINTERN_H_
+#define _PBBS_PCTL_STRINGINTERN_H_
+
+namespace pasl {
+namespace pctl {
+
+// Interning replaces a sequence of strings by the dense ids of its
+// distinct strings, which are packed in one arena:
+//  - the strings are hashed once, in parallel;
+//  - the numbers of the strings are inserted in the deterministic hash
+//    table, which orders keys by their hash before comparing their
+//    characters, so that most probes cost an integer comparison. Of equal
+//    strings, the first one stays in the table;
+//  - the distinct strings are sorted, so that the ids follow the
+//    lexicographic order: they do not depend on the schedule, and sorting
+//    or comparing the ids sorts or compares the strings;
+//  - every string finds its id through the table.
+
+// Distinct strings, NUL-terminated, in one arena: string id starts at
+// chars[offsets[id]]
+class string_dictionary {
+public:
+
+  parray<char> chars;
+  parray<long> offsets;
+
+  long size() const {
+    return (offsets.size() == 0) ? 0 : offsets.size() - 1;
+  }
+
+  const char* operator[](long id) const {
+    return chars.cbegin() + offsets[id];
+  }
+
+  // Id of s, or -1
+  long find(const char* s) const {
+    long lo = 0;
+    long hi = size();
+    while (lo < hi) {
+      long mid = lo + (hi - lo) / 2;
+      if (std::strcmp((*this)[mid], s) < 0) {
+        lo = mid + 1;
+      } else {
+        hi = mid;
+      }
+    }
+    return (lo < size() && std::strcmp((*this)[lo], s) == 0) ? lo : -1;
+  }
+
+  long size_in_bytes() const {
+    return chars.size() + sizeof(long) * offsets.size();
+  }
+
+};
+
+// Keys of the table: string numbers, with their hashes computed once
+struct hash_interned {
+  typedef int eType;
+  typedef int kType;
+
+  char* const* strings;
+  const unsigned int* hashes;
+
+  hash_interned(char* const* strings, const unsigned int* hashes)
+  : strings(strings), hashes(hashes) { }
+
+  eType empty() const {
+    return -1;
+  }
+
+  kType get_key(eType v) const {
+    return v;
+  }
+
+  uintT hash(kType i) const {
+    return hashes[i];
+  }
+
+  int cmp(kType i, kType j) const {
+    if (hashes[i] != hashes[j]) {
+      return (hashes[i] > hashes[j]) ? 1 : -1;
+    }
+    int c = std::strcmp(strings[i], strings[j]);
+    return (c > 0) ? 1 : ((c == 0) ? 0 : -1);
+  }
+
+  bool replaceQ(eType i, eType j) const {
+    return i < j;
+  }
+};
+
+// ids[i] is the id of a[i] in the dictionary returned
+string_dictionary intern_strings(const parray<char*>& a, parray<int>& ids) {
+  int n = (int) a.size();
+  parray<unsigned int> hashes(n, [&] (int i) {
+    // FNV-1a, then mixed
+    unsigned int h = 2166136261u;
+    for (const char* p = a[i]; *p != 0; p++) {
+      h = (h ^ (unsigned char) *p) * 16777619u;
+    }
+    return prandgen::hashu(h);
+  });
+  Table<hash_interned, int> table(n, hash_interned(a.cbegin(), hashes.cbegin()));
+  parallel_for(0, n, [&] (int i) {
+    table.insert(i);
+  });
+  // the first occurrence of every distinct string, in lexicographic order;
+  // the first 8 characters, read as a big-endian integer, decide most of
+  // the comparisons without reading the strings
+  parray<int> reps = table.entries();
+  int nb = (int) reps.size();
+  parray<std::pair<uint64_t, int>> keys(nb, [&] (int id) {
+    uint64_t prefix = 0;
+    const char* p = a[reps[id]];
+    for (int k = 0; k < 8; k++) {
+      prefix = (prefix << 8) | (unsigned char) *p;
+      if (*p != 0) {
+        p++;
+      }
+    }
+    return std::make_pair(prefix, reps[id]);
+  });
+  reps.clear();
+  sample_sort(keys.begin(), nb, [&] (const std::pair<uint64_t, int>& x, const std::pair<uint64_t, int>& y) {
+    if (x.first != y.first) {
+      return x.first < y.first;
+    }
+    return std::strcmp(a[x.second], a[y.second]) < 0;
+  });
+  parray<int> first(nb, [&] (int id) {
+    return keys[id].second;
+  });
+  keys.clear();
+  string_dictionary dict;
+  dict.offsets = parray<long>(nb + 1, [&] (long id) {
+    return (id == nb) ? 0L : (long) std::strlen(a[first[id]]) + 1;
+  });
+  long total = dps::scan(dict.offsets.begin(), dict.offsets.end(), 0L, [&] (long x, long y) {
+    return x + y;
+  }, dict.offsets.begin(), forward_exclusive_scan);
+  dict.chars = parray<char>(total);
+  parray<int> id_of_first(n);
+  parallel_for(0, nb, [&] (int id) {
+    std::strcpy(dict.chars.begin() + dict.offsets[id], a[first[id]]);
+    id_of_first[first[id]] = id;
+  });
+  ids = parray<int>(n, [&] (int i) {
+    return id_of_first[table.find(i)];
+  });
+  table.del();
+  return dict;
+}
+
+} // end namespace
+} // end namespace
+
+#endif /*! _PBBS_PCTL_STRINGINTERN_H_ */
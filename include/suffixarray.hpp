@@ -32,6 +32,7 @@
 #include "psort.hpp"
 #include "utils.hpp"
 #include "rangemin.hpp"
+#include "prefixdoubling.hpp"
 #ifdef TIME_MEASURE
 #include "timer.hpp"
 #endif
@@ -64,14 +65,17 @@ void radix_sort_pair(pair<intT,intT>* A, intT n, intT m) {
 #endif
 }
 
+template <class intT>
 inline bool leq(intT a1, intT a2, intT b1, intT b2) {
   return a1 < b1 || (a1 == b1 && a2 <= b2);
 }
 
+template <class intT>
 inline bool leq(intT a1, intT a2, intT a3, intT b1, intT b2, intT b3) {
   return a1 < b1 || (a1 == b1 && leq(a2, a3, b2, b3));
 }
 
+template <class intT>
 struct compS {
   intT* _s;
   intT* _s12;
@@ -87,7 +91,8 @@ struct compS {
 
 //struct mod3is1 { bool operator() (intT i) {return i%3 == 1;}};
 
-inline intT compute_LCP(intT* LCP12, intT* rank, myRMQ & RMQ,
+template <class intT>
+inline intT compute_LCP(intT* LCP12, intT* rank, const basic_compact_rmq<intT> & RMQ,
                        intT j, intT k, intT* s, intT n){
   
   intT rank_j = rank[j] - 2;
@@ -114,19 +119,22 @@ pasl::pctl::timer merge_timer;
 #endif
 // This recursive version requires s[n]=s[n+1]=s[n+2] = 0
 // K is the maximum value of any element in s
+// intT is the type of the indices: int, or long for inputs of more than
+// 2^31 characters
+template <class intT>
 void suffix_array_rec(intT* s, intT n, intT K, bool find_LCP,
                     parray<intT>& suffixes, parray<intT>& LCP) {
   n = n + 1;
   intT n0 = (n + 2) / 3; //suffixes with mod 3 = 0 start position
   intT n1 = (n + 1) / 3; //suffixes with mod 3 = 1 start position
   intT n12 = n - n0; //suffixes with mod 3 = 1,2 start positions
-  intT bits = utils::logUp(K);
+  intT bits = utils::log2Up(K);
   //  parray<pair<intT, intT>> compressed;
   pair<intT,intT> *compressed = (pair<intT,intT> *) malloc(n12*sizeof(pair<intT,intT>));
   
-  // if 3 chars fit into an int then just do one radix sort
-  if (bits < 11) {
-    parallel_for(0, n12, [&] (intT i) {
+  // if 3 chars fit into an intT then just do one radix sort
+  if (3 * bits <= 8 * (int) sizeof(intT) - 2) {
+    parallel_for((intT)0, n12, [&] (intT i) {
       intT j = 1 + (i + i + i) / 2; // only mod 3 = 1, 2
       compressed[i].first = (s[j] << 2*bits) + (s[j+1] << bits) + s[j+2];
       compressed[i].second = j;
@@ -135,7 +143,7 @@ void suffix_array_rec(intT* s, intT n, intT K, bool find_LCP,
     
     // otherwise do 3 radix sorts, one per char
   } else {
-    parallel_for(0, n12, [&] (intT i) {
+    parallel_for((intT)0, n12, [&] (intT i) {
       intT j = 1 + (i + i + i) / 2;
       compressed[i].first = s[j+2]; 
       compressed[i].second = j;
@@ -162,12 +170,12 @@ void suffix_array_rec(intT* s, intT n, intT K, bool find_LCP,
   // generate names based on 3 chars
   parray<intT> name_triples(n12, [&] (intT i) {
     if (i == 0)
-      return 1;
+      return (intT)1;
     else if (s[sorted_triples[i]] != s[sorted_triples[i - 1]]
         || s[sorted_triples[i] + 1] != s[sorted_triples[i - 1] + 1]
         || s[sorted_triples[i] + 2] != s[sorted_triples[i - 1] + 2])
-      return 1;
-    else return 0;
+      return (intT)1;
+    else return (intT)0;
   });
   intT id = 0;
 #ifdef PBBS_SEQUENCE
@@ -294,7 +302,7 @@ void suffix_array_rec(intT* s, intT n, intT K, bool find_LCP,
     main_timer.clear();
     main_timer.start();
 #endif
-  compS comp(s, rank.begin());
+  compS<intT> comp(s, rank.begin());
   intT o = (n % 3 == 1) ? 1 : 0;
   suffixes.prefix_tabulate(n, 0);
   auto suffixes0beg = suffixes0.begin() + o;
@@ -311,7 +319,7 @@ void suffix_array_rec(intT* s, intT n, intT K, bool find_LCP,
   if (find_LCP) {
     LCP.prefix_tabulate(n, 0);
     LCP[n - 1] = LCP[n - 2] = 0;
-    myRMQ RMQ(LCP12.begin(), n12 + 3); //simple rmq
+    basic_compact_rmq<intT> RMQ(LCP12.begin(), n12 + 3);
     parallel_for((intT)0, n-2, [&] (intT i) {
       intT j = suffixes[i];
       intT k = suffixes[i + 1];
@@ -341,7 +349,7 @@ void suffix_array_rec(intT* s, intT n, intT K, bool find_LCP,
 #endif
 }
 
-template <class CharT>
+template <class CharT, class intT>
 void suffix_array(CharT* s, intT n, bool find_LCP,
                  parray<intT>& suffixes, parray<intT>& LCP) {
   parray<intT> ss;
@@ -362,8 +370,17 @@ void suffix_array(CharT* s, intT n, bool find_LCP,
   suffixes.resize(n);
 }
 
+// Engines for suffix_array(s, n, algorithm); only DC3 also finds the LCP
+enum suffix_array_algorithm {
+  suffix_array_dc3,
+  suffix_array_prefix_doubling
+};
+
 template <class CharT>
-parray<intT> suffix_array(CharT* s, intT n) {
+parray<intT> suffix_array(CharT* s, intT n, suffix_array_algorithm algorithm = suffix_array_dc3) {
+  if (algorithm == suffix_array_prefix_doubling) {
+    return suffix_array_doubling(s, n);
+  }
   parray<intT> suffixes;
   parray<intT> LCP;
   suffix_array(s, n, false, suffixes, LCP);
@@ -373,6 +390,39 @@ parray<intT> suffix_array(CharT* s, intT n) {
 #endif
   return suffixes;
 }
+
+// Converts a suffix array of longs to Index, consuming it
+template <class Index>
+parray<Index> suffix_array_pack(parray<long>& suffixes) {
+  parray<Index> result(suffixes.size(), [&] (long i) {
+    return (Index) suffixes[i];
+  });
+  suffixes.clear();
+  return result;
+}
+
+template <>
+inline parray<long> suffix_array_pack<long>(parray<long>& suffixes) {
+  parray<long> result;
+  result.swap(suffixes);
+  return result;
+}
+
+// Suffix array of inputs of more than 2^31 characters. Index is long, or
+// uint40 to store 5 bytes per suffix. The prefix-doubling engine works on
+// arrays of Index throughout; DC3 works on longs and packs its result.
+// suffix_array(s, (long) n, find_LCP, suffixes, LCP) gives the LCP of
+// large inputs as well.
+template <class Index, class CharT>
+parray<Index> suffix_array_large(CharT* s, long n, suffix_array_algorithm algorithm = suffix_array_dc3) {
+  if (algorithm == suffix_array_prefix_doubling) {
+    return suffix_array_doubling<CharT, Index>(s, n);
+  }
+  parray<long> suffixes;
+  parray<long> LCP;
+  suffix_array(s, n, false, suffixes, LCP);
+  return suffix_array_pack<Index>(suffixes);
+}
     
 } // end namespace
 } // end namespace
@@ -0,0 +1,281 @@
+/* COPYRIGHT (c) 2015 Umut Acar, Arthur Chargueraud, and Michael
+ * Rainey
+ * All rights reserved.
+ *
+ * \file textindex.hpp
+ * \brief Full-text index over a suffix array, with batched queries
+ *
+ */
+
+#include <string>
+#include <cstdlib>
+#include <memory>
+#include <utility>
+#include "datapar.hpp"
+#include "suffixarray.hpp"
+#include "lcp.hpp"
+#include "rangemin.hpp"
+
+#ifndef _PBBS_PCTL_TEXTINDEX_H_
+#define _PBBS_PCTL_TEXTINDEX_H_
+
+namespace pasl {
+namespace pctl {
+
+// A text_index bundles a text with its suffix array, its LCP array and a
+// range-minimum structure over the LCP. The suffixes starting with a
+// pattern are a range of the suffix array, found by
+//  - a lookup table giving, for every string of TEXT_INDEX_LOOKUP_CHARS
+//    characters, the first suffix not smaller than it, which narrows the
+//    search to the suffixes that share the first characters of the pattern;
+//  - a binary search that keeps the lcp of the pattern with both ends of
+//    the interval (Manber and Myers). The middle suffix shares at least
+//    the smaller of the two with the pattern. When the larger one exceeds
+//    it by more than TEXT_INDEX_RMQ_GAIN characters, the lcp of the middle
+//    suffix with that end, found by a range-minimum query over the LCP,
+//    decides the comparison or says where to resume it. The search thus
+//    costs O(m + log n) character comparisons for a pattern of length m,
+//    and pays for range-minimum queries only when they skip enough;
+//  - a galloping search over the LCP for the end of the range.
+// count and locate answer batches of patterns in parallel. Index is the
+// type of the suffix array: int, or long for texts of more than 2^31
+// characters.
+
+// Length of the strings of the lookup table, which has 256^k entries
+#define TEXT_INDEX_LOOKUP_CHARS 2
+// Characters a range-minimum query must save to be worth its cost
+#define TEXT_INDEX_RMQ_GAIN 64
+
+// Positions of the occurrences of a batch of patterns: those of pattern i
+// are positions[offsets[i], offsets[i + 1])
+template <class Index>
+struct text_index_matches {
+  parray<long> offsets;
+  parray<Index> positions;
+};
+
+template <class CharT>
+parray<intT> text_index_suffix_array(CharT* s, long n, suffix_array_algorithm algorithm, intT) {
+  return suffix_array(s, (intT) n, algorithm);
+}
+
+template <class CharT>
+parray<long> text_index_suffix_array(CharT* s, long n, suffix_array_algorithm algorithm, long) {
+  return suffix_array_large<long>(s, n, algorithm);
+}
+
+template <class Index = intT>
+class text_index {
+public:
+
+  using uchar = unsigned char;
+
+  parray<uchar> text;
+  parray<Index> SA;
+  parray<Index> LCP;
+
+private:
+
+  static constexpr long nb_keys = 1L << (8 * TEXT_INDEX_LOOKUP_CHARS);
+
+  parray<Index> table;
+  std::unique_ptr<basic_compact_rmq<Index>> rmq;
+
+  long key_of(const uchar* p, long m, uchar pad) const {
+    long key = 0;
+    for (int t = 0; t < TEXT_INDEX_LOOKUP_CHARS; t++) {
+      key = (key << 8) | ((t < m) ? p[t] : pad);
+    }
+    return key;
+  }
+
+  // Suffixes shorter than the table strings are padded with zeros, which
+  // keeps the keys in the order of the suffix array
+  long key_of_suffix(long i) const {
+    long n = size();
+    return key_of(text.cbegin() + i, n - i, 0);
+  }
+
+  void build() {
+    long n = size();
+    table = parray<Index>(nb_keys + 1, (Index) n);
+    parallel_for(0L, n, [&] (long i) {
+      long key = key_of_suffix(SA[i]);
+      if (i == 0 || key != key_of_suffix(SA[i - 1])) {
+        table[key] = (Index) i;
+      }
+    });
+    dps::scan(table.begin(), table.end(), (Index) n, [&] (Index x, Index y) {
+      return std::min(x, y);
+    }, table.begin(), backward_inclusive_scan);
+    if (n > 1) {
+      rmq.reset(new basic_compact_rmq<Index>(LCP.cbegin(), (Index) (n - 1)));
+    }
+  }
+
+  // lcp of suffixes SA[i] and SA[j], for i < j
+  long lcp_of_ranks(long i, long j) const {
+    return (j == i + 1) ? LCP[i] : LCP[rmq->query((Index) i, (Index) (j - 1))];
+  }
+
+  // Extends a match of h characters of p with the suffix of rank i
+  long extend(const uchar* p, long m, long i, long h) const {
+    long n = size();
+    long s = SA[i];
+    while (h < m && s + h < n && text[s + h] == p[h]) {
+      h++;
+    }
+    return h;
+  }
+
+public:
+
+  text_index() { }
+
+  // Builds the suffix array and the LCP of s[0, n)
+  text_index(const char* s, long n, suffix_array_algorithm algorithm = suffix_array_dc3)
+  : text(n, [&] (long i) {
+      return (uchar) s[i];
+    }) {
+    SA = text_index_suffix_array(text.begin(), n, algorithm, (Index) 0);
+    LCP = lcp_array(text.cbegin(), SA);
+    build();
+  }
+
+  // Index over a text whose suffix array and LCP are already known
+  text_index(parray<uchar>&& _text, parray<Index>&& _SA, parray<Index>&& _LCP)
+  : text(std::move(_text)), SA(std::move(_SA)), LCP(std::move(_LCP)) {
+    build();
+  }
+
+  long size() const {
+    return text.size();
+  }
+
+  // The range [lo, hi) of the suffix array of the suffixes starting with
+  // p[0, m)
+  std::pair<long, long> range(const char* _p, long m) const {
+    const uchar* p = (const uchar*) _p;
+    long n = size();
+    if (m == 0 || n == 0) {
+      return std::make_pair(0L, n);
+    }
+    long lo = table[key_of(p, m, 0)];
+    long hi = table[key_of(p, std::min(m, (long) TEXT_INDEX_LOOKUP_CHARS), 255) + 1];
+    // the suffix at L is smaller than p and the one at R is not; l and r
+    // are their lcps with p, with virtual ends at lo - 1 and hi
+    long L = lo - 1;
+    long R = hi;
+    long l = 0;
+    long r = 0;
+    while (R - L > 1) {
+      long M = L + (R - L) / 2;
+      long h;
+      if (std::abs(l - r) <= TEXT_INDEX_RMQ_GAIN) {
+        h = std::min(l, r);
+      } else if (l > r) {
+        if (L >= lo) {
+          long ml = lcp_of_ranks(L, M);
+          if (ml > l) {
+            L = M;
+            continue;
+          } else if (ml < l) {
+            R = M;
+            r = ml;
+            continue;
+          }
+        }
+        h = l;
+      } else {
+        if (R < hi) {
+          long mr = lcp_of_ranks(M, R);
+          if (mr > r) {
+            R = M;
+            continue;
+          } else if (mr < r) {
+            L = M;
+            l = mr;
+            continue;
+          }
+        }
+        h = r;
+      }
+      h = extend(p, m, M, h);
+      long s = SA[M];
+      if (h == m || (s + h < n && text[s + h] > p[h])) {
+        R = M;
+        r = h;
+      } else {
+        L = M;
+        l = h;
+      }
+    }
+    if (R == hi || r < m) {
+      return std::make_pair(R, R);
+    }
+    // gallop, then bisect, to the first suffix sharing less than m
+    // characters with the suffix at R
+    long first = R;
+    long step = 1;
+    long last = first;
+    while (last + step < hi && lcp_of_ranks(first, last + step) >= m) {
+      last += step;
+      step *= 2;
+    }
+    long end = std::min(hi, last + step);
+    while (end - last > 1) {
+      long mid = last + (end - last) / 2;
+      if (lcp_of_ranks(first, mid) >= m) {
+        last = mid;
+      } else {
+        end = mid;
+      }
+    }
+    return std::make_pair(first, last + 1);
+  }
+
+  // Text, suffix array, LCP, lookup table and range-minimum structure
+  long size_in_bytes() const {
+    long bytes = size() * (1 + 2 * sizeof(Index)) + sizeof(Index) * table.size();
+    return bytes + ((rmq) ? rmq->size_in_bytes() : 0);
+  }
+
+  long count(const std::string& p) const {
+    std::pair<long, long> r = range(p.c_str(), p.length());
+    return r.second - r.first;
+  }
+
+  parray<long> count(const parray<std::string>& patterns) const {
+    return parray<long>(patterns.size(), [&] (long i) {
+      return count(patterns[i]);
+    });
+  }
+
+  text_index_matches<Index> locate(const parray<std::string>& patterns) const {
+    long nb = patterns.size();
+    parray<std::pair<long, long>> ranges(nb, [&] (long i) {
+      return range(patterns[i].c_str(), patterns[i].length());
+    });
+    text_index_matches<Index> result;
+    result.offsets = parray<long>(nb + 1, [&] (long i) {
+      return (i == nb) ? 0L : ranges[i].second - ranges[i].first;
+    });
+    long total = dps::scan(result.offsets.begin(), result.offsets.end(), 0L, [&] (long x, long y) {
+      return x + y;
+    }, result.offsets.begin(), forward_exclusive_scan);
+    result.positions.prefix_tabulate(total, 0);
+    auto complexity_fct = [&] (long lo, long hi) {
+      return result.offsets[hi] - result.offsets[lo];
+    };
+    range::parallel_for(0L, nb, complexity_fct, [&] (long i) {
+      pmem::copy(SA.cbegin() + ranges[i].first, SA.cbegin() + ranges[i].second, result.positions.begin() + result.offsets[i]);
+    });
+    return result;
+  }
+
+};
+
+} // end namespace
+} // end namespace
+
+#endif /*! _PBBS_PCTL_TEXTINDEX_H_ */
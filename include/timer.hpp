@@ -26,13 +26,17 @@ public:
     double d = duration.count();
     total_time += d;
     return d;
+#else
+    return 0.0;
 #endif
   }
 
   double end(std::string s) {
+    double d = end();
 #ifdef TIME_MEASURE
-    printf("exectime %s %.3lf\n", s.c_str(), end());
+    printf("exectime %s %.3lf\n", s.c_str(), d);
 #endif
+    return d;
   }
 
   void report_total(std::string s) {
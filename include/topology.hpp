@@ -25,7 +25,7 @@
 
 #include <iostream>
 #include "geometry.hpp"
-#include "deterministichash.hpp"
+#include "halfedge.hpp"
 
 namespace pasl {
 namespace pctl {
@@ -231,34 +231,15 @@ struct simplex {
   
 };
 
-typedef pair<intT, intT> pairInt;
-typedef pair<pairInt, tri*> edge;
-  
-// Hash table to store skinny triangles
-struct hashEdges {
-  typedef pairInt kType;
-  typedef edge* eType;
-  eType empty() {return NULL;}
-  kType get_key(eType v) { return v->first;}
-  uintT hash(kType s) { return prandgen::hashi(s.first)+3*(prandgen::hashi(s.second)); }
-  int cmp(kType s1, kType s2) {
-    return ((s1.first > s2.first) ? 1 :
-            (s1.first < s2.first) ? -1 :
-            (s1.second > s2.second) ? 1 :
-            (s1.second < s2.second) ? -1 : 0);
-  }
-  bool replaceQ(eType s, eType s2) {return 0;}
-};
-
-typedef Table<hashEdges,intT> EdgeTable;
-EdgeTable makeEdgeTable(intT m) {return EdgeTable(m,hashEdges());}
-  
+// The neighbors are found by the sorting of the half-edges done by
+// halfedge_mesh. Like halfedge_mesh, this silently turns the triangles of
+// Tri given clockwise around, so it cannot be used to check the
+// orientation of Tri: the vertices of every tri come out counterclockwise.
 void topologyFromTriangles(triangles<point2d> Tri, parray<vertex>& vr, parray<tri>& tr) {
   intT n = Tri.num_points;
   point2d* P = Tri.p;
   
   intT m = Tri.num_triangles;
-  triangle* T = Tri.t;
   
   if (vr.size() == 0) {
     vr.prefix_tabulate(n, 0);
@@ -272,34 +253,21 @@ void topologyFromTriangles(triangles<point2d> Tri, parray<vertex>& vr, parray<tr
     tr.prefix_tabulate(m, 0);
   }//*tr = newA(tri,m);
   tri* Triangs = tr.begin();
-  parray<edge> E;
-  E.prefix_tabulate(m * 3, 0);
-  EdgeTable ET = makeEdgeTable(m*6);
-  parallel_for((intT)0, m, [&] (intT i) {
-    Triangs[i] = tri();
-    for (int j=0; j<3; j++) {
-      E[i*3 + j] = edge(pairInt(T[i].vertices[j], T[i].vertices[(j+1)%3]), &Triangs[i]);
-      ET.insert(&E[i*3+j]);
-      Triangs[i].vtx[(j+2)%3] = &v[T[i].vertices[j]];
-    }
-  });
+  halfedge_mesh mesh(Tri);
   
   parallel_for((intT)0, m, [&] (intT i) {
+    Triangs[i] = tri();
     Triangs[i].id = i;
     Triangs[i].initialized = 1;
     Triangs[i].bad = 0;
     for (int j=0; j<3; j++) {
-      pairInt key = pairInt(T[i].vertices[(j+1)%3], T[i].vertices[j]);
-      edge *Ed = ET.find(key);
-      if (Ed != NULL) Triangs[i].ngh[j] = Ed->second;
-      else { Triangs[i].ngh[j] = NULL;
-        //Triangs[i].vtx[j]->boundary = 1;
-        //Triangs[i].vtx[(j+2)%3]->boundary = 1;
-      }
+      int h = 3 * i + j;
+      Triangs[i].vtx[(j+2)%3] = &v[mesh.origin[h]];
+      int g = mesh.twin[h];
+      if (g >= 0) Triangs[i].ngh[j] = &Triangs[halfedge_mesh::face(g)];
+      else Triangs[i].ngh[j] = NULL;
     }
   });
-  
-  ET.del();
 }
   
 } // end namespace
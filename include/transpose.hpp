@@ -50,7 +50,7 @@ void transpose(E* A, E* B,
 
 template <class E, class intT>
 void transpose(E* A, E* B, intT rCount, intT cCount) {
-  transpose(A, B, 0,rCount,cCount,0,cCount,rCount);
+  transpose(A, B, (intT)0,rCount,cCount,(intT)0,cCount,rCount);
 }
 
   
@@ -69,7 +69,7 @@ void block_transpose(E *A, E *B, intT *OA, intT *OB, intT *L,
         for (intT k=0; k < l; k++) *(pb++) = *(pa++);
       }
   };
-  int total = cCount * rCount;
+  intT total = cCount * rCount;
 /*  for (intT i = rStart; i < rStart + rCount; i++) {
     total += OA[i * rLength + (cStart + cCount - 1)] - OA[i * rLength + cStart] + L[i * rLength + (cStart + cCount - 1)];
   }*/
@@ -105,7 +105,7 @@ void block_transpose(E *A, E *B, intT *OA, intT *OB, intT *L,
 template <class E, class intT>
 void block_transpose(E *A, E *B, intT *OA, intT *OB, intT *L,
                      intT rCount, intT cCount) {
-  block_transpose(A, B, OA, OB, L, 0,rCount,cCount,0,cCount,rCount);
+  block_transpose(A, B, OA, OB, L, (intT)0,rCount,cCount,(intT)0,cCount,rCount);
 
 }
   
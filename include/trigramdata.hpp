@@ -0,0 +1,540 @@
+/* COPYRIGHT (c) 2015 Umut Acar, Arthur Chargueraud, and Michael
+ * Rainey
+ * All rights reserved.
+ *
+ * \file trigramdata.hpp
+ * \brief Trigram frequencies of English text
+ *
+ */
+
+#ifndef _PBBS_PCTL_TRIGRAMDATA_H_
+#define _PBBS_PCTL_TRIGRAMDATA_H_
+
+namespace pasl {
+namespace pctl {
+
+// The table of bench/trigrams.txt: for a context of two characters, '_'
+// standing for a word boundary, the characters that may follow and their
+// probabilities
+struct trigram_entry {
+  const char* context;
+  const char* chars;
+  float probs[27];
+};
+
+static const int nb_trigram_entries = 507;
+
+static const trigram_entry trigram_entries[] = {
+  {"sv", "i", {1.0f}},
+  {"gf", "u", {1.0f}},
+  {"wy", "e", {1.0f}},
+  {"kr", "o", {1.0f}},
+  {"bn", "o", {1.0f}},
+  {"rj", "u", {1.0f}},
+  {"pb", "o", {1.0f}},
+  {"dc", "ah", {0.25f, 0.75f}},
+  {"fc", "h", {1.0f}},
+  {"uh", "a", {1.0f}},
+  {"kh", "e", {1.0f}},
+  {"fm", "a", {1.0f}},
+  {"wp", "a", {1.0f}},
+  {"dh", "o", {1.0f}},
+  {"ku", "l", {1.0f}},
+  {"ae", "s_", {0.6667f, 0.3333f}},
+  {"xq", "u", {1.0f}},
+  {"td", "i", {1.0f}},
+  {"wk", "s_iw", {0.1429f, 0.1429f, 0.2857f, 0.4286f}},
+  {"pw", "ar", {0.5f, 0.5f}},
+  {"yc", "ar", {0.5f, 0.5f}},
+  {"kg", "ur", {0.3333f, 0.6667f}},
+  {"lh", "ea", {0.5f, 0.5f}},
+  {"hh", "eo", {0.5f, 0.5f}},
+  {"tp", "oe", {0.75f, 0.25f}},
+  {"km", "e", {1.0f}},
+  {"lz", "e", {1.0f}},
+  {"mv", "a", {1.0f}},
+  {"pk", "i", {1.0f}},
+  {"yf", "u", {1.0f}},
+  {"z_", "_", {1.0f}},
+  {"tg", "u", {1.0f}},
+  {"yp", "aiose", {0.1f, 0.1f, 0.6f, 0.1f, 0.1f}},
+  {"gb", "o", {1.0f}},
+  {"yh", "o", {1.0f}},
+  {"v_", "_", {1.0f}},
+  {"mh", "e", {1.0f}},
+  {"ih", "ti", {0.3333f, 0.6667f}},
+  {"ko", "uon", {0.05556f, 0.02778f, 0.9167f}},
+  {"pm", "ae", {0.1053f, 0.8947f}},
+  {"nz", "e", {1.0f}},
+  {"tb", "aour", {0.125f, 0.25f, 0.25f, 0.375f}},
+  {"cb", "e", {1.0f}},
+  {"yd", "a", {1.0f}},
+  {"xy", "s", {1.0f}},
+  {"xo", "tr", {0.5f, 0.5f}},
+  {"gm", "a_e", {0.3333f, 0.09524f, 0.5714f}},
+  {"cs", "_t", {0.84f, 0.16f}},
+  {"aa", "l", {1.0f}},
+  {"hn", "e_", {0.55f, 0.45f}},
+  {"np", "ealo", {0.1f, 0.4f, 0.3f, 0.2f}},
+  {"_z", "eo", {0.625f, 0.375f}},
+  {"yz", "e", {1.0f}},
+  {"oz", "e", {1.0f}},
+  {"dp", "lo", {0.5f, 0.5f}},
+  {"bh", "o", {1.0f}},
+  {"yw", "h", {1.0f}},
+  {"zl", "ie", {0.25f, 0.75f}},
+  {"yr", "oi_ads", {0.05556f, 0.1111f, 0.2222f, 0.1111f, 0.2778f, 0.2222f}},
+  {"xu", "rl", {0.4f, 0.6f}},
+  {"ox", "_yi", {0.6452f, 0.03226f, 0.3226f}},
+  {"dk", "e", {1.0f}},
+  {"wf", "u", {1.0f}},
+  {"hd", "ar", {0.08696f, 0.913f}},
+  {"uy", "o_n", {0.125f, 0.75f, 0.125f}},
+  {"yn", "ixe", {0.3333f, 0.3333f, 0.3333f}},
+  {"ax", "ie_a", {0.3125f, 0.125f, 0.5f, 0.0625f}},
+  {"uz", "ez", {0.2857f, 0.7143f}},
+  {"zz", "li", {0.7273f, 0.2727f}},
+  {"lg", "aei", {0.2857f, 0.5f, 0.2143f}},
+  {"xh", "ia", {0.2143f, 0.7857f}},
+  {"zu", "r", {1.0f}},
+  {"aq", "u", {1.0f}},
+  {"kf", "ua", {0.02564f, 0.9744f}},
+  {"aj", "aoe", {0.02041f, 0.1071f, 0.8724f}},
+  {"uj", "a", {1.0f}},
+  {"ji", "n", {1.0f}},
+  {"mf", "o", {1.0f}},
+  {"bd", "u", {1.0f}},
+  {"iq", "u", {1.0f}},
+  {"ln", "e", {1.0f}},
+  {"mc", "h", {1.0f}},
+  {"wc", "o", {1.0f}},
+  {"ao", "sr", {0.1667f, 0.8333f}},
+  {"ym", "saep", {0.1f, 0.05f, 0.3f, 0.55f}},
+  {"b_", "_", {1.0f}},
+  {"dj", "ou", {0.625f, 0.375f}},
+  {"bj", "ue", {0.01429f, 0.9857f}},
+  {"bb", "uyolaie", {0.01053f, 0.01053f, 0.05263f, 0.03158f, 0.1158f, 0.08421f, 0.6947f}},
+  {"sr", "eo", {0.375f, 0.625f}},
+  {"eo", "_iclvurnp", {0.004831f, 0.004831f, 0.06763f, 0.07729f, 0.03865f, 0.1014f, 0.03865f, 0.3043f, 0.3623f}},
+  {"ez", "_eiv", {0.2593f, 0.1481f, 0.07407f, 0.5185f}},
+  {"zv", "o", {1.0f}},
+  {"kl", "aiye", {0.01333f, 0.04f, 0.72f, 0.2267f}},
+  {"ka", "rnxgdbtl", {0.04348f, 0.04348f, 0.04348f, 0.08696f, 0.08696f, 0.3913f, 0.2609f, 0.04348f}},
+  {"lc", "heuoa", {0.1143f, 0.02857f, 0.2571f, 0.4286f, 0.1714f}},
+  {"vu", "l", {1.0f}},
+  {"rq", "u", {1.0f}},
+  {"hf", "ou", {0.0303f, 0.9697f}},
+  {"lb", "eo", {0.125f, 0.875f}},
+  {"fy", "i_", {0.1429f, 0.8571f}},
+  {"xa", "nsgltcm", {0.01724f, 0.06897f, 0.03448f, 0.02586f, 0.05172f, 0.3276f, 0.4741f}},
+  {"nm", "ioae", {0.1429f, 0.2143f, 0.07143f, 0.5714f}},
+  {"ky", "_", {1.0f}},
+  {"fs", "ph_", {0.1053f, 0.05263f, 0.8421f}},
+  {"tn", "uei", {0.07463f, 0.6866f, 0.2388f}},
+  {"dt", "h", {1.0f}},
+  {"vy", "_", {1.0f}},
+  {"hl", "eyi", {0.2258f, 0.7419f, 0.03226f}},
+  {"gy", "_", {1.0f}},
+  {"lk", "sai_e", {0.05634f, 0.007042f, 0.2324f, 0.4225f, 0.2817f}},
+  {"uo", "tru", {0.119f, 0.04762f, 0.8333f}},
+  {"hb", "o", {1.0f}},
+  {"yb", "aeoru", {0.01724f, 0.01724f, 0.7759f, 0.08621f, 0.1034f}},
+  {"gg", "irsael", {0.1447f, 0.03947f, 0.05263f, 0.1053f, 0.4737f, 0.1842f}},
+  {"oh", "iaen_", {0.007463f, 0.007463f, 0.007463f, 0.03358f, 0.944f}},
+  {"tf", "oiu", {0.03529f, 0.1647f, 0.8f}},
+  {"ml", "ley", {0.05882f, 0.1176f, 0.8235f}},
+  {"nw", "aiho", {0.2286f, 0.08571f, 0.5714f, 0.1143f}},
+  {"zo", "un", {0.2727f, 0.7273f}},
+  {"hs", "at_", {0.01299f, 0.3377f, 0.6494f}},
+  {"ws", "hui_", {0.01064f, 0.005319f, 0.01064f, 0.9734f}},
+  {"uk", "e", {1.0f}},
+  {"mr", "_a", {0.2128f, 0.7872f}},
+  {"rh", "i_uoae", {0.006173f, 0.006173f, 0.006173f, 0.0679f, 0.8272f, 0.08642f}},
+  {"gp", "i", {1.0f}},
+  {"eq", "u", {1.0f}},
+  {"kw", "a", {1.0f}},
+  {"ej", "euo", {0.1f, 0.3667f, 0.5333f}},
+  {"tc", "ah", {0.005348f, 0.9947f}},
+  {"_x", "i", {1.0f}},
+  {"ii", "i_", {0.5f, 0.5f}},
+  {"nx", "e_i", {0.01695f, 0.01695f, 0.9661f}},
+  {"xi", "tgv_mnbclesio", {0.005556f, 0.005556f, 0.02222f, 0.01111f, 0.02222f, 0.05556f, 0.01667f, 0.06111f, 0.08333f, 0.09444f, 0.1389f, 0.1944f, 0.2889f}},
+  {"rk", "rmlsaine_", {0.004255f, 0.008511f, 0.02979f, 0.1277f, 0.04255f, 0.01277f, 0.1021f, 0.2298f, 0.4426f}},
+  {"yk", "e", {1.0f}},
+  {"rw", "oiha", {0.01f, 0.09f, 0.06f, 0.84f}},
+  {"lp", "otlae_i", {0.04762f, 0.01587f, 0.01587f, 0.09524f, 0.03175f, 0.6825f, 0.1111f}},
+  {"df", "ua", {0.5f, 0.5f}},
+  {"oe", "_luvmts", {0.01117f, 0.01117f, 0.03352f, 0.02793f, 0.04469f, 0.09497f, 0.7765f}},
+  {"gd", "ao", {0.03846f, 0.9615f}},
+  {"hw", "oa", {0.6471f, 0.3529f}},
+  {"ju", "pvblgnrmsd", {0.002994f, 0.005988f, 0.002994f, 0.008982f, 0.01497f, 0.01796f, 0.05389f, 0.03293f, 0.6557f, 0.2036f}},
+  {"bm", "i", {1.0f}},
+  {"lm", "ylie_sno", {0.007092f, 0.02837f, 0.02128f, 0.04255f, 0.1418f, 0.03546f, 0.09929f, 0.6241f}},
+  {"rp", "ha_lseor", {0.005405f, 0.05946f, 0.08649f, 0.07027f, 0.1351f, 0.1838f, 0.1514f, 0.3081f}},
+  {"iz", "uiaoe", {0.004902f, 0.1127f, 0.03922f, 0.02941f, 0.8137f}},
+  {"ze", "tansdm_", {0.004831f, 0.01449f, 0.1739f, 0.01932f, 0.5507f, 0.009662f, 0.2271f}},
+  {"dw", "oare", {0.04762f, 0.04762f, 0.1429f, 0.7619f}},
+  {"sy", "crsm_l", {0.007874f, 0.007874f, 0.02362f, 0.07874f, 0.7953f, 0.08661f}},
+  {"yl", "yi_el", {0.06667f, 0.2f, 0.03333f, 0.3333f, 0.3667f}},
+  {"c_", "_", {1.0f}},
+  {"nr", "eayo", {0.05263f, 0.2632f, 0.5263f, 0.1579f}},
+  {"gt", "h", {1.0f}},
+  {"uf", "c_f", {0.04651f, 0.04651f, 0.907f}},
+  {"wd", "e_n", {0.1667f, 0.75f, 0.08333f}},
+  {"dn", "_ie", {0.02817f, 0.1549f, 0.8169f}},
+  {"wl", "ise_y", {0.04938f, 0.03704f, 0.3086f, 0.2346f, 0.3704f}},
+  {"dl", "oiey", {0.04527f, 0.01235f, 0.428f, 0.5144f}},
+  {"lr", "iyoe", {0.008772f, 0.07895f, 0.008772f, 0.9035f}},
+  {"ix", "oi_te", {0.02924f, 0.05263f, 0.386f, 0.1696f, 0.3626f}},
+  {"xe", "lsmrcd", {0.005556f, 0.02222f, 0.1056f, 0.08333f, 0.4111f, 0.3722f}},
+  {"mn", "ysi_ea", {0.01429f, 0.01429f, 0.07143f, 0.1857f, 0.6429f, 0.07143f}},
+  {"sn", "ou_ae", {0.01852f, 0.03704f, 0.01852f, 0.5556f, 0.3704f}},
+  {"eb", "yurlotae", {0.01389f, 0.05556f, 0.1667f, 0.08333f, 0.1944f, 0.125f, 0.2778f, 0.08333f}},
+  {"va", "p_cubrisdgtnl", {0.003683f, 0.003683f, 0.005525f, 0.02394f, 0.01657f, 0.03499f, 0.09392f, 0.03131f, 0.02026f, 0.03683f, 0.06446f, 0.3794f, 0.2855f}},
+  {"nu", "ldrgpasotneim", {0.002584f, 0.002584f, 0.002584f, 0.005168f, 0.002584f, 0.02067f, 0.03101f, 0.0155f, 0.2842f, 0.01034f, 0.4961f, 0.03101f, 0.09561f}},
+  {"ip", "wrtemliha_ps", {0.00369f, 0.00369f, 0.07749f, 0.04059f, 0.06273f, 0.05535f, 0.03321f, 0.01845f, 0.09225f, 0.2399f, 0.1476f, 0.2251f}},
+  {"ps", "ytae_", {0.002985f, 0.008955f, 0.01194f, 0.09552f, 0.8806f}},
+  {"lu", "olgbrxpaycnmisdet", {0.002833f, 0.002833f, 0.008499f, 0.03399f, 0.008499f, 0.04249f, 0.008499f, 0.02266f, 0.002833f, 0.08215f, 0.1048f, 0.06516f, 0.002833f, 0.1926f, 0.0255f, 0.1558f, 0.238f}},
+  {"nn", "ksay_eoui", {0.01111f, 0.002222f, 0.01333f, 0.01333f, 0.04667f, 0.3933f, 0.3867f, 0.008889f, 0.1244f}},
+  {"ua", "_yvnbgisldtr", {0.001761f, 0.007042f, 0.001761f, 0.008803f, 0.01585f, 0.02113f, 0.09331f, 0.003521f, 0.1796f, 0.01232f, 0.07042f, 0.5845f}},
+  {"sl", "ueiaoy", {0.003279f, 0.3082f, 0.1574f, 0.07869f, 0.1574f, 0.2951f}},
+  {"gs", "ti_", {0.004854f, 0.009709f, 0.9854f}},
+  {"mt", "he", {0.05882f, 0.9412f}},
+  {"pu", "pcdzbgsltnr", {0.004396f, 0.004396f, 0.004396f, 0.002198f, 0.05275f, 0.02198f, 0.04615f, 0.08352f, 0.3165f, 0.1099f, 0.3538f}},
+  {"rl", "asdi_oey", {0.008824f, 0.01176f, 0.2647f, 0.02647f, 0.1471f, 0.05882f, 0.04706f, 0.4353f}},
+  {"sp", "s_yuihreoal", {0.001823f, 0.002735f, 0.01003f, 0.02005f, 0.1613f, 0.005469f, 0.07384f, 0.4093f, 0.1814f, 0.1048f, 0.02917f}},
+  {"ah", "eu_", {0.01111f, 0.06296f, 0.9259f}},
+  {"xc", "iuhel", {0.09375f, 0.1979f, 0.1719f, 0.4219f, 0.1146f}},
+  {"rf", "a_lisoeu", {0.01875f, 0.0125f, 0.04375f, 0.0625f, 0.00625f, 0.1438f, 0.3625f, 0.35f}},
+  {"bs", "ico_et", {0.005618f, 0.07865f, 0.1348f, 0.09551f, 0.5618f, 0.1236f}},
+  {"sb", "oa", {0.01389f, 0.9861f}},
+  {"dd", "y_arlei", {0.009317f, 0.0559f, 0.03416f, 0.1925f, 0.2236f, 0.3727f, 0.1118f}},
+  {"cy", "n_", {0.01064f, 0.9894f}},
+  {"tm", "aoe", {0.08871f, 0.07258f, 0.8387f}},
+  {"sc", "lhueiaor", {0.0078f, 0.04992f, 0.04524f, 0.1576f, 0.0546f, 0.2715f, 0.2637f, 0.1498f}},
+  {"cr", "aouyei", {0.03217f, 0.1183f, 0.0487f, 0.06174f, 0.2104f, 0.5287f}},
+  {"aw", "yhkelsofn_ai", {0.001934f, 0.001934f, 0.01354f, 0.01354f, 0.01161f, 0.02128f, 0.01161f, 0.003868f, 0.06383f, 0.4468f, 0.3462f, 0.06383f}},
+  {"ib", "_bayrsiuel", {0.002469f, 0.01235f, 0.002469f, 0.002469f, 0.01235f, 0.004938f, 0.05679f, 0.0642f, 0.1728f, 0.6691f}},
+  {"cc", "liauoe", {0.01107f, 0.03506f, 0.06642f, 0.2657f, 0.4004f, 0.2214f}},
+  {"sd", "rao", {0.04762f, 0.8095f, 0.1429f}},
+  {"lw", "a", {1.0f}},
+  {"ys", "omtshie_", {0.003503f, 0.001751f, 0.05254f, 0.01226f, 0.001751f, 0.03678f, 0.2557f, 0.6357f}},
+  {"py", "i_", {0.03509f, 0.9649f}},
+  {"lt", "ruaioyhe_s", {0.006394f, 0.002558f, 0.008951f, 0.02302f, 0.3836f, 0.08056f, 0.1215f, 0.05627f, 0.2916f, 0.02558f}},
+  {"sg", "oiru", {0.03704f, 0.03704f, 0.3333f, 0.5926f}},
+  {"ak", "afns_ie", {0.002486f, 0.03148f, 0.01243f, 0.01243f, 0.2013f, 0.1582f, 0.5816f}},
+  {"za", "tr", {0.4375f, 0.5625f}},
+  {"ts", "ycwimkte_", {0.001112f, 0.001112f, 0.001112f, 0.008899f, 0.02002f, 0.001112f, 0.006674f, 0.03337f, 0.9266f}},
+  {"dv", "iae", {0.1712f, 0.5225f, 0.3063f}},
+  {"pt", "noulishey_a", {0.002232f, 0.006696f, 0.04241f, 0.008929f, 0.1808f, 0.01786f, 0.03348f, 0.1451f, 0.05357f, 0.3549f, 0.154f}},
+  {"oi", "e_trlncds", {0.001259f, 0.001259f, 0.01259f, 0.03149f, 0.0529f, 0.4698f, 0.2267f, 0.0403f, 0.1637f}},
+  {"ik", "i_e", {0.03133f, 0.02089f, 0.9478f}},
+  {"hy", "ps_", {0.02317f, 0.08108f, 0.8958f}},
+  {"up", "hwbulyrspei_tao", {0.0008396f, 0.0008396f, 0.0008396f, 0.0008396f, 0.007557f, 0.006717f, 0.006717f, 0.008396f, 0.09404f, 0.06381f, 0.03862f, 0.2149f, 0.03946f, 0.008396f, 0.508f}},
+  {"do", "xlgzpscivtrenuo_mw", {0.0008965f, 0.002241f, 0.004482f, 0.004482f, 0.005379f, 0.0004482f, 0.006723f, 0.01121f, 0.006723f, 0.001345f, 0.03138f, 0.04886f, 0.2004f, 0.1156f, 0.1443f, 0.2779f, 0.02376f, 0.1139f}},
+  {"wn", "yiwecs_", {0.002188f, 0.002188f, 0.002188f, 0.01969f, 0.002188f, 0.06783f, 0.9037f}},
+  {"ek", "n_eis", {0.03409f, 0.5909f, 0.07955f, 0.1818f, 0.1136f}},
+  {"ks", "hmeo_", {0.009804f, 0.004902f, 0.004902f, 0.04412f, 0.9363f}},
+  {"lv", "iae", {0.0202f, 0.02525f, 0.9545f}},
+  {"og", "mlsyi_braenu", {0.0119f, 0.003968f, 0.007937f, 0.03571f, 0.07143f, 0.03175f, 0.003968f, 0.03571f, 0.123f, 0.2341f, 0.3929f, 0.04762f}},
+  {"ep", "hpouseat_lir", {0.004329f, 0.002165f, 0.02381f, 0.02597f, 0.04762f, 0.09235f, 0.132f, 0.1183f, 0.145f, 0.3362f, 0.02886f, 0.04329f}},
+  {"gl", "uoeyai", {0.003454f, 0.0639f, 0.1848f, 0.1088f, 0.3817f, 0.2573f}},
+  {"fl", "oyuiae", {0.1543f, 0.06887f, 0.07438f, 0.1074f, 0.1763f, 0.4187f}},
+  {"bu", "bkdfyilzsnrtc", {0.0004864f, 0.0004864f, 0.001459f, 0.001946f, 0.002432f, 0.003891f, 0.00535f, 0.001459f, 0.03599f, 0.009728f, 0.04183f, 0.8079f, 0.08706f}},
+  {"su", "ganepdsmfbclir", {0.002676f, 0.03077f, 0.01672f, 0.02007f, 0.1124f, 0.0107f, 0.07358f, 0.103f, 0.04682f, 0.03946f, 0.2047f, 0.03946f, 0.04482f, 0.2548f}},
+  {"pa", "hmw_vzgqbuclyspintr", {0.0004427f, 0.0004427f, 0.0004427f, 0.0004427f, 0.01372f, 0.0004427f, 0.006197f, 0.0004427f, 0.007968f, 0.006197f, 0.04382f, 0.0664f, 0.02789f, 0.1943f, 0.03143f, 0.0726f, 0.1031f, 0.06552f, 0.3581f}},
+  {"tr", "ueoyai", {0.124f, 0.363f, 0.0899f, 0.04133f, 0.242f, 0.1398f}},
+  {"iu", "rsm", {0.01695f, 0.322f, 0.661f}},
+  {"ph", "rilyoea_", {0.03252f, 0.187f, 0.03252f, 0.187f, 0.02439f, 0.2114f, 0.1951f, 0.1301f}},
+  {"nq", "u", {1.0f}},
+  {"my", "ts_", {0.0005371f, 0.0913f, 0.9082f}},
+  {"hm", "ae", {0.4191f, 0.5809f}},
+  {"ub", "yr_bdijuelmtso", {0.002309f, 0.04619f, 0.006928f, 0.009238f, 0.01386f, 0.03464f, 0.05774f, 0.004619f, 0.01386f, 0.3002f, 0.02771f, 0.4573f, 0.01386f, 0.01155f}},
+  {"ja", "xunzwpmric", {0.02778f, 0.02778f, 0.02778f, 0.02778f, 0.1389f, 0.02778f, 0.05556f, 0.1667f, 0.2778f, 0.2222f}},
+  {"cq", "u", {1.0f}},
+  {"rc", "s_oauliyeh", {0.00299f, 0.001495f, 0.02093f, 0.04036f, 0.0583f, 0.01196f, 0.04185f, 0.01794f, 0.5277f, 0.2765f}},
+  {"oo", "ivbfstpnmdlr_k", {0.0004619f, 0.0004619f, 0.0009238f, 0.02263f, 0.008314f, 0.03603f, 0.01801f, 0.08222f, 0.04573f, 0.2014f, 0.03095f, 0.2236f, 0.07252f, 0.2568f}},
+  {"ok", "oysie_", {0.002809f, 0.001404f, 0.0309f, 0.07444f, 0.3525f, 0.5379f}},
+  {"po", "xaelmvpgtouikwcnsr", {0.001101f, 0.0007339f, 0.009174f, 0.02936f, 0.004037f, 0.000367f, 0.005138f, 0.000367f, 0.01394f, 0.04991f, 0.007339f, 0.06092f, 0.02202f, 0.03156f, 0.02752f, 0.251f, 0.1648f, 0.3207f}},
+  {"oq", "u", {1.0f}},
+  {"ff", "lsrao_ie", {0.004149f, 0.005533f, 0.008299f, 0.1521f, 0.05394f, 0.1715f, 0.2918f, 0.3126f}},
+  {"ei", "slmztnrvg", {0.004593f, 0.01378f, 0.0006562f, 0.03675f, 0.05643f, 0.1955f, 0.2802f, 0.2159f, 0.1962f}},
+  {"hu", "becgltrmdsn", {0.001661f, 0.001661f, 0.001661f, 0.0299f, 0.003322f, 0.108f, 0.09302f, 0.1096f, 0.02326f, 0.3223f, 0.3056f}},
+  {"dr", "uyoiae", {0.06072f, 0.01292f, 0.05943f, 0.1331f, 0.2067f, 0.5271f}},
+  {"sq", "u", {1.0f}},
+  {"nj", "euo", {0.01493f, 0.4627f, 0.5224f}},
+  {"sf", "_eyuoia", {0.00885f, 0.00885f, 0.1062f, 0.00885f, 0.3274f, 0.4336f, 0.1062f}},
+  {"bi", "cb_oegasdlnrt", {0.05576f, 0.007435f, 0.007435f, 0.003717f, 0.01859f, 0.0223f, 0.01115f, 0.01487f, 0.09665f, 0.2454f, 0.1338f, 0.0632f, 0.3197f}},
+  {"eh", "_eoai", {0.05505f, 0.289f, 0.1147f, 0.1193f, 0.422f}},
+  {"ia", "pedh_mscbnlrtg", {0.001592f, 0.001592f, 0.001592f, 0.001592f, 0.1019f, 0.1115f, 0.03185f, 0.004777f, 0.03185f, 0.1449f, 0.1274f, 0.06369f, 0.2213f, 0.1545f}},
+  {"rr", "houyeia", {0.0008749f, 0.1969f, 0.03937f, 0.07174f, 0.2047f, 0.4234f, 0.06299f}},
+  {"wr", "yaeoi", {0.004878f, 0.04878f, 0.1512f, 0.3171f, 0.478f}},
+  {"ds", "ecmoiht_", {0.0009183f, 0.0009183f, 0.06061f, 0.03673f, 0.001837f, 0.02112f, 0.01837f, 0.8595f}},
+  {"tw", "ieo", {0.09127f, 0.2963f, 0.6124f}},
+  {"vo", "sy_tluwkirc", {0.008065f, 0.01613f, 0.02218f, 0.09879f, 0.0504f, 0.09476f, 0.02218f, 0.01815f, 0.3992f, 0.2359f, 0.03427f}},
+  {"nv", "youaie", {0.009119f, 0.03343f, 0.02736f, 0.03343f, 0.2401f, 0.6565f}},
+  {"nl", "oauiey", {0.001838f, 0.009191f, 0.009191f, 0.03125f, 0.05882f, 0.8897f}},
+  {"dy", "sik_", {0.0008203f, 0.01805f, 0.004922f, 0.9762f}},
+  {"kn", "ioe", {0.0565f, 0.7388f, 0.2047f}},
+  {"ew", "lophecasdi_", {0.001626f, 0.006504f, 0.006504f, 0.03415f, 0.04228f, 0.004878f, 0.05203f, 0.06504f, 0.009756f, 0.09268f, 0.6846f}},
+  {"w_", "_", {1.0f}},
+  {"az", "o_zueai", {0.01923f, 0.009615f, 0.05769f, 0.01923f, 0.125f, 0.07692f, 0.6923f}},
+  {"zi", "n", {1.0f}},
+  {"mm", "_ouiea", {0.007874f, 0.05827f, 0.04094f, 0.1654f, 0.6283f, 0.09921f}},
+  {"_j", "ieuao", {0.004934f, 0.1776f, 0.472f, 0.05099f, 0.2944f}},
+  {"jo", "slcrabhkiyu", {0.007752f, 0.02326f, 0.003876f, 0.007752f, 0.003876f, 0.003876f, 0.03488f, 0.04651f, 0.1744f, 0.3682f, 0.3256f}},
+  {"rn", "msoil_ae", {0.003711f, 0.02505f, 0.02041f, 0.2254f, 0.004638f, 0.308f, 0.07699f, 0.3358f}},
+  {"ls", "atie_o", {0.01531f, 0.01276f, 0.02296f, 0.1735f, 0.6378f, 0.1378f}},
+  {"rv", "yoaei", {0.002469f, 0.01481f, 0.2346f, 0.4716f, 0.2765f}},
+  {"_u", "zgrtspn", {0.0004895f, 0.000979f, 0.0093f, 0.03133f, 0.2335f, 0.4136f, 0.3108f}},
+  {"nh", "uae", {0.0303f, 0.5455f, 0.4242f}},
+  {"sm", "sue_oia", {0.002801f, 0.005602f, 0.1261f, 0.06443f, 0.07563f, 0.5126f, 0.2129f}},
+  {"ty", "pirlab_", {0.0007994f, 0.003997f, 0.01199f, 0.008793f, 0.003197f, 0.004796f, 0.9664f}},
+  {"gr", "yuoeai", {0.01765f, 0.008307f, 0.1132f, 0.4849f, 0.2181f, 0.1578f}},
+  {"au", "prvnxc_zltgsbd", {0.001195f, 0.002389f, 0.003584f, 0.01075f, 0.01912f, 0.007168f, 0.03465f, 0.001195f, 0.04898f, 0.1959f, 0.1732f, 0.3082f, 0.007168f, 0.1864f}},
+  {"ow", "rhfdsal_nie", {0.0003252f, 0.0003252f, 0.001301f, 0.005854f, 0.04455f, 0.0774f, 0.02407f, 0.5167f, 0.1379f, 0.03707f, 0.1545f}},
+  {"ug", "lame_iungh", {0.003394f, 0.005656f, 0.001131f, 0.01131f, 0.004525f, 0.01584f, 0.03959f, 0.01131f, 0.03281f, 0.8744f}},
+  {"gh", "nwlosieba_t", {0.002446f, 0.0004892f, 0.004892f, 0.004403f, 0.003914f, 0.01517f, 0.02153f, 0.01125f, 0.08708f, 0.2035f, 0.6453f}},
+  {"ht", "cmoiysneflh_", {0.000757f, 0.000757f, 0.000757f, 0.01363f, 0.0106f, 0.02725f, 0.009841f, 0.06889f, 0.03634f, 0.01363f, 0.003028f, 0.8145f}},
+  {"ba", "jiauygdlhtrsnczb", {0.0009891f, 0.003956f, 0.0009891f, 0.004946f, 0.003956f, 0.02374f, 0.06726f, 0.09792f, 0.0178f, 0.05638f, 0.179f, 0.1137f, 0.1494f, 0.1662f, 0.06825f, 0.0455f}},
+  {"_k", "oeni", {0.0005817f, 0.07621f, 0.4863f, 0.4369f}},
+  {"ki", "dctsrnl", {0.0007326f, 0.00293f, 0.1004f, 0.02198f, 0.005128f, 0.7656f, 0.1033f}},
+  {"si", "uqzpcarmxdtvbnegols", {0.000277f, 0.000277f, 0.001939f, 0.001939f, 0.005263f, 0.006925f, 0.06039f, 0.02438f, 0.02465f, 0.09612f, 0.07839f, 0.01551f, 0.041f, 0.1579f, 0.2186f, 0.07867f, 0.08864f, 0.04848f, 0.05069f}},
+  {"uc", "u_aricetkh", {0.001776f, 0.01599f, 0.002664f, 0.001776f, 0.006217f, 0.06217f, 0.0675f, 0.1137f, 0.206f, 0.5222f}},
+  {"ot", "lcmrasiowte_h", {0.0002743f, 0.0002743f, 0.0005487f, 0.001372f, 0.002195f, 0.01481f, 0.02881f, 0.000823f, 0.007133f, 0.03704f, 0.06447f, 0.5868f, 0.2554f}},
+  {"h_", "_", {1.0f}},
+  {"p_", "_", {1.0f}},
+  {"sw", "aioe", {0.03363f, 0.05381f, 0.4798f, 0.4327f}},
+  {"we", "ipsvalend_r", {0.005535f, 0.002153f, 0.003998f, 0.03413f, 0.05105f, 0.195f, 0.04705f, 0.08702f, 0.06704f, 0.2408f, 0.2663f}},
+  {"rb", "ouia_esl", {0.01639f, 0.01639f, 0.123f, 0.123f, 0.2787f, 0.2131f, 0.03279f, 0.1967f}},
+  {"bl", "uoiaye", {0.03114f, 0.06851f, 0.09343f, 0.07266f, 0.06228f, 0.672f}},
+  {"am", "ynsmuaopbie_", {0.001918f, 0.002877f, 0.007992f, 0.004476f, 0.008312f, 0.007033f, 0.05627f, 0.04092f, 0.07097f, 0.2177f, 0.3699f, 0.2116f}},
+  {"u_", "_", {1.0f}},
+  {"af", "aoi_reft", {0.01215f, 0.003472f, 0.003472f, 0.006944f, 0.05729f, 0.07118f, 0.3073f, 0.5382f}},
+  {"fi", "safvgndelxtcr", {0.01341f, 0.003193f, 0.03895f, 0.07471f, 0.03257f, 0.1973f, 0.06833f, 0.07982f, 0.02937f, 0.0364f, 0.02363f, 0.1667f, 0.2356f}},
+  {"ir", "ygaclotm_irdes", {0.001395f, 0.002326f, 0.03302f, 0.03116f, 0.02186f, 0.01721f, 0.02977f, 0.01674f, 0.3679f, 0.02372f, 0.01349f, 0.02605f, 0.2456f, 0.1698f}},
+  {"un", "mbpvuljhnf_wakriecsgdt", {0.002748f, 0.000687f, 0.003435f, 0.0003435f, 0.000687f, 0.008932f, 0.002748f, 0.003779f, 0.009275f, 0.0237f, 0.02473f, 0.002405f, 0.04157f, 0.02576f, 0.002405f, 0.05119f, 0.05634f, 0.04809f, 0.0134f, 0.1779f, 0.3717f, 0.1281f}},
+  {"i_", "_", {1.0f}},
+  {"sa", "u_bkrcvgdwsflmntpiy", {0.002385f, 0.000265f, 0.00318f, 0.006359f, 0.04293f, 0.02067f, 0.01537f, 0.01245f, 0.02411f, 0.04001f, 0.01219f, 0.01033f, 0.01987f, 0.05803f, 0.03392f, 0.05061f, 0.01855f, 0.5291f, 0.09963f}},
+  {"yi", "en", {0.09314f, 0.9069f}},
+  {"a_", "_", {1.0f}},
+  {"_y", "aieo", {0.001602f, 0.003043f, 0.1096f, 0.8858f}},
+  {"yo", "rnu", {0.0016f, 0.01671f, 0.9817f}},
+  {"oa", "lfmvsrnkd_ct", {0.007059f, 0.002353f, 0.007059f, 0.002353f, 0.04f, 0.06588f, 0.04471f, 0.1459f, 0.2659f, 0.01176f, 0.24f, 0.1671f}},
+  {"cu", "eoainmrlspt", {0.006017f, 0.002407f, 0.001203f, 0.009627f, 0.008424f, 0.04573f, 0.2996f, 0.1949f, 0.201f, 0.05897f, 0.1721f}},
+  {"ey", "bpihdose_", {0.000738f, 0.000738f, 0.005166f, 0.000738f, 0.000738f, 0.01476f, 0.05018f, 0.2103f, 0.7166f}},
+  {"mb", "soua_leir", {0.009259f, 0.02469f, 0.02006f, 0.1034f, 0.01543f, 0.2022f, 0.4738f, 0.03704f, 0.1142f}},
+  {"br", "ueioa", {0.01951f, 0.2061f, 0.178f, 0.372f, 0.2244f}},
+  {"ti", "zqpbdagfcvetnsorml", {0.004953f, 0.0009005f, 0.002026f, 0.003377f, 0.001576f, 0.01081f, 0.01171f, 0.02927f, 0.05696f, 0.03219f, 0.03827f, 0.01643f, 0.1977f, 0.02229f, 0.3028f, 0.02431f, 0.1576f, 0.0869f}},
+  {"il", "kbumsvt_aieodly", {0.0004692f, 0.0002346f, 0.0007037f, 0.0002346f, 0.009852f, 0.003519f, 0.01103f, 0.05325f, 0.1717f, 0.04175f, 0.1262f, 0.005395f, 0.0183f, 0.5262f, 0.0312f}},
+  {"ic", "osly_kuitahe", {0.001865f, 0.005594f, 0.001865f, 0.004972f, 0.04195f, 0.05438f, 0.03605f, 0.04506f, 0.02952f, 0.07023f, 0.504f, 0.2045f}},
+  {"pl", "ouyeia", {0.02818f, 0.01434f, 0.05328f, 0.2152f, 0.2572f, 0.4319f}},
+  {"la", "lfhkxuwpvbdcizgmsr_tyn", {0.0002729f, 0.0005459f, 0.0002729f, 0.0002729f, 0.0008188f, 0.02293f, 0.009825f, 0.01255f, 0.001365f, 0.005731f, 0.2399f, 0.1646f, 0.05295f, 0.001092f, 0.009825f, 0.01638f, 0.07942f, 0.06496f, 0.03712f, 0.0827f, 0.03657f, 0.1599f}},
+  {"ob", "n_iyjblseoat", {0.001938f, 0.00969f, 0.01357f, 0.003876f, 0.08527f, 0.02519f, 0.188f, 0.1957f, 0.1725f, 0.126f, 0.08333f, 0.09496f}},
+  {"bt", "fesl_a", {0.003906f, 0.06641f, 0.03906f, 0.1367f, 0.5625f, 0.1914f}},
+  {"ta", "df_muysvcltprkbngi", {0.0009183f, 0.001377f, 0.0006887f, 0.002755f, 0.002066f, 0.002296f, 0.007576f, 0.002755f, 0.0241f, 0.04431f, 0.04959f, 0.00551f, 0.02456f, 0.1097f, 0.03788f, 0.1368f, 0.4353f, 0.1118f}},
+  {"fr", "uyaeio", {0.007218f, 0.001666f, 0.09217f, 0.0844f, 0.2871f, 0.5275f}},
+  {"ch", "nysflwurtoiam_e", {0.0002276f, 0.0004553f, 0.0004553f, 0.0009105f, 0.001821f, 0.0009105f, 0.007512f, 0.003415f, 0.0002276f, 0.02049f, 0.04211f, 0.1593f, 0.006374f, 0.5643f, 0.1914f}},
+  {"rt", "nfblosruemyahi_", {0.00128f, 0.0002134f, 0.0004267f, 0.00192f, 0.005547f, 0.01536f, 0.004694f, 0.05931f, 0.05206f, 0.016f, 0.02283f, 0.4534f, 0.1826f, 0.03691f, 0.1474f}},
+  {"nk", "yfalensi_", {0.00189f, 0.00189f, 0.003781f, 0.01701f, 0.03781f, 0.07183f, 0.1437f, 0.08129f, 0.6408f}},
+  {"dm", "eaio", {0.03659f, 0.07317f, 0.8537f, 0.03659f}},
+  {"eg", "nmlogs_aruei", {0.00641f, 0.008547f, 0.02137f, 0.04274f, 0.03632f, 0.03846f, 0.08547f, 0.3333f, 0.1197f, 0.06624f, 0.1197f, 0.1218f}},
+  {"gi", "zbagdsecutrfvnolm", {0.001418f, 0.002837f, 0.0156f, 0.007092f, 0.005674f, 0.01277f, 0.008511f, 0.02837f, 0.004255f, 0.03404f, 0.08227f, 0.01418f, 0.4099f, 0.2851f, 0.04965f, 0.0227f, 0.0156f}},
+  {"iv", "_auoire", {0.006475f, 0.04532f, 0.0007194f, 0.003597f, 0.1165f, 0.02806f, 0.7993f}},
+  {"_q", "u", {1.0f}},
+  {"qu", "yoaei", {0.0007794f, 0.004677f, 0.1543f, 0.4973f, 0.3429f}},
+  {"ui", "bxzprdcn_slte", {0.001261f, 0.006305f, 0.002522f, 0.03279f, 0.1412f, 0.01639f, 0.1009f, 0.06179f, 0.008827f, 0.1614f, 0.1211f, 0.285f, 0.06053f}},
+  {"ol", "kbhsnou_teyivadl", {0.00125f, 0.000625f, 0.000625f, 0.02188f, 0.005625f, 0.04688f, 0.04375f, 0.0275f, 0.01063f, 0.1769f, 0.03125f, 0.08313f, 0.01688f, 0.01688f, 0.325f, 0.1913f}},
+  {"ly", "lmtcpnzis_", {0.0003877f, 0.0003877f, 0.0007755f, 0.0003877f, 0.0003877f, 0.0003877f, 0.001163f, 0.007367f, 0.002714f, 0.986f}},
+  {"ig", "mgs_arouiehn", {0.0005587f, 0.001676f, 0.0005587f, 0.002793f, 0.01676f, 0.001676f, 0.01117f, 0.04022f, 0.02905f, 0.04637f, 0.6084f, 0.2408f}},
+  {"gn", "tys_eiao", {0.0004132f, 0.004959f, 0.006612f, 0.06364f, 0.06983f, 0.05702f, 0.7769f, 0.02066f}},
+  {"no", "pgdlsmynicvowu_tbr", {0.0002042f, 0.0002042f, 0.001225f, 0.0002042f, 0.002859f, 0.002859f, 0.005923f, 0.007353f, 0.0145f, 0.01001f, 0.005515f, 0.00143f, 0.191f, 0.03472f, 0.1338f, 0.5071f, 0.02492f, 0.05617f}},
+  {"ra", "q_zufhorbpdsglywvtmicn", {0.0003124f, 0.0006248f, 0.0009372f, 0.00125f, 0.0006248f, 0.0009372f, 0.004686f, 0.02499f, 0.02655f, 0.02562f, 0.02187f, 0.02405f, 0.03843f, 0.04624f, 0.03436f, 0.03811f, 0.05217f, 0.1534f, 0.1703f, 0.06279f, 0.07123f, 0.2006f}},
+  {"co", "_ebchasitpwgolqfvnrum", {0.0002181f, 0.001527f, 0.0002181f, 0.001309f, 0.0002181f, 0.006979f, 0.007852f, 0.00349f, 0.004798f, 0.001309f, 0.004362f, 0.01745f, 0.007415f, 0.02552f, 0.01352f, 0.001745f, 0.02683f, 0.3439f, 0.0458f, 0.1828f, 0.3027f}},
+  {"wi", "h_vmcrdlsntf", {0.0002104f, 0.0002104f, 0.0004208f, 0.0004208f, 0.006733f, 0.0002104f, 0.001473f, 0.2346f, 0.05702f, 0.1189f, 0.5483f, 0.03156f}},
+  {"if", "aolfyut_ie", {0.0006532f, 0.02286f, 0.01437f, 0.05029f, 0.01633f, 0.05879f, 0.06205f, 0.4879f, 0.06728f, 0.2195f}},
+  {"ri", "rpklgzdfcbvuaotmsen", {0.0002342f, 0.008433f, 0.00609f, 0.01101f, 0.05388f, 0.004216f, 0.02788f, 0.01382f, 0.05107f, 0.03678f, 0.05153f, 0.00773f, 0.04146f, 0.05973f, 0.0609f, 0.04404f, 0.09581f, 0.2813f, 0.1441f}},
+  {"_v", "uaioe", {0.003234f, 0.1091f, 0.2142f, 0.1738f, 0.4996f}},
+  {"li", "_qrmzlbdaopngkesfcvt", {0.0005647f, 0.000847f, 0.001976f, 0.01609f, 0.001976f, 0.00367f, 0.01496f, 0.005364f, 0.02428f, 0.0127f, 0.0223f, 0.1163f, 0.08724f, 0.09994f, 0.2253f, 0.08922f, 0.04602f, 0.04545f, 0.0463f, 0.1395f}},
+  {"tt", "sroyaiel", {0.0006053f, 0.01271f, 0.02785f, 0.1205f, 0.03632f, 0.07264f, 0.5061f, 0.2234f}},
+  {"ab", "jr_hyeudbisalo", {0.0008326f, 0.004996f, 0.001665f, 0.001665f, 0.006661f, 0.006661f, 0.01582f, 0.01998f, 0.06078f, 0.05329f, 0.04913f, 0.05912f, 0.4172f, 0.3022f}},
+  {"it", "rflcnoyasuieht_", {0.0003848f, 0.0001283f, 0.001924f, 0.002437f, 0.002565f, 0.004618f, 0.05015f, 0.02707f, 0.02578f, 0.01449f, 0.04502f, 0.05772f, 0.3615f, 0.07055f, 0.3357f}},
+  {"da", "gx_wbczistulmrny", {0.00092f, 0.00092f, 0.00092f, 0.00184f, 0.00552f, 0.00552f, 0.00552f, 0.01748f, 0.00828f, 0.02208f, 0.00736f, 0.01012f, 0.2686f, 0.1297f, 0.08188f, 0.4333f}},
+  {"ay", "amtolbesi_", {0.0005414f, 0.0005414f, 0.001083f, 0.002166f, 0.002707f, 0.003249f, 0.04602f, 0.1516f, 0.04006f, 0.752f}},
+  {"mp", "sioeuatl_hr", {0.008403f, 0.02269f, 0.1034f, 0.06639f, 0.005882f, 0.2445f, 0.09244f, 0.2588f, 0.06471f, 0.02605f, 0.1067f}},
+  {"ud", "nolaisydg_e", {0.001818f, 0.005455f, 0.01818f, 0.01273f, 0.1109f, 0.09455f, 0.02364f, 0.06727f, 0.09455f, 0.3709f, 0.2f}},
+  {"ll", "pcnfsuaieoy_", {0.0004903f, 0.0001634f, 0.0008171f, 0.002942f, 0.009806f, 0.004903f, 0.02174f, 0.03252f, 0.1373f, 0.07436f, 0.05083f, 0.6642f}},
+  {"ms", "ot_e", {0.004132f, 0.05234f, 0.23f, 0.7135f}},
+  {"el", "rumgcb_eptyoaisvldf", {0.001899f, 0.0008441f, 0.001477f, 0.000422f, 0.001055f, 0.001266f, 0.06689f, 0.05149f, 0.01013f, 0.08926f, 0.09074f, 0.01836f, 0.03018f, 0.1017f, 0.02321f, 0.0306f, 0.265f, 0.02574f, 0.1897f}},
+  {"lf", "auri_", {0.0009615f, 0.01731f, 0.002885f, 0.01346f, 0.9654f}},
+  {"mo", "qghbadkltvosmiunr", {0.0003481f, 0.0006961f, 0.0006961f, 0.0006961f, 0.001044f, 0.01323f, 0.002088f, 0.002088f, 0.02924f, 0.02645f, 0.003481f, 0.08806f, 0.08319f, 0.005917f, 0.09607f, 0.4107f, 0.236f}},
+  {"ry", "mslwbtoi_", {0.0007047f, 0.002114f, 0.0007047f, 0.002819f, 0.01832f, 0.06554f, 0.01762f, 0.02607f, 0.8661f}},
+  {"rd", "pryloesa_i", {0.0003259f, 0.00163f, 0.00163f, 0.005867f, 0.03194f, 0.1405f, 0.1151f, 0.01825f, 0.4531f, 0.2317f}},
+  {"di", "_xumbpfrcgloadtevsn", {0.000704f, 0.000352f, 0.00176f, 0.002816f, 0.00352f, 0.001408f, 0.02394f, 0.02182f, 0.03766f, 0.005984f, 0.006336f, 0.00704f, 0.06371f, 0.1433f, 0.0447f, 0.09539f, 0.01056f, 0.1714f, 0.3576f}},
+  {"ad", "crhnjlaodfiysmve_", {0.0001968f, 0.0005903f, 0.0001968f, 0.002558f, 0.001574f, 0.004526f, 0.05372f, 0.01141f, 0.04368f, 0.0005903f, 0.02007f, 0.1922f, 0.01004f, 0.01555f, 0.04368f, 0.1112f, 0.4882f}},
+  {"wo", "elkomn_ru", {0.001255f, 0.001673f, 0.002509f, 0.01213f, 0.1819f, 0.0138f, 0.1924f, 0.3128f, 0.2815f}},
+  {"ov", "aoei", {0.00503f, 0.009054f, 0.8964f, 0.08954f}},
+  {"id", "uayslntdigo_e", {0.001121f, 0.005045f, 0.0005605f, 0.005886f, 0.008128f, 0.003924f, 0.0005605f, 0.01121f, 0.01878f, 0.004484f, 0.009529f, 0.7293f, 0.2015f}},
+  {"im", "nluboimaeps_", {0.002007f, 0.0002867f, 0.001433f, 0.004587f, 0.002294f, 0.01692f, 0.02982f, 0.06193f, 0.2173f, 0.09834f, 0.1302f, 0.4349f}},
+  {"sh", "ynwliurem_ao", {0.0003048f, 0.001524f, 0.001829f, 0.001524f, 0.04054f, 0.02438f, 0.00701f, 0.4773f, 0.03292f, 0.107f, 0.1417f, 0.164f}},
+  {"ul", "cwnigpysoe_fltad", {0.002745f, 0.0004575f, 0.005489f, 0.007319f, 0.005489f, 0.004575f, 0.01006f, 0.009607f, 0.01464f, 0.02013f, 0.1423f, 0.002745f, 0.08188f, 0.06953f, 0.05947f, 0.5636f}},
+  {"ld", "hwanorslei_", {0.0004831f, 0.0004831f, 0.0004831f, 0.003382f, 0.002415f, 0.01449f, 0.01353f, 0.00628f, 0.06329f, 0.05894f, 0.8362f}},
+  {"nt", "bdpnmlhsuryaioe_", {0.0001745f, 0.0006978f, 0.0001745f, 0.0005234f, 0.004885f, 0.08322f, 0.01151f, 0.04309f, 0.00977f, 0.04013f, 0.02041f, 0.03175f, 0.1048f, 0.06874f, 0.2088f, 0.3712f}},
+  {"ny", "msibo_t", {0.003591f, 0.001795f, 0.007181f, 0.03411f, 0.06643f, 0.7504f, 0.1364f}},
+  {"yt", "euih", {0.005747f, 0.005747f, 0.005747f, 0.9828f}},
+  {"fu", "igmrlnst", {0.00152f, 0.01064f, 0.01368f, 0.1809f, 0.6368f, 0.01824f, 0.08663f, 0.05167f}},
+  {"tu", "fcisebpaomtndlr", {0.0007508f, 0.003003f, 0.003003f, 0.003003f, 0.01877f, 0.002252f, 0.02402f, 0.04129f, 0.01577f, 0.02553f, 0.01351f, 0.1599f, 0.07733f, 0.005255f, 0.6066f}},
+  {"fa", "gd_bnltsrmviuc", {0.001736f, 0.005208f, 0.003472f, 0.005208f, 0.05382f, 0.1007f, 0.08594f, 0.08941f, 0.07205f, 0.08247f, 0.05122f, 0.263f, 0.02604f, 0.1597f}},
+  {"m_", "_", {1.0f}},
+  {"bo", "he_myxilsvrawodtun", {0.0006817f, 0.0006817f, 0.0006817f, 0.0006817f, 0.01772f, 0.008862f, 0.01227f, 0.02045f, 0.01159f, 0.02386f, 0.04908f, 0.03681f, 0.04703f, 0.02318f, 0.122f, 0.1029f, 0.2549f, 0.2665f}},
+  {"na", "jowkd_ypuivgsbtmrnlc", {0.004569f, 0.0002538f, 0.001015f, 0.001269f, 0.001015f, 0.001523f, 0.002538f, 0.002792f, 0.001015f, 0.003807f, 0.00203f, 0.009137f, 0.001015f, 0.008376f, 0.08274f, 0.06929f, 0.03426f, 0.4957f, 0.1766f, 0.101f}},
+  {"ac", "ob_uryalhckqeti", {0.002131f, 0.0003551f, 0.01882f, 0.004972f, 0.01385f, 0.009588f, 0.002841f, 0.007102f, 0.1303f, 0.1339f, 0.1527f, 0.02486f, 0.25f, 0.09624f, 0.1523f}},
+  {"ci", "zvfblspardmntoe", {0.0009381f, 0.006567f, 0.01126f, 0.005629f, 0.02345f, 0.03565f, 0.04503f, 0.03752f, 0.04315f, 0.06379f, 0.002814f, 0.08255f, 0.1351f, 0.08255f, 0.424f}},
+  {"ie", "ksc_vrfwglndtu", {0.000697f, 0.07412f, 0.01162f, 0.02184f, 0.05623f, 0.06134f, 0.02091f, 0.009758f, 0.01022f, 0.008829f, 0.1461f, 0.2735f, 0.01789f, 0.2869f}},
+  {"ux", "uie_", {0.004751f, 0.002375f, 0.03325f, 0.9596f}},
+  {"x_", "_", {1.0f}},
+  {"av", "yaoei", {0.003909f, 0.02189f, 0.05747f, 0.819f, 0.09773f}},
+  {"vi", "pabvorltgescdn", {0.0006583f, 0.006583f, 0.001975f, 0.008558f, 0.0237f, 0.01843f, 0.3535f, 0.04411f, 0.01119f, 0.03226f, 0.07044f, 0.1106f, 0.03752f, 0.2804f}},
+  {"ef", "syarfiel_uot", {0.005495f, 0.004579f, 0.01557f, 0.01282f, 0.0641f, 0.03022f, 0.06593f, 0.07234f, 0.07784f, 0.07875f, 0.4029f, 0.1694f}},
+  {"ft", "snhlyie_", {0.004511f, 0.004511f, 0.009023f, 0.009023f, 0.05414f, 0.006015f, 0.597f, 0.3158f}},
+  {"cl", "yiueao", {0.002853f, 0.07418f, 0.02996f, 0.1698f, 0.1484f, 0.5749f}},
+  {"oc", "oilruectahk", {0.002759f, 0.02897f, 0.002759f, 0.01517f, 0.1407f, 0.04966f, 0.12f, 0.03172f, 0.02483f, 0.1752f, 0.4083f}},
+  {"ck", "hgaoynlswei_", {0.0008326f, 0.002498f, 0.004996f, 0.02748f, 0.008326f, 0.01832f, 0.04829f, 0.02748f, 0.009992f, 0.2415f, 0.164f, 0.4463f}},
+  {"k_", "_", {1.0f}},
+  {"ng", "fybomraidutselh_", {0.0001253f, 0.000501f, 0.000501f, 0.001378f, 0.0003758f, 0.004259f, 0.003632f, 0.007766f, 0.003131f, 0.01077f, 0.01428f, 0.02167f, 0.08404f, 0.04008f, 0.02204f, 0.7854f}},
+  {"go", "amruwvtlensdio_", {0.003205f, 0.0008013f, 0.01603f, 0.009615f, 0.00641f, 0.01843f, 0.04006f, 0.04567f, 0.01362f, 0.06971f, 0.007212f, 0.1787f, 0.1194f, 0.2179f, 0.2532f}},
+  {"uv", "aeir", {0.02632f, 0.1447f, 0.03947f, 0.7895f}},
+  {"vr", "oe", {0.007576f, 0.9924f}},
+  {"_n", "uiaoe", {0.008337f, 0.03647f, 0.07691f, 0.7247f, 0.1536f}},
+  {"ev", "iaore", {0.2231f, 0.02335f, 0.03848f, 0.01427f, 0.7008f}},
+  {"ve", "qgpxhmcialyst_dnr", {0.0009984f, 0.0002853f, 0.0004279f, 0.001141f, 0.0005705f, 0.004564f, 0.001997f, 0.002282f, 0.002282f, 0.02396f, 0.004564f, 0.04122f, 0.00271f, 0.4171f, 0.08957f, 0.1285f, 0.2778f}},
+  {"r_", "_", {1.0f}},
+  {"ap", "uklrh_soeatip", {0.001363f, 0.005453f, 0.001363f, 0.006817f, 0.003408f, 0.02727f, 0.09884f, 0.05044f, 0.1282f, 0.06203f, 0.06271f, 0.04908f, 0.5031f}},
+  {"pp", "halrioye", {0.009615f, 0.02115f, 0.03558f, 0.09904f, 0.05962f, 0.1712f, 0.03173f, 0.5721f}},
+  {"ea", "fbpu_vkglctmdsnr", {0.002042f, 0.006296f, 0.009188f, 0.0245f, 0.01736f, 0.05122f, 0.05241f, 0.01123f, 0.05241f, 0.03624f, 0.1462f, 0.01327f, 0.1225f, 0.1065f, 0.05292f, 0.2957f}},
+  {"ar", "qbvkfpolymgscran_tide", {0.0006046f, 0.002116f, 0.0007054f, 0.01663f, 0.001108f, 0.004837f, 0.01199f, 0.0132f, 0.0267f, 0.03416f, 0.01421f, 0.02277f, 0.01451f, 0.0528f, 0.06973f, 0.0132f, 0.08303f, 0.2656f, 0.03053f, 0.1768f, 0.1447f}},
+  {"ag", "mdr_oiusgplena", {0.001647f, 0.0003295f, 0.02405f, 0.01285f, 0.01812f, 0.02735f, 0.01812f, 0.002636f, 0.008896f, 0.000659f, 0.002306f, 0.1496f, 0.6168f, 0.1166f}},
+  {"ga", "ubcpdmyzglvntsr_i", {0.0009217f, 0.0009217f, 0.001843f, 0.002765f, 0.004608f, 0.02673f, 0.00553f, 0.00553f, 0.02949f, 0.06636f, 0.1051f, 0.1235f, 0.09677f, 0.07189f, 0.06452f, 0.0009217f, 0.3926f}},
+  {"ai", "_elgtsrmdn", {0.0004379f, 0.001095f, 0.04007f, 0.01095f, 0.06766f, 0.02868f, 0.0878f, 0.009415f, 0.4561f, 0.2978f}},
+  {"ru", "xf_bmltsgicnpde", {0.001236f, 0.002472f, 0.002472f, 0.007417f, 0.05068f, 0.03708f, 0.06057f, 0.1607f, 0.0309f, 0.06675f, 0.06304f, 0.1248f, 0.06057f, 0.07911f, 0.2522f}},
+  {"ue", "vmbledrsnt_", {0.001435f, 0.002152f, 0.002152f, 0.0373f, 0.1908f, 0.1485f, 0.02009f, 0.1485f, 0.1263f, 0.05237f, 0.2704f}},
+  {"de", "ouxiwvzlbegmftapcrdn_s", {0.0001814f, 0.0007256f, 0.0001814f, 0.001451f, 0.0003628f, 0.03265f, 0.002539f, 0.01923f, 0.003084f, 0.01778f, 0.004716f, 0.0214f, 0.0136f, 0.01905f, 0.09632f, 0.02086f, 0.02902f, 0.1727f, 0.1148f, 0.05768f, 0.2643f, 0.1074f}},
+  {"ss", "wmbnpflyrua_eio", {0.002407f, 0.002751f, 0.0003439f, 0.002063f, 0.002063f, 0.0003439f, 0.003783f, 0.001719f, 0.001719f, 0.04092f, 0.08563f, 0.4123f, 0.217f, 0.2039f, 0.02304f}},
+  {"ye", "nbzltsr_dau", {0.00273f, 0.00546f, 0.00273f, 0.01365f, 0.1183f, 0.606f, 0.02002f, 0.04459f, 0.1028f, 0.07097f, 0.01274f}},
+  {"eu", "dbpfmlicvnts_xr", {0.001987f, 0.0006623f, 0.001987f, 0.005298f, 0.001987f, 0.001987f, 0.001987f, 0.001325f, 0.003974f, 0.01589f, 0.01457f, 0.02252f, 0.08543f, 0.2457f, 0.5947f}},
+  {"ur", "kfhvlybmdpciorgnat_es", {0.0001885f, 0.0005654f, 0.0001885f, 0.004523f, 0.002073f, 0.003769f, 0.007916f, 0.01564f, 0.00245f, 0.01282f, 0.01131f, 0.03675f, 0.002073f, 0.01734f, 0.0115f, 0.1097f, 0.03826f, 0.02959f, 0.4715f, 0.1289f, 0.09291f}},
+  {"op", "yrtmuaslohpe_i", {0.005525f, 0.00442f, 0.01436f, 0.00221f, 0.005525f, 0.00442f, 0.01105f, 0.07845f, 0.04199f, 0.01768f, 0.1624f, 0.4597f, 0.1315f, 0.06077f}},
+  {"pi", "pgqkaorcdslten", {0.004957f, 0.003717f, 0.009913f, 0.003717f, 0.003717f, 0.02354f, 0.07931f, 0.09294f, 0.08055f, 0.1784f, 0.02602f, 0.1462f, 0.166f, 0.1809f}},
+  {"ni", "_vlrhqmcaezutgsfno", {0.00174f, 0.00058f, 0.00174f, 0.00116f, 0.00116f, 0.00232f, 0.01798f, 0.0319f, 0.01624f, 0.0435f, 0.05104f, 0.009861f, 0.06497f, 0.08353f, 0.1421f, 0.07541f, 0.3799f, 0.07483f}},
+  {"io", "_gtslrudn", {0.001262f, 0.002523f, 0.01093f, 0.005887f, 0.01472f, 0.02271f, 0.1228f, 0.01808f, 0.8011f}},
+  {"on", "rkzyjnmbfogdisqcvltea_", {0.000092f, 0.000736f, 0.000092f, 0.004324f, 0.001012f, 0.002484f, 0.000828f, 0.000092f, 0.01877f, 0.01748f, 0.0414f, 0.03818f, 0.01371f, 0.141f, 0.002208f, 0.02742f, 0.02089f, 0.03745f, 0.04379f, 0.1444f, 0.0414f, 0.4022f}},
+  {"os", "cyuaokpit_se", {0.0003007f, 0.001503f, 0.001503f, 0.001804f, 0.006915f, 0.0003007f, 0.004811f, 0.04299f, 0.1846f, 0.4699f, 0.07727f, 0.2081f}},
+  {"wh", "yieao", {0.03093f, 0.3426f, 0.144f, 0.1788f, 0.3037f}},
+  {"ho", "bkdagevcitprnowmlus_", {0.0003054f, 0.0001527f, 0.001222f, 0.0001527f, 0.0001527f, 0.001527f, 0.0007636f, 0.0007636f, 0.001985f, 0.01573f, 0.01756f, 0.06949f, 0.02749f, 0.01008f, 0.0672f, 0.05315f, 0.04398f, 0.2162f, 0.3044f, 0.1677f}},
+  {"to", "astvxikcdgmwrbonlup_", {0.0001057f, 0.0002114f, 0.0004227f, 0.0005284f, 0.001057f, 0.002008f, 0.0004227f, 0.001268f, 0.003593f, 0.00613f, 0.01807f, 0.02536f, 0.03551f, 0.0003171f, 0.05168f, 0.06024f, 0.02991f, 0.009934f, 0.01437f, 0.7389f}},
+  {"o_", "_", {1.0f}},
+  {"es", "nmfkaqyhpoiecus_t", {0.001061f, 0.0002652f, 0.0001326f, 0.0007957f, 0.000663f, 0.001326f, 0.001061f, 0.01008f, 0.02162f, 0.01021f, 0.05092f, 0.07612f, 0.02281f, 0.01936f, 0.207f, 0.4365f, 0.14f}},
+  {"nf", "ruaileo", {0.008282f, 0.07039f, 0.07867f, 0.2464f, 0.08075f, 0.1677f, 0.3478f}},
+  {"fo", "xnbgawicolusr", {0.0005278f, 0.00132f, 0.0002639f, 0.0005278f, 0.0005278f, 0.002903f, 0.0007918f, 0.0007918f, 0.02296f, 0.06017f, 0.138f, 0.004223f, 0.767f}},
+  {"or", "uflhwonpskcigrbedtay_m", {0.0005682f, 0.0001136f, 0.01057f, 0.001136f, 0.004887f, 0.004432f, 0.02228f, 0.002955f, 0.05012f, 0.005455f, 0.008183f, 0.01102f, 0.01216f, 0.02364f, 0.003864f, 0.1152f, 0.1342f, 0.164f, 0.01f, 0.01091f, 0.3745f, 0.02978f}},
+  {"rm", "ntocy_aluise", {0.001135f, 0.003405f, 0.03519f, 0.02384f, 0.02497f, 0.2327f, 0.08059f, 0.01249f, 0.08854f, 0.1714f, 0.1067f, 0.2191f}},
+  {"ha", "gwfkzuob_isprmlndvt", {0.00008714f, 0.0004357f, 0.0003486f, 0.001568f, 0.00061f, 0.003224f, 0.0001743f, 0.003834f, 0.00061f, 0.008975f, 0.04784f, 0.02501f, 0.0244f, 0.0339f, 0.04296f, 0.1005f, 0.1656f, 0.1466f, 0.3934f}},
+  {"_w", "reioha", {0.0117f, 0.1352f, 0.26f, 0.0987f, 0.2976f, 0.1968f}},
+  {"wa", "dmxgkvltiryns", {0.0004947f, 0.0004947f, 0.000742f, 0.00371f, 0.005442f, 0.003463f, 0.02869f, 0.02844f, 0.04724f, 0.1375f, 0.08756f, 0.03018f, 0.626f}},
+  {"_f", "_liruaoe", {0.0001236f, 0.02632f, 0.1239f, 0.2151f, 0.03151f, 0.1128f, 0.3703f, 0.1199f}},
+  {"fe", "uimtvancgwlesr_d", {0.000559f, 0.00559f, 0.006708f, 0.02292f, 0.008385f, 0.08664f, 0.03689f, 0.06652f, 0.000559f, 0.0408f, 0.2968f, 0.05813f, 0.03913f, 0.1342f, 0.1934f, 0.002795f}},
+  {"an", "mjluwanxeoqigs_cktyd", {0.00006231f, 0.0004985f, 0.0001869f, 0.0006854f, 0.001246f, 0.002368f, 0.01714f, 0.003552f, 0.003552f, 0.009409f, 0.0008724f, 0.01402f, 0.03047f, 0.01714f, 0.2944f, 0.06817f, 0.01053f, 0.05621f, 0.02947f, 0.4401f}},
+  {"_l", "l_uyaieo", {0.002158f, 0.002158f, 0.01061f, 0.002158f, 0.1861f, 0.2456f, 0.2595f, 0.2917f}},
+  {"lo", "m_bpqiafvystogrnwcud", {0.002755f, 0.0009183f, 0.0009183f, 0.01377f, 0.002143f, 0.004591f, 0.02785f, 0.003367f, 0.09979f, 0.01316f, 0.09887f, 0.0199f, 0.1188f, 0.01561f, 0.1261f, 0.1448f, 0.1653f, 0.05234f, 0.07867f, 0.01041f}},
+  {"od", "fdeoausiny_g", {0.001837f, 0.009183f, 0.05326f, 0.008264f, 0.03214f, 0.05418f, 0.0101f, 0.01561f, 0.00551f, 0.1552f, 0.6263f, 0.02847f}},
+  {"dg", "aime", {0.006579f, 0.1316f, 0.02632f, 0.8355f}},
+  {"ed", "crfnoplyaguesdim_", {0.0002583f, 0.0003444f, 0.0001722f, 0.001378f, 0.000861f, 0.0000861f, 0.002497f, 0.001292f, 0.0006888f, 0.004477f, 0.003186f, 0.005166f, 0.001808f, 0.001119f, 0.01627f, 0.0000861f, 0.9603f}},
+  {"_i", "ivcldrfs_gtmn", {0.0001354f, 0.0004063f, 0.0004063f, 0.006094f, 0.006365f, 0.003318f, 0.05058f, 0.1311f, 0.2606f, 0.002912f, 0.161f, 0.02803f, 0.349f}},
+  {"n_", "_", {1.0f}},
+  {"_s", "nqkcyl_pwuimtaheo", {0.001622f, 0.0007136f, 0.003244f, 0.01239f, 0.001622f, 0.01187f, 0.05183f, 0.04132f, 0.0218f, 0.06597f, 0.07272f, 0.01343f, 0.1025f, 0.2054f, 0.1508f, 0.1292f, 0.1136f}},
+  {"so", "swdcvpjfbionlru_ym", {0.0008227f, 0.001234f, 0.001234f, 0.007816f, 0.001645f, 0.003291f, 0.0008227f, 0.01357f, 0.007404f, 0.002468f, 0.05348f, 0.153f, 0.09749f, 0.04731f, 0.08186f, 0.3036f, 0.005759f, 0.2172f}},
+  {"om", "unsfobrayptim_e", {0.0002298f, 0.0004597f, 0.003907f, 0.002298f, 0.0154f, 0.009653f, 0.008504f, 0.09009f, 0.003218f, 0.1133f, 0.01103f, 0.04895f, 0.06022f, 0.3206f, 0.3121f}},
+  {"me", "hkxigwcobualtersnmd_", {0.0002843f, 0.0001422f, 0.0001422f, 0.0002843f, 0.0001422f, 0.002275f, 0.001706f, 0.005402f, 0.001564f, 0.002843f, 0.03227f, 0.007393f, 0.02772f, 0.009383f, 0.02104f, 0.03824f, 0.1925f, 0.0199f, 0.07194f, 0.5648f}},
+  {"_r", "hiaeuo", {0.000395f, 0.08157f, 0.07249f, 0.6865f, 0.04563f, 0.1134f}},
+  {"oy", "fosim_ea", {0.007519f, 0.03008f, 0.03383f, 0.03383f, 0.0188f, 0.5038f, 0.1654f, 0.2068f}},
+  {"ya", "ngrl", {0.05714f, 0.1f, 0.2f, 0.6429f}},
+  {"al", "hzypdcfkvetomruwasil_", {0.0001977f, 0.0001977f, 0.001186f, 0.0003954f, 0.005536f, 0.004547f, 0.02313f, 0.02728f, 0.002175f, 0.04784f, 0.02827f, 0.04784f, 0.02629f, 0.02076f, 0.01147f, 0.01977f, 0.01858f, 0.02313f, 0.03638f, 0.4174f, 0.2376f}},
+  {"l_", "_", {1.0f}},
+  {"_c", "_yirehoula", {0.0002294f, 0.0001147f, 0.01537f, 0.09897f, 0.02523f, 0.09186f, 0.4216f, 0.02202f, 0.06135f, 0.2633f}},
+  {"ca", "iefjkch_gvdnbuptmlrs", {0.0003287f, 0.0006575f, 0.0006575f, 0.0003287f, 0.0006575f, 0.002959f, 0.005588f, 0.0006575f, 0.0003287f, 0.01216f, 0.008547f, 0.1381f, 0.01841f, 0.06969f, 0.07166f, 0.04865f, 0.1213f, 0.09796f, 0.3271f, 0.07429f}},
+  {"st", "mpwgnhyfuresiao_l", {0.0002896f, 0.0004344f, 0.0002896f, 0.0001448f, 0.0008688f, 0.0001448f, 0.02549f, 0.0004344f, 0.02968f, 0.1041f, 0.139f, 0.01158f, 0.09383f, 0.1198f, 0.09166f, 0.3726f, 0.009702f}},
+  {"tl", "oiye", {0.0008803f, 0.01232f, 0.3178f, 0.669f}},
+  {"le", "yhbliwpgxvrmsntdceauf_", {0.0004632f, 0.0003088f, 0.0004632f, 0.0009265f, 0.001235f, 0.002625f, 0.001544f, 0.008802f, 0.003397f, 0.00664f, 0.01946f, 0.0508f, 0.09188f, 0.05188f, 0.1061f, 0.09389f, 0.0193f, 0.01467f, 0.1022f, 0.005713f, 0.02872f, 0.389f}},
+  {"_a", "jxzuyivwhcdlsrmf_bpgnt", {0.0001078f, 0.00007186f, 0.00007186f, 0.00503f, 0.0003952f, 0.00406f, 0.002443f, 0.006863f, 0.008228f, 0.01991f, 0.01829f, 0.06525f, 0.0863f, 0.1337f, 0.02271f, 0.01825f, 0.171f, 0.02235f, 0.02134f, 0.01782f, 0.2711f, 0.1047f}},
+  {"at", "yfnrslomacuteih_", {0.00009112f, 0.0001822f, 0.0004556f, 0.007107f, 0.002005f, 0.001731f, 0.009749f, 0.001002f, 0.003371f, 0.009112f, 0.01212f, 0.03107f, 0.1152f, 0.08164f, 0.1205f, 0.6046f}},
+  {"xp", "iloare", {0.03597f, 0.1547f, 0.07554f, 0.01439f, 0.2698f, 0.4496f}},
+  {"ns", "qlfkchmuoptai_we", {0.001097f, 0.001097f, 0.001463f, 0.0003658f, 0.005121f, 0.002926f, 0.004023f, 0.01573f, 0.0117f, 0.01975f, 0.1763f, 0.005486f, 0.3186f, 0.2886f, 0.03731f, 0.1105f}},
+  {"se", "koguxwhfqmbtncaipsdrlve_", {0.0001391f, 0.0001391f, 0.0006955f, 0.001113f, 0.0001391f, 0.001808f, 0.002226f, 0.0006955f, 0.007233f, 0.01252f, 0.001669f, 0.0242f, 0.07219f, 0.03269f, 0.02267f, 0.02365f, 0.00612f, 0.05008f, 0.1118f, 0.06413f, 0.1626f, 0.01627f, 0.09542f, 0.2897f}},
+  {"_h", "yuaoei", {0.0003257f, 0.01845f, 0.2785f, 0.09574f, 0.3318f, 0.2752f}},
+  {"hi", "fzadobpvgtelrcmns", {0.0001013f, 0.0002027f, 0.0001013f, 0.001216f, 0.003344f, 0.0005067f, 0.005675f, 0.0009121f, 0.007196f, 0.008412f, 0.007601f, 0.02301f, 0.009223f, 0.1557f, 0.1963f, 0.1169f, 0.4637f}},
+  {"is", "vrqnyulckmopidgshfate_", {0.00009698f, 0.000291f, 0.0004849f, 0.000194f, 0.000291f, 0.0009698f, 0.001552f, 0.01018f, 0.003782f, 0.002522f, 0.01523f, 0.007856f, 0.01474f, 0.001649f, 0.002619f, 0.02308f, 0.06255f, 0.01038f, 0.008632f, 0.08234f, 0.04607f, 0.7045f}},
+  {"ge", "folmsrt_adn", {0.000438f, 0.01927f, 0.01226f, 0.005694f, 0.05081f, 0.1822f, 0.08848f, 0.2943f, 0.02847f, 0.1178f, 0.2002f}},
+  {"ou", "xepcidbg_nrtlvs", {0.001439f, 0.0001599f, 0.002078f, 0.004556f, 0.006875f, 0.008393f, 0.02518f, 0.05284f, 0.3148f, 0.1213f, 0.18f, 0.1008f, 0.1038f, 0.005116f, 0.07274f}},
+  {"em", "umn_psyaboei", {0.001629f, 0.0008147f, 0.01344f, 0.2024f, 0.06395f, 0.03747f, 0.02607f, 0.1715f, 0.1246f, 0.06517f, 0.1931f, 0.0998f}},
+  {"mi", "p_mcaxdetgrlsn", {0.0002972f, 0.0002972f, 0.0002972f, 0.005052f, 0.002972f, 0.005646f, 0.02972f, 0.01902f, 0.04012f, 0.06181f, 0.01694f, 0.2912f, 0.3019f, 0.2247f}},
+  {"in", "xmoywjlsuqncvdthkagif_e", {0.00006096f, 0.0001829f, 0.0002439f, 0.0005487f, 0.0004268f, 0.0007925f, 0.004938f, 0.03719f, 0.0189f, 0.002621f, 0.00634f, 0.02048f, 0.00506f, 0.04371f, 0.07261f, 0.001341f, 0.01658f, 0.0467f, 0.37f, 0.01262f, 0.01268f, 0.2627f, 0.06328f}},
+  {"ne", "zqoftlgcixsuaemwyd_vrn", {0.0001893f, 0.0001893f, 0.0003786f, 0.002651f, 0.01041f, 0.006248f, 0.004354f, 0.01477f, 0.01193f, 0.01401f, 0.09447f, 0.02348f, 0.03768f, 0.02139f, 0.01988f, 0.03351f, 0.02651f, 0.1941f, 0.3412f, 0.04733f, 0.06342f, 0.032f}},
+  {"nc", "suralityohe", {0.0003697f, 0.004436f, 0.01257f, 0.003327f, 0.01442f, 0.04399f, 0.01516f, 0.01368f, 0.02699f, 0.1294f, 0.7357f}},
+  {"ce", "tvelfrpsminad_", {0.001072f, 0.0002144f, 0.01222f, 0.03065f, 0.003644f, 0.0791f, 0.01844f, 0.07267f, 0.004287f, 0.07288f, 0.03816f, 0.02144f, 0.09861f, 0.5466f}},
+  {"nd", "gmfyknaowulrise_", {0.00009627f, 0.0001925f, 0.0002888f, 0.0009627f, 0.004814f, 0.001155f, 0.005006f, 0.02051f, 0.0002888f, 0.008568f, 0.004717f, 0.013f, 0.0258f, 0.05314f, 0.0904f, 0.7711f}},
+  {"d_", "_", {1.0f}},
+  {"pr", "yaieuo", {0.0004636f, 0.04868f, 0.1535f, 0.3913f, 0.0255f, 0.3806f}},
+  {"ro", "_hexzgkrdsonwifltpbamcvyuj", {0.001755f, 0.0005015f, 0.001755f, 0.0002508f, 0.0005015f, 0.009529f, 0.01454f, 0.02056f, 0.01856f, 0.04137f, 0.04012f, 0.06294f, 0.07723f, 0.005517f, 0.01279f, 0.01128f, 0.04514f, 0.02859f, 0.02031f, 0.05542f, 0.262f, 0.06444f, 0.03034f, 0.01279f, 0.1565f, 0.005266f}},
+  {"oj", "oe", {0.08696f, 0.913f}},
+  {"je", "rotesawc", {0.002681f, 0.002681f, 0.01072f, 0.02413f, 0.5818f, 0.07239f, 0.05362f, 0.252f}},
+  {"ec", "ysckhlui_reoat", {0.000457f, 0.001828f, 0.003656f, 0.03108f, 0.03199f, 0.02651f, 0.06124f, 0.05073f, 0.001371f, 0.04753f, 0.1485f, 0.1846f, 0.1079f, 0.3026f}},
+  {"ct", "funlsraeoi_", {0.009836f, 0.01721f, 0.002459f, 0.0623f, 0.03934f, 0.004098f, 0.01885f, 0.2107f, 0.03934f, 0.2672f, 0.3287f}},
+  {"_g", "nhaliroeu", {0.00105f, 0.001576f, 0.1179f, 0.05882f, 0.09611f, 0.203f, 0.2886f, 0.1447f, 0.08824f}},
+  {"gu", "ybmonirlaset", {0.001517f, 0.003035f, 0.00607f, 0.007587f, 0.03794f, 0.1654f, 0.01366f, 0.05159f, 0.3763f, 0.02883f, 0.3065f, 0.001517f}},
+  {"ut", "wnfbcrmaoslytih_ue", {0.0002572f, 0.0002572f, 0.003601f, 0.0007716f, 0.0005144f, 0.0018f, 0.001286f, 0.005401f, 0.004115f, 0.003601f, 0.002829f, 0.01389f, 0.02906f, 0.06121f, 0.03729f, 0.7503f, 0.01003f, 0.07382f}},
+  {"en", "frmuyvlnogajt_isecdb", {0.0001877f, 0.001032f, 0.0002816f, 0.00122f, 0.0007509f, 0.00169f, 0.002065f, 0.001596f, 0.01248f, 0.04299f, 0.01802f, 0.002534f, 0.2618f, 0.3675f, 0.02769f, 0.01896f, 0.05632f, 0.07847f, 0.1043f, 0.0001877f}},
+  {"nb", "uoe", {0.2f, 0.2f, 0.6f}},
+  {"be", "uwnyiglfdaehtc_sr", {0.0002139f, 0.005989f, 0.01305f, 0.01348f, 0.03701f, 0.04128f, 0.0708f, 0.0661f, 0.02738f, 0.05027f, 0.08684f, 0.02374f, 0.05198f, 0.06139f, 0.3121f, 0.05561f, 0.08278f}},
+  {"rg", "rnuiayoe_", {0.002833f, 0.002833f, 0.03966f, 0.05099f, 0.05099f, 0.008499f, 0.119f, 0.6487f, 0.07649f}},
+  {"g_", "_", {1.0f}},
+  {"_e", "jebgdchrflqusaypivxmnt", {0.0002428f, 0.0002428f, 0.0004857f, 0.001214f, 0.003157f, 0.004857f, 0.002914f, 0.004371f, 0.01506f, 0.02793f, 0.01238f, 0.002671f, 0.03497f, 0.09155f, 0.06168f, 0.004857f, 0.03181f, 0.1744f, 0.1955f, 0.08135f, 0.2421f, 0.006314f}},
+  {"ex", "q_ouhaiecpt", {0.001083f, 0.004334f, 0.005417f, 0.00325f, 0.01517f, 0.1246f, 0.06176f, 0.1094f, 0.208f, 0.3012f, 0.1658f}},
+  {"xt", "syouierh_", {0.005495f, 0.07143f, 0.01099f, 0.02198f, 0.06593f, 0.1868f, 0.2473f, 0.01648f, 0.3736f}},
+  {"t_", "_", {1.0f}},
+  {"_o", "igasmdlhwtvcrubn_pf", {0.0007168f, 0.0001593f, 0.001035f, 0.0003982f, 0.0007168f, 0.0008761f, 0.005575f, 0.02015f, 0.01195f, 0.02382f, 0.01784f, 0.006452f, 0.0677f, 0.06133f, 0.0223f, 0.1834f, 0.01107f, 0.02708f, 0.5375f}},
+  {"of", "musaitoef_", {0.0001449f, 0.0004348f, 0.001159f, 0.001014f, 0.001159f, 0.01087f, 0.004928f, 0.0005797f, 0.04652f, 0.9332f}},
+  {"f_", "_", {1.0f}},
+  {"he", "wupocbidnemlsvryatf_", {0.00007255f, 0.0001088f, 0.00003628f, 0.000653f, 0.0004353f, 0.0001088f, 0.01611f, 0.0189f, 0.04933f, 0.002648f, 0.01981f, 0.01146f, 0.01988f, 0.002249f, 0.137f, 0.02547f, 0.02804f, 0.01001f, 0.001705f, 0.656f}},
+  {"_t", "_yuaerwioh", {0.004111f, 0.00025f, 0.006611f, 0.01839f, 0.01878f, 0.03047f, 0.01736f, 0.01947f, 0.2156f, 0.669f}},
+  {"th", "hdflswuy_ioaer", {0.00006474f, 0.0007446f, 0.0009388f, 0.0001295f, 0.002169f, 0.0001942f, 0.004208f, 0.002201f, 0.09025f, 0.083f, 0.08226f, 0.1251f, 0.5871f, 0.02159f}},
+  {"hr", "yuaioe", {0.002821f, 0.04654f, 0.01269f, 0.02539f, 0.3258f, 0.5867f}},
+  {"_m", "lriymoae_u", {0.00008148f, 0.0008148f, 0.1311f, 0.143f, 0.01898f, 0.1832f, 0.2228f, 0.1829f, 0.02705f, 0.09004f}},
+  {"mu", "edfzmlntrcs", {0.0007974f, 0.004785f, 0.0007974f, 0.0007974f, 0.0007974f, 0.02552f, 0.02313f, 0.02392f, 0.1284f, 0.2057f, 0.5853f}},
+  {"us", "cuyhpinlbtaqse_k", {0.005683f, 0.0108f, 0.004263f, 0.03438f, 0.02756f, 0.03666f, 0.003694f, 0.0216f, 0.02018f, 0.2214f, 0.03012f, 0.01733f, 0.01336f, 0.1733f, 0.2737f, 0.106f}},
+  {"sk", "uslai_ye", {0.001205f, 0.01084f, 0.001205f, 0.001205f, 0.06747f, 0.1578f, 0.007229f, 0.753f}},
+  {"ke", "srlyp_dnewt", {0.02513f, 0.02698f, 0.007761f, 0.05654f, 0.01478f, 0.3829f, 0.1792f, 0.08352f, 0.02846f, 0.01589f, 0.1789f}},
+  {"et", "bfnyrcswhuoita_le", {0.0005358f, 0.0008036f, 0.001607f, 0.01259f, 0.02947f, 0.01714f, 0.02197f, 0.02732f, 0.06751f, 0.05974f, 0.02277f, 0.03991f, 0.1374f, 0.02009f, 0.3941f, 0.007769f, 0.1393f}},
+  {"te", "ktgouwfvplcma_sdrnxe", {0.0001312f, 0.0005247f, 0.0009183f, 0.0007871f, 0.0003935f, 0.001443f, 0.001705f, 0.003673f, 0.01745f, 0.07425f, 0.008264f, 0.01272f, 0.01286f, 0.1388f, 0.03411f, 0.2142f, 0.3036f, 0.1136f, 0.001443f, 0.05916f}},
+  {"ee", "fvzbacidslpktnm_r", {0.0003077f, 0.001846f, 0.001846f, 0.001231f, 0.009231f, 0.005231f, 0.03015f, 0.08585f, 0.01908f, 0.02923f, 0.05846f, 0.02462f, 0.06954f, 0.3015f, 0.028f, 0.2188f, 0.1151f}},
+  {"rs", "ydcphauoiet_", {0.0003373f, 0.001012f, 0.001012f, 0.002024f, 0.002024f, 0.03744f, 0.01315f, 0.04384f, 0.01518f, 0.2587f, 0.1477f, 0.4776f}},
+  {"_b", "_liuaroey", {0.0002021f, 0.0285f, 0.01142f, 0.2001f, 0.07175f, 0.07024f, 0.09217f, 0.4134f, 0.1122f}},
+  {"by", "rpls_", {0.001779f, 0.0008897f, 0.0008897f, 0.006228f, 0.9902f}},
+  {"y_", "_", {1.0f}},
+  {"_d", "ywroi_aeu", {0.002823f, 0.00192f, 0.05793f, 0.2002f, 0.1427f, 0.2101f, 0.06832f, 0.2683f, 0.04765f}},
+  {"du", "ho_bvgnapsjetklrcm", {0.00312f, 0.00156f, 0.01248f, 0.00312f, 0.00156f, 0.00312f, 0.02028f, 0.00624f, 0.01716f, 0.01872f, 0.00156f, 0.06084f, 0.05928f, 0.259f, 0.04212f, 0.1201f, 0.3604f, 0.00936f}},
+  {"um", "vhousmni_ebpa", {0.002146f, 0.002146f, 0.0279f, 0.01502f, 0.07725f, 0.04292f, 0.008584f, 0.06438f, 0.1137f, 0.3433f, 0.133f, 0.1245f, 0.04506f}},
+  {"ma", "bxmjcp_kzyrgtidunls", {0.0004873f, 0.001218f, 0.0004873f, 0.04215f, 0.003655f, 0.000731f, 0.001706f, 0.06993f, 0.001218f, 0.07164f, 0.04386f, 0.0251f, 0.03899f, 0.05726f, 0.1618f, 0.02973f, 0.3882f, 0.01852f, 0.04337f}},
+  {"as", "qdalmyouiphckest_", {0.0003861f, 0.0001287f, 0.00193f, 0.002059f, 0.002188f, 0.008107f, 0.007978f, 0.009909f, 0.01634f, 0.004504f, 0.009265f, 0.01531f, 0.0462f, 0.0323f, 0.1027f, 0.1226f, 0.6181f}},
+  {"s_", "_", {1.0f}},
+  {"__", "zxjukyqvnwflisrcahgeotmbdp", {0.00003434f, 0.000176f, 0.00261f, 0.008769f, 0.007378f, 0.0268f, 0.00306f, 0.005309f, 0.02059f, 0.07336f, 0.03474f, 0.02387f, 0.06339f, 0.06616f, 0.02173f, 0.03743f, 0.1195f, 0.07908f, 0.01634f, 0.01767f, 0.05389f, 0.1545f, 0.05268f, 0.04247f, 0.03801f, 0.03047f}},
+  {"_p", "s_huaolire", {0.0007043f, 0.0002817f, 0.005916f, 0.05381f, 0.2096f, 0.1988f, 0.134f, 0.04212f, 0.2298f, 0.1251f}},
+  {"pe", "ypgsteoflc_danr", {0.000668f, 0.000334f, 0.000668f, 0.01503f, 0.009018f, 0.01136f, 0.02338f, 0.004342f, 0.01002f, 0.07715f, 0.05745f, 0.07548f, 0.2301f, 0.1503f, 0.3347f}},
+  {"er", "jkuqbphclwanrfmdvity_ogse", {0.00007053f, 0.001481f, 0.0006347f, 0.00007053f, 0.001763f, 0.003033f, 0.01044f, 0.02299f, 0.004091f, 0.00402f, 0.01516f, 0.01192f, 0.02045f, 0.01023f, 0.01135f, 0.004091f, 0.02638f, 0.02976f, 0.02729f, 0.05163f, 0.4646f, 0.006841f, 0.002751f, 0.1013f, 0.1676f}},
+  {"re", "zkoiqyjhrwblavfpnsumtgcde_", {0.0002211f, 0.0001474f, 0.001916f, 0.003169f, 0.008476f, 0.0004422f, 0.002137f, 0.005233f, 0.003243f, 0.0126f, 0.0008107f, 0.02115f, 0.09456f, 0.03928f, 0.01909f, 0.05425f, 0.0213f, 0.1072f, 0.003169f, 0.03648f, 0.04879f, 0.007518f, 0.044f, 0.1102f, 0.04135f, 0.3133f}},
+  {"e_", "_", {1.0f}}
+};
+
+} // end namespace
+} // end namespace
+
+#endif /*! _PBBS_PCTL_TRIGRAMDATA_H_ */
@@ -20,129 +20,210 @@
 // OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
 // WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
-#include <math.h>
-#include <iostream>
+#include <stdint.h>
+#include <string>
+#include <vector>
 #include <fstream>
 
 #include "datapar.hpp"
 #include "prandgen.hpp"
-#include "suffixarray.hpp"
+#include "utils.hpp"
+#include "trigramdata.hpp"
 
 #ifndef _PCTL_TRIGRAMS_H_
 #define _PCTL_TRIGRAMS_H_
 
 namespace pasl {
 namespace pctl {
-  
-  using namespace std;
+
+// Text drawn from the trigram table of trigramdata.hpp: words are chains
+// of characters, each drawn given the two before it, and are separated by
+// single spaces. The character at position p of the text is drawn from
+// the hash of p by the alias method
+//   Michael D. Vose
+//   A linear algorithm for generating random numbers with a given distribution
+//   IEEE Transactions on Software Engineering 17(9), 1991
+// in constant time: one multiplication of the hash picks a column and a
+// fraction, which selects the column or its alias.
+//
+// trigram_text cuts the text into blocks of TRIGRAM_BLOCK characters
+// generated in parallel, each starting a new word, so that the text only
+// depends on its bounds.
+
+#define TRIGRAM_BLOCK (1 << 16)
 
 struct nGramTable {
-  int len;
-  
+
   struct tableEntry {
-    char str[10];
     int len;
     char chars[27];
-    float probs[27];
+    char alias[27];
+    uint32_t cut[27];
   };
-  
+
   tableEntry S[27][27];
-  
-  int index(char c) {
-    if (c=='_') return 26;
-    else return (c-'a');
+
+  static int index(char c) {
+    return (c == '_') ? 26 : (c - 'a');
   }
-  
+
+  // Alias table of one context, by Vose's method: columns of probability
+  // below 1 / len are topped up by a column above it
+  void build(tableEntry& E, const trigram_entry& x) {
+    int len = (int) std::string(x.chars).length();
+    E.len = len;
+    double sum = 0.0;
+    for (int j = 0; j < len; j++) {
+      sum += x.probs[j];
+    }
+    double q[27];
+    std::vector<int> small;
+    std::vector<int> large;
+    for (int j = 0; j < len; j++) {
+      E.chars[j] = x.chars[j];
+      E.alias[j] = x.chars[j];
+      q[j] = x.probs[j] * len / sum;
+      if (q[j] < 1.0) {
+        small.push_back(j);
+      } else {
+        large.push_back(j);
+      }
+    }
+    while (!small.empty() && !large.empty()) {
+      int j = small.back();
+      small.pop_back();
+      int k = large.back();
+      E.cut[j] = (uint32_t) (q[j] * 4294967296.0);
+      E.alias[j] = x.chars[k];
+      q[k] -= 1.0 - q[j];
+      if (q[k] < 1.0) {
+        large.pop_back();
+        small.push_back(k);
+      }
+    }
+    // the columns left are full, up to rounding
+    for (int j : small) {
+      E.cut[j] = UINT32_MAX;
+    }
+    for (int j : large) {
+      E.cut[j] = UINT32_MAX;
+    }
+  }
+
   nGramTable() {
-    const std::string fname = "/Users/rainey/Work/graph/pctl/bench/trigrams.txt";
-    std::ifstream ifile(fname);
-    if (!ifile.is_open()) {
-      std::cout << "nGramTable: Unable to open trigram file" << endl;
-      abort();
-    } else {
-      int i=0;
-      while (! ifile.eof()) {
-        tableEntry x;
-        ifile >> x.str >> x.len;
-        float probSum = 0.0;
-        for (int j=0; j < x.len; j++) {
-          float prob;
-          ifile >> x.chars[j] >> prob;
-          probSum += prob;
-          if (j == x.len-1) x.probs[j] = 1.0;
-          else x.probs[j] = probSum;
-        }
-        int i0 = index(x.str[0]);
-        int i1 = index(x.str[1]);
-        if (i0 > 26 || i1 > 26) abort();
-        S[i0][i1] = x;
-        i++;
+    // contexts missing from the table end the word
+    for (int i0 = 0; i0 < 27; i0++) {
+      for (int i1 = 0; i1 < 27; i1++) {
+        S[i0][i1].len = 1;
+        S[i0][i1].chars[0] = S[i0][i1].alias[0] = '_';
+        S[i0][i1].cut[0] = UINT32_MAX;
       }
-      len = i;
+    }
+    for (int i = 0; i < nb_trigram_entries; i++) {
+      const trigram_entry& x = trigram_entries[i];
+      build(S[index(x.context[0])][index(x.context[1])], x);
     }
   }
-  
-  char next(char c0, char c1, int i) {
-    int j=0;
-    tableEntry E = S[index(c0)][index(c1)];
-    double x = prandgen::hash<double>(i);
-    while (x > E.probs[j]) j++;
-    return E.chars[j];
+
+  char next(char c0, char c1, long i) const {
+    const tableEntry& E = S[index(c0)][index(c1)];
+    uint32_t h = prandgen::hashu((unsigned int) (i ^ (i >> 32)));
+    uint64_t x = (uint64_t) h * E.len;
+    int j = (int) (x >> 32);
+    return ((uint32_t) x < E.cut[j]) ? E.chars[j] : E.alias[j];
   }
-  
-  int word(int i, char* a, int maxLen) {
-    a[0] = next('_','_',i);
-    a[1] = next('_',a[0],i+1);
-    int j = 1;
-    while (a[j] != '_' && j < maxLen-1) {
-      j++;
-      a[j] = next(a[j-2],a[j-1],i+j);
+
+  // Writes the word starting at position i of the text to a, without its
+  // terminating boundary, and returns its length, at most maxLen. The
+  // context "__" never ends a word, so that words are not empty.
+  long word(long i, char* a, long maxLen) const {
+    char c0 = '_';
+    char c1 = '_';
+    long j = 0;
+    while (j < maxLen) {
+      char c = next(c0, c1, i + j);
+      if (c == '_') {
+        break;
+      }
+      a[j++] = c;
+      c0 = c1;
+      c1 = c;
     }
-    a[j] = 0;
-    return j+1;
+    return j;
   }
-  
-  int wordLength(int i, int maxLen) {
-    char a0 = next('_','_',i);
-    char a1 = next('_',a0,i+1);
-    int j = 1;
-    while (a1 != '_' && j < maxLen-1) {
-      j++;
-      char tmp = next(a0,a1,i+j);
-      a0 = a1; a1 = tmp;
+
+  // Allocated with new[], as the words of load_trigram_words are freed
+  char* word(long i) const {
+    const long MAX_LEN = 100;
+    char a[MAX_LEN];
+    long l = word(i, a, MAX_LEN);
+    char* out = new char[l + 1];
+    for (long j = 0; j < l; j++) {
+      out[j] = a[j];
     }
-    return j+1;
-  }
-  
-  char* word(int i) {
-    int MAX_LEN = 100;
-    char a[MAX_LEN+1];
-    int l = word(i, a, MAX_LEN);
-    char* out = newA(char,l);
-    for(intT j=0; j < l; j++) out[j] = a[j];
+    out[l] = 0;
     return out;
   }
-  
-  char* string(intT s, intT e) {
-    intT n = e - s;
-    char* a = newA(char,n+1);
-    intT j=0;
+
+  // Writes positions [s, e) of the text to a, starting with a word
+  void string(long s, long e, char* a) const {
+    long n = e - s;
+    long j = 0;
     while (j < n) {
-      intT l = word(j+s,a+j,n-j);
-      a[j+l-1] = ' ';
-      j += l;
+      j += word(s + j, a + j, n - j);
+      if (j < n) {
+        a[j++] = ' ';
+      }
     }
-    a[n] = 0;
+  }
+
+  char* string(long s, long e) const {
+    char* a = newA(char, e - s + 1);
+    string(s, e, a);
+    a[e - s] = 0;
     return a;
   }
 };
 
-char* trigramString(intT s, intT e) {
-  nGramTable T = nGramTable();
-  return T.string(s, e);
+// Writes positions [s, e) of the text to out, in parallel
+void trigram_text(char* out, long s, long e) {
+  nGramTable T;
+  long n = e - s;
+  long nb_blocks = (n + TRIGRAM_BLOCK - 1) / TRIGRAM_BLOCK;
+  parallel_for(0L, nb_blocks, [&] (long b) {
+    long lo = b * TRIGRAM_BLOCK;
+    long hi = std::min(n, lo + TRIGRAM_BLOCK);
+    T.string(s + lo, s + hi, out + lo);
+  });
+}
+
+std::string trigram_text(long s, long e) {
+  std::string result(e - s, ' ');
+  trigram_text(&result[0], s, e);
+  return result;
+}
+
+// Writes the first n characters of the text to a file, generating them in
+// chunks of chunk characters, a multiple of TRIGRAM_BLOCK, so that the
+// memory used does not depend on n
+void trigram_text_to_file(std::string file, long n, long chunk = 1L << 26) {
+  std::ofstream out(file, std::ofstream::binary);
+  std::vector<char> buffer(std::min(n, chunk));
+  for (long s = 0; s < n; s += chunk) {
+    long e = std::min(n, s + chunk);
+    trigram_text(buffer.data(), s, e);
+    out.write(buffer.data(), e - s);
+  }
+}
+
+char* trigramString(long s, long e) {
+  char* a = newA(char, e - s + 1);
+  trigram_text(a, s, e);
+  a[e - s] = 0;
+  return a;
 }
 
 } // end namespace
 } // end namespace
 
-#endif /*! _PCTL_TRIGRAMS_H_ */
\ No newline at end of file
+#endif /*! _PCTL_TRIGRAMS_H_ */
@@ -0,0 +1,66 @@
+/* COPYRIGHT (c) 2015 Umut Acar, Arthur Chargueraud, and Michael
+ * Rainey
+ * All rights reserved.
+ *
+ * \file uint40.hpp
+ * \brief Packed 40-bit unsigned integers
+ *
+ */
+
+#include <stdint.h>
+#include <iostream>
+
+#ifndef _PBBS_PCTL_UINT40_H_
+#define _PBBS_PCTL_UINT40_H_
+
+namespace pasl {
+namespace pctl {
+
+// An unsigned integer of 40 bits stored in 5 bytes, for arrays of indices
+// into inputs larger than 2^32 items that should not take 8 bytes per
+// index. Values convert implicitly to and from long, so that arithmetic is
+// done on longs and only the storage is packed.
+#pragma pack(push, 1)
+class uint40 {
+private:
+  uint32_t lo;
+  uint8_t hi;
+
+public:
+
+  static constexpr long max_value = (1L << 40) - 1;
+
+  uint40() = default;
+
+  uint40(long x)
+  : lo((uint32_t) x), hi((uint8_t) (x >> 32)) { }
+
+  operator long() const {
+    return (long) lo | ((long) hi << 32);
+  }
+
+};
+#pragma pack(pop)
+
+static_assert(sizeof(uint40) == 5, "uint40 must be packed in 5 bytes");
+
+inline std::ostream& operator<<(std::ostream& out, const uint40& x) {
+  out << (long) x;
+  return out;
+}
+
+// The type in which computations on indices of type Index are done
+template <class Index>
+struct index_arithmetic {
+  using type = Index;
+};
+
+template <>
+struct index_arithmetic<uint40> {
+  using type = long;
+};
+
+} // end namespace
+} // end namespace
+
+#endif /*! _PBBS_PCTL_UINT40_H_ */
@@ -14,7 +14,7 @@
 #include "prandgen.hpp"
 #include "geometrydata.hpp"
 #include "delaunay.hpp"
-#include "topology.hpp"
+#include "halfedge.hpp"
 
 /***********************************************************************/
 
@@ -35,7 +35,8 @@ std::ostream& operator<<(std::ostream& out, const container_wrapper<Container>&
 
 
 void generate(size_t _nb, parray<point2d>& dst) {
-  intT nb = (intT)_nb;
+  // the bounding circle of delaunay needs two distinct points
+  intT nb = std::max((intT)_nb, 2);
   if (quickcheck::generateInRange(0, 1) == 0) {
     dst = plummer2d(nb);
   } else {
@@ -50,33 +51,208 @@ void generate(size_t nb, container_wrapper<parray<point2d>>& c) {
 
 /*---------------------------------------------------------------------*/
 /* Quickcheck properties */
-  
-bool dcheck(triangles<point2d> Tri, parray<point2d>& P) {
-  intT m = Tri.numTriangles;
-  for (intT i=0; i < P.size(); i++)
-    if (P[i].x != Tri.P[i].x || P[i].y != Tri.P[i].y) {
-      cout << "checkDelaunay: prefix of points don't match input at "
-      << i << endl;
-      cout << P[i] << " " << Tri.P[i] << endl;
-      return 0;
+
+// number of boundary points of delaunay
+#define DELAUNAY_TEST_BOUNDARY_SIZE 10
+
+// Checks that every triangle in use is counterclockwise, that the twin of
+// every half-edge goes the other way and has it as twin, and that the out
+// half-edge of every vertex starts from it, and returns the number of
+// half-edges on the boundary, or -1 if the mesh is broken
+long check_mesh(const halfedge_mesh& mesh) {
+  long m = mesh.nb_triangles();
+  long nb_boundary = 0;
+  for (long t = 0; t < m; t++) {
+    if (! mesh.alive((int) t)) {
+      continue;
+    }
+    for (int h = 3 * (int) t; h < 3 * (int) t + 3; h++) {
+      int g = mesh.twin[h];
+      if (g < 0) {
+        nb_boundary++;
+      } else if (! mesh.alive(halfedge_mesh::face(g)) || mesh.twin[g] != h
+                 || mesh.origin[g] != mesh.target(h) || mesh.target(g) != mesh.origin[h]) {
+        cout << "check_mesh: half-edge " << h << " and its twin " << g << " do not match" << endl;
+        return -1;
+      }
+    }
+    const int* u = &mesh.origin[3 * t];
+    if (triangle_area(mesh.points[u[0]], mesh.points[u[1]], mesh.points[u[2]]) <= 0.0) {
+      cout << "check_mesh: triangle " << t << " is not counterclockwise" << endl;
+      return -1;
+    }
+  }
+  for (long u = 0; u < mesh.nb_vertices(); u++) {
+    int h = mesh.out[u];
+    if (h >= 0 && (! mesh.alive(halfedge_mesh::face(h)) || mesh.origin[h] != u)) {
+      cout << "check_mesh: out half-edge " << h << " does not start from " << u << endl;
+      return -1;
+    }
+  }
+  return nb_boundary;
+}
+
+// Checks that the apex of the twin of every half-edge is not in the
+// circumcircle of its triangle, up to a small error
+bool check_empty_circles(const halfedge_mesh& mesh) {
+  long m = mesh.nb_triangles();
+  for (long t = 0; t < m; t++) {
+    if (! mesh.alive((int) t)) {
+      continue;
+    }
+    for (int h = 3 * (int) t; h < 3 * (int) t + 3; h++) {
+      int g = mesh.twin[h];
+      if (g < 0) {
+        continue;
+      }
+      point2d v = mesh.points[mesh.apex(g)];
+      if (mesh.in_circle(h, v)) {
+        const int* u = &mesh.origin[3 * t];
+        double vz = inCircleNormalized(mesh.points[u[0]], mesh.points[u[1]], mesh.points[u[2]], v);
+        if (vz > 1e-10) {
+          cout << "check_empty_circles: in circle violation at triangle " << t << endl;
+          return false;
+        }
+      }
     }
-  vertex* V = NULL;
-  tri* Triangs = NULL;
-  exit(0);
-  //todo: uncomment below and fix type error
-  //topologyFromTriangles(Tri, &V, &Triangs);
-  return checkDelaunay(Triangs, m, 10);
+  }
+  return true;
+}
+
+// Checks that the points of T start with those of P, that its triangles
+// are counterclockwise, which the half-edge mesh built from T does not
+// check, as it turns clockwise triangles around, and that the mesh is a
+// Delaunay triangulation with the boundary of delaunay
+bool dcheck(triangles<point2d> T, parray<point2d>& P) {
+  for (intT i = 0; i < P.size(); i++) {
+    if (P[i].x != T.p[i].x || P[i].y != T.p[i].y) {
+      cout << "dcheck: prefix of points don't match input at " << i << endl;
+      cout << P[i] << " " << T.p[i] << endl;
+      return false;
+    }
+  }
+  for (long t = 0; t < T.num_triangles; t++) {
+    int* u = T.t[t].vertices;
+    if (triangle_area(T.p[u[0]], T.p[u[1]], T.p[u[2]]) <= 0.0) {
+      cout << "dcheck: triangle " << t << " is not counterclockwise" << endl;
+      return false;
+    }
+  }
+  halfedge_mesh mesh(T);
+  long nb_boundary = check_mesh(mesh);
+  if (nb_boundary != DELAUNAY_TEST_BOUNDARY_SIZE) {
+    cout << "dcheck: " << nb_boundary << " boundary edges, should be "
+    << DELAUNAY_TEST_BOUNDARY_SIZE << endl;
+    return false;
+  }
+  return check_empty_circles(mesh);
 }
 
 using parray_wrapper = container_wrapper<parray<point2d>>;
 
-class prop : public quickcheck::Property<parray_wrapper> {
+template <bool dynamic_location, bool brio>
+class delaunay_property : public quickcheck::Property<parray_wrapper> {
+public:
+  
+  bool holdsFor(const parray_wrapper& _in) {
+    parray_wrapper in(_in);
+    triangles<point2d> tri = delaunay(in.c, dynamic_location, brio);
+    bool b = dcheck(tri, in.c);
+    tri.del();
+    return b;
+  }
+  
+};
+
+// The triangles of a Delaunay triangulation of the input, half of them
+// given clockwise, make the same mesh, with every triangle turned
+// counterclockwise and paired with its neighbors
+class halfedge_twins_property : public quickcheck::Property<parray_wrapper> {
+public:
+  
+  bool holdsFor(const parray_wrapper& _in) {
+    parray_wrapper in(_in);
+    triangles<point2d> tri = delaunay(in.c);
+    for (long t = 0; t < tri.num_triangles; t += 2) {
+      int* u = tri.t[t].vertices;
+      std::swap(u[1], u[2]);
+    }
+    halfedge_mesh mesh(tri);
+    bool b = check_mesh(mesh) == DELAUNAY_TEST_BOUNDARY_SIZE && check_empty_circles(mesh);
+    tri.del();
+    return b;
+  }
+  
+};
+
+// Splitting a triangle of a Delaunay triangulation of the input at its
+// centroid, and a boundary edge at its middle, leaves a valid mesh with
+// one more boundary edge
+class halfedge_split_property : public quickcheck::Property<parray_wrapper> {
+public:
+  
+  bool holdsFor(const parray_wrapper& _in) {
+    parray_wrapper in(_in);
+    triangles<point2d> tri = delaunay(in.c);
+    long n = tri.num_points;
+    long m = tri.num_triangles;
+    halfedge_mesh mesh(tri, 2, 3);
+    int t = quickcheck::generateInRange(0, (int) m - 1);
+    int* u = &mesh.origin[3 * t];
+    point2d a = mesh.points[u[0]], b = mesh.points[u[1]], c = mesh.points[u[2]];
+    mesh.points[n] = point2d((a.x + b.x + c.x) / 3.0, (a.y + b.y + c.y) / 3.0);
+    mesh.split(3 * t, (int) n, (int) m, (int) m + 1);
+    if (check_mesh(mesh) != DELAUNAY_TEST_BOUNDARY_SIZE || mesh.origin[mesh.out[n]] != n) {
+      tri.del();
+      return false;
+    }
+    int h = 0;
+    while (mesh.twin[h] >= 0 || ! mesh.alive(halfedge_mesh::face(h))) {
+      h++;
+    }
+    point2d p = mesh.points[mesh.origin[h]], q = mesh.points[mesh.target(h)];
+    mesh.points[n + 1] = point2d((p.x + q.x) / 2.0, (p.y + q.y) / 2.0);
+    mesh.split_boundary(h, (int) n + 1, (int) m + 2);
+    bool ok = check_mesh(mesh) == DELAUNAY_TEST_BOUNDARY_SIZE + 1 && mesh.origin[mesh.out[n + 1]] == n + 1;
+    tri.del();
+    return ok;
+  }
+  
+};
+
+// Flipping an inner edge of a Delaunay triangulation of the input, in a
+// convex quadrilateral, leaves a valid mesh with the other diagonal, and
+// flipping it back gives the Delaunay triangulation again
+class halfedge_flip_property : public quickcheck::Property<parray_wrapper> {
 public:
   
   bool holdsFor(const parray_wrapper& _in) {
     parray_wrapper in(_in);
-    triangles<point2d> tri = delaunay(in.c.begin(), in.c.size());
-    return ! dcheck(tri, in.c);
+    triangles<point2d> tri = delaunay(in.c);
+    halfedge_mesh mesh(tri);
+    tri.del();
+    int nb_halfedges = 3 * (int) mesh.nb_triangles();
+    int first = quickcheck::generateInRange(0, nb_halfedges - 1);
+    for (int i = 0; i < nb_halfedges; i++) {
+      int h = (first + i) % nb_halfedges;
+      int g = mesh.twin[h];
+      if (g < 0) {
+        continue;
+      }
+      int a = mesh.origin[h], b = mesh.target(h), c = mesh.apex(h), d = mesh.apex(g);
+      if (triangle_area(mesh.points[d], mesh.points[c], mesh.points[a]) <= 0.0
+          || triangle_area(mesh.points[c], mesh.points[d], mesh.points[b]) <= 0.0) {
+        continue;
+      }
+      mesh.flip(h);
+      if (check_mesh(mesh) != DELAUNAY_TEST_BOUNDARY_SIZE
+          || mesh.origin[h] != d || mesh.target(h) != c) {
+        return false;
+      }
+      mesh.flip(h);
+      return check_mesh(mesh) == DELAUNAY_TEST_BOUNDARY_SIZE && check_empty_circles(mesh);
+    }
+    return true;
   }
   
 };
@@ -89,7 +265,12 @@ public:
 int main(int argc, char** argv) {
   pbbs::launch(argc, argv, [&] {
     int nb_tests = pasl::util::cmdline::parse_or_default_int("n", 1000);
-    checkit<pasl::pctl::prop>(nb_tests, "delaunay triangulation is correct");
+    checkit<pasl::pctl::delaunay_property<false, false>>(nb_tests, "delaunay triangulation is correct");
+    checkit<pasl::pctl::delaunay_property<true, false>>(nb_tests, "delaunay triangulation with dynamic location is correct");
+    checkit<pasl::pctl::delaunay_property<false, true>>(nb_tests, "delaunay triangulation by brio is correct");
+    checkit<pasl::pctl::halfedge_twins_property>(nb_tests, "half-edge twins are paired");
+    checkit<pasl::pctl::halfedge_split_property>(nb_tests, "half-edge split and split_boundary are correct");
+    checkit<pasl::pctl::halfedge_flip_property>(nb_tests, "half-edge flip is correct");
   });
   return 0;
 }
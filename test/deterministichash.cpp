@@ -9,11 +9,13 @@
  */
 
 #include <set>
+#include <string>
 
 #include "test.hpp"
 #include "prandgen.hpp"
 #include "sequenceio.hpp"
 #include "deterministichash.hpp"
+#include "stringintern.hpp"
 
 /***********************************************************************/
 
@@ -129,6 +131,41 @@ public:
   
 };
 
+// Interning the decimal strings of the numbers gives one id per distinct
+// number, in the lexicographic order of the strings
+class intern_prop : public quickcheck::Property<parray_wrapper> {
+public:
+
+  bool holdsFor(const parray_wrapper& _in) {
+    long n = _in.c.size();
+    parray<std::string> strings(n, [&] (long i) {
+      return std::to_string(_in.c[i]);
+    });
+    parray<char*> a(n, [&] (long i) {
+      return (char*) strings[i].c_str();
+    });
+    parray<int> ids;
+    string_dictionary dict = intern_strings(a, ids);
+    std::set<std::string> distinct(strings.cbegin(), strings.cend());
+    if (dict.size() != distinct.size()) {
+      return false;
+    }
+    long id = 0;
+    for (auto it = distinct.cbegin(); it != distinct.cend(); it++, id++) {
+      if (*it != dict[id] || dict.find(it->c_str()) != id) {
+        return false;
+      }
+    }
+    for (long i = 0; i < n; i++) {
+      if (strings[i] != dict[ids[i]]) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+};
+
 } // end namespace
 } // end namespace
 
@@ -138,6 +175,7 @@ int main(int argc, char** argv) {
   pbbs::launch(argc, argv, [&] {
     int nb_tests = pasl::util::cmdline::parse_or_default_int("n", 1000);
     checkit<pasl::pctl::prop>(nb_tests, "deterministic hash is correct");
+    checkit<pasl::pctl::intern_prop>(nb_tests, "string interning is correct");
   });
   return 0;
 }
@@ -0,0 +1,136 @@
+/*!
+ * \file externalsort.cpp
+ * \brief Quickcheck for external sort
+ * \date 2016
+ * \copyright COPYRIGHT (c) 2015 Umut Acar, Arthur Chargueraud, and
+ * Michael Rainey. All rights reserved.
+ * \license This project is released under the GNU Public License.
+ *
+ */
+
+#include <fstream>
+#include <stdlib.h>
+#include <unistd.h>
+#include "test.hpp"
+#include "prandgen.hpp"
+#include "sequencedata.hpp"
+#include "externalsort.hpp"
+
+/***********************************************************************/
+
+namespace pasl {
+namespace pctl {
+
+/*---------------------------------------------------------------------*/
+/* Quickcheck IO */
+
+template <class Container>
+std::ostream& operator<<(std::ostream& out, const container_wrapper<Container>& c) {
+  out << c.c;
+  return out;
+}
+
+/*---------------------------------------------------------------------*/
+/* Quickcheck generators */
+
+using value_type = unsigned int;
+
+void generate(size_t _nb, parray<value_type>& dst) {
+  long n = _nb * 1000;
+  std::cerr << "Size: " << n << "\n";
+  int r = quickcheck::generateInRange(0, 2);
+  if (r == 0) {
+    dst = sequencedata::rand_int_range((value_type)0, (value_type)n, (value_type)INT_MAX);
+  } else if (r == 1) {
+    int m = quickcheck::generateInRange(0, 1 << 10);
+    dst = sequencedata::almost_sorted<value_type>(0L, n, m);
+  } else {
+    value_type x = (value_type)quickcheck::generateInRange(0, INT_MAX);
+    dst = sequencedata::all_same(n, x);
+  }
+}
+
+void generate(size_t nb, container_wrapper<parray<value_type>>& c) {
+  generate(nb, c.c);
+}
+
+/*---------------------------------------------------------------------*/
+/* Quickcheck properties */
+
+using parray_wrapper = container_wrapper<parray<value_type>>;
+
+// A fresh file name in $TMPDIR, or /tmp
+std::string temporary_file_name() {
+  const char* dir = getenv("TMPDIR");
+  std::string name = std::string((dir == nullptr) ? "/tmp" : dir) + "/externalsort_XXXXXX";
+  int fd = mkstemp(&name[0]);
+  if (fd < 0) {
+    std::cerr << "externalsort: unable to create a temporary file" << std::endl;
+    exit(1);
+  }
+  close(fd);
+  return name;
+}
+
+// The input sorted with the memory of a fraction of it, which makes 2 to
+// 17 runs; such a budget holds few merge blocks, so the runs are merged
+// a few at a time over one or more passes. The output has to be the input
+// sorted by std::sort, so both sorted and a permutation of the input
+class sorted_property : public quickcheck::Property<parray_wrapper> {
+public:
+
+  bool holdsFor(const parray_wrapper& _in) {
+    long n = _in.c.size();
+    std::string infile = temporary_file_name();
+    std::string outfile = temporary_file_name();
+    std::ofstream out(infile, std::ofstream::binary);
+    out.write(reinterpret_cast<const char*>(&n), sizeof(long));
+    out.write(reinterpret_cast<const char*>(_in.c.cbegin()), sizeof(value_type) * n);
+    out.close();
+
+    long nb_runs = quickcheck::generateInRange(2, 17);
+    long run_size = std::max(1L, (n + nb_runs - 1) / nb_runs);
+    long memory = 3 * (long) sizeof(value_type) * run_size;
+    external_sort_stats stats = external_sort<value_type>(infile, outfile, memory);
+
+    std::ifstream in(outfile, std::ifstream::binary);
+    long m = -1;
+    in.read(reinterpret_cast<char*>(&m), sizeof(long));
+    parray<value_type> a;
+    a.prefix_tabulate(std::max(0L, m), 0);
+    in.read(reinterpret_cast<char*>(a.begin()), sizeof(value_type) * a.size());
+    bool complete = in.good();
+    in.close();
+    unlink(infile.c_str());
+    unlink(outfile.c_str());
+
+    if (n > 1 && (stats.nb_runs < 2 || stats.nb_merge_passes < 1)) {
+      std::cerr << "external sort made " << stats.nb_runs << " runs and "
+      << stats.nb_merge_passes << " merge passes for " << n << " items" << std::endl;
+      return false;
+    }
+    if (m != n || ! complete) {
+      std::cerr << "external sort wrote " << m << " items out of " << n << std::endl;
+      return false;
+    }
+    parray<value_type> b = _in.c;
+    std::sort(b.begin(), b.end(), std::less<value_type>());
+    return same_sequence(a.cbegin(), a.cend(), b.cbegin(), b.cend());
+  }
+
+};
+
+} // end namespace
+} // end namespace
+
+/*---------------------------------------------------------------------*/
+
+int main(int argc, char** argv) {
+  pbbs::launch(argc, argv, [&] {
+    int nb_tests = deepsea::cmdline::parse_or_default_int("n", 1000);
+    checkit<pasl::pctl::sorted_property>(nb_tests, "external sort is correct");
+  });
+  return 0;
+}
+
+/***********************************************************************/
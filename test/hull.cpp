@@ -11,7 +11,10 @@
 #include "test.hpp"
 #include "prandgen.hpp"
 #include "hull.hpp"
+#include "hull3d.hpp"
 #include "geometryio.hpp"
+#include <map>
+#include <set>
 
 /***********************************************************************/
 
@@ -45,6 +48,21 @@ void generate(size_t nb, container_wrapper<parray<point2d>>& c) {
   generate(nb, c.c);
 }
 
+void generate(size_t _nb, parray<point3d>& dst) {
+  intT nb = (intT)_nb;
+  if (quickcheck::generateInRange(0, 1) == 0) {
+    dst = plummer3d<int, unsigned int>(nb);
+  } else {
+    bool inSphere = quickcheck::generateInRange(0, 1) == 0;
+    bool onSphere = quickcheck::generateInRange(0, 1) == 0;
+    dst = uniform3d<int, unsigned int>(inSphere, onSphere, nb);
+  }
+}
+
+void generate(size_t nb, container_wrapper<parray<point3d>>& c) {
+  generate(nb, c.c);
+}
+
 
 /*---------------------------------------------------------------------*/
 /* Quickcheck properties */
@@ -149,6 +167,64 @@ public:
   
 };
 
+// Every directed edge of the mesh must appear once, with its reverse in
+// another facet, the mesh must have 2v - 4 facets over its v vertices, as
+// a triangulated sphere, and no point may be above the plane of a facet
+bool check_hull3d(parray<point3d>& points, triangles<point3d>& t) {
+  intT n = points.size();
+  if (t.num_triangles == 0) {
+    // fewer than 4 points, or coplanar ones
+    return 0;
+  }
+  std::map<std::pair<int, int>, int> edges;
+  std::set<int> vertices;
+  for (long i = 0; i < t.num_triangles; i++) {
+    for (int j = 0; j < 3; j++) {
+      int a = t.t[i].vertices[j];
+      int b = t.t[i].vertices[(j + 1) % 3];
+      vertices.insert(a);
+      edges[std::make_pair(a, b)]++;
+    }
+  }
+  for (auto& e : edges) {
+    if (e.second != 1 || edges.count(std::make_pair(e.first.second, e.first.first)) == 0) {
+      cout << "checkHull3d: not a closed mesh" << endl;
+      return 1;
+    }
+  }
+  if (t.num_triangles != 2 * (long) vertices.size() - 4) {
+    cout << "checkHull3d: " << t.num_triangles << " facets over " << vertices.size() << " vertices" << endl;
+    return 1;
+  }
+  for (long i = 0; i < t.num_triangles; i++) {
+    point3d a = points[t.t[i].vertices[0]];
+    vect3d normal = (points[t.t[i].vertices[1]] - a).cross(points[t.t[i].vertices[2]] - a);
+    normal = normal / normal.length();
+    for (intT j = 0; j < n; j++) {
+      if (normal.dot(points[j] - a) > 1e-9) {
+        cout << "checkHull3d: not convex" << endl;
+        return 1;
+      }
+    }
+  }
+  return 0;
+}
+
+using parray3d_wrapper = container_wrapper<parray<point3d>>;
+
+class consistent_hulls3d_property : public quickcheck::Property<parray3d_wrapper> {
+public:
+
+  bool holdsFor(const parray3d_wrapper& _in) {
+    parray3d_wrapper in(_in);
+    triangles<point3d> t = hull3d(in.c);
+    bool result = ! check_hull3d(in.c, t);
+    t.del();
+    return result;
+  }
+
+};
+
 } // end namespace
 } // end namespace
 
@@ -158,6 +234,7 @@ int main(int argc, char** argv) {
   pbbs::launch(argc, argv, [&] {
     int nb_tests = deepsea::cmdline::parse_or_default_int("n", 1000);
     checkit<pasl::pctl::consistent_hulls_property>(nb_tests, "quickhull is correct");
+    checkit<pasl::pctl::consistent_hulls3d_property>(nb_tests, "3d quickhull is correct");
   });
   return 0;
 }
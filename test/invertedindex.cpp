@@ -0,0 +1,150 @@
+/*!
+ * \file invertedindex.cpp
+ * \brief Quickcheck for the tokenizer, word count and inverted index
+ * \date 2016
+ * \copyright COPYRIGHT (c) 2015 Umut Acar, Arthur Chargueraud, and
+ * Michael Rainey. All rights reserved.
+ * \license This project is released under the GNU Public License.
+ *
+ */
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "test.hpp"
+#include "prandgen.hpp"
+#include "trigrams.hpp"
+#include "invertedindex.hpp"
+
+/***********************************************************************/
+
+namespace pasl {
+namespace pctl {
+
+/*---------------------------------------------------------------------*/
+/* Quickcheck IO */
+
+template <class Container>
+std::ostream& operator<<(std::ostream& out, const container_wrapper<Container>& c) {
+  out << c.c;
+  return out;
+}
+
+/*---------------------------------------------------------------------*/
+/* Quickcheck generators */
+
+// Trigram text, sometimes with capitals, digits and punctuation in it
+void generate(size_t nb, parray<char>& dst) {
+  long n = nb * 100;
+  long s = quickcheck::generateInRange(0, 1 << 20);
+  std::string x = trigram_text(s, s + n);
+  if (quickcheck::generateInRange(0, 2) == 0) {
+    for (long i = 0; i < n; i++) {
+      if (prandgen::hashi((int) (s + i)) % 8 == 0) {
+        x[i] = "AZ09,.\n-"[prandgen::hashi((int) i) % 8];
+      }
+    }
+  }
+  dst = parray<char>(n, [&] (long i) {
+    return x[i];
+  });
+}
+
+void generate(size_t nb, container_wrapper<parray<char>>& c) {
+  generate(nb, c.c);
+}
+
+/*---------------------------------------------------------------------*/
+/* Quickcheck properties */
+
+using parray_wrapper = container_wrapper<parray<char>>;
+
+// The positions of the tokens of every term, found by a sequential scan
+std::map<std::string, std::vector<long>> naive_postings(const parray<char>& a) {
+  std::map<std::string, std::vector<long>> result;
+  long n = a.size();
+  long k = 0;
+  long i = 0;
+  while (i < n) {
+    if (! is_token_char(a[i])) {
+      i++;
+      continue;
+    }
+    long j = i;
+    while (j < n && is_token_char(a[j])) {
+      j++;
+    }
+    result[std::string(a.cbegin() + i, j - i)].push_back(k++);
+    i = j;
+  }
+  return result;
+}
+
+class word_count_property : public quickcheck::Property<parray_wrapper> {
+public:
+
+  bool holdsFor(const parray_wrapper& _in) {
+    std::map<std::string, std::vector<long>> expected = naive_postings(_in.c);
+    tokens toks(_in.c.cbegin(), _in.c.size());
+    parray<std::pair<long, long>> counts = word_counts(toks);
+    if (counts.size() != expected.size()) {
+      return false;
+    }
+    for (long i = 0; i < counts.size(); i++) {
+      if (expected[toks[counts[i].first]].size() != counts[i].second) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+};
+
+// The terms come in lexicographic order, with all of their positions
+class inverted_index_property : public quickcheck::Property<parray_wrapper> {
+public:
+
+  bool holdsFor(const parray_wrapper& _in) {
+    std::map<std::string, std::vector<long>> expected = naive_postings(_in.c);
+    tokens toks(_in.c.cbegin(), _in.c.size());
+    inverted_index index(toks);
+    if (index.nb_terms() != expected.size()) {
+      return false;
+    }
+    long t = 0;
+    for (auto& e : expected) {
+      if (index.term(t) != e.first || index.find(e.first) != t) {
+        return false;
+      }
+      parray<long> p = index.postings(t);
+      if (p.size() != e.second.size() || index.count(t) != e.second.size()) {
+        return false;
+      }
+      for (long k = 0; k < p.size(); k++) {
+        if (p[k] != e.second[k]) {
+          return false;
+        }
+      }
+      t++;
+    }
+    return index.find("") == -1;
+  }
+
+};
+
+} // end namespace
+} // end namespace
+
+/*---------------------------------------------------------------------*/
+
+int main(int argc, char** argv) {
+  pbbs::launch(argc, argv, [&] {
+    int nb_tests = deepsea::cmdline::parse_or_default_int("n", 1000);
+    checkit<pasl::pctl::word_count_property>(nb_tests, "word count is correct");
+    checkit<pasl::pctl::inverted_index_property>(nb_tests, "inverted index is correct");
+  });
+  return 0;
+}
+
+/***********************************************************************/
@@ -9,12 +9,16 @@
  */
 
 #include <limits>
+#include <cmath>
 #include <float.h>
 
 #include "test.hpp"
 #include "prandgen.hpp"
 #include "geometrydata.hpp"
 #include "nearestneighbors.hpp"
+#include "pointkdtree.hpp"
+#include "dynamicindex.hpp"
+#include "knngraph.hpp"
 #include "samplesort.hpp"
 
 /***********************************************************************/
@@ -52,12 +56,30 @@ void generate(size_t nb, container_wrapper<parray<point2d>>& c) {
   generate(nb, c.c);
 }
 
+void generate(size_t _nb, parray<point3d>& dst) {
+  intT nb = (intT)_nb * 10;
+  std::cerr << "Problem size: " << nb << std::endl;
+  if (quickcheck::generateInRange(0, 1) == 0) {
+    dst = plummer3d<int, unsigned int>(nb);
+  } else {
+    bool inSphere = quickcheck::generateInRange(0, 1) == 0;
+    bool onSphere = quickcheck::generateInRange(0, 1) == 0;
+    dst = uniform3d<int, unsigned int>(inSphere, onSphere, nb);
+  }
+}
+
+void generate(size_t nb, container_wrapper<parray<point3d>>& c) {
+  generate(nb, c.c);
+}
+
 
 /*---------------------------------------------------------------------*/
 /* Quickcheck properties */
 
+// with eps > 0, the i-th neighbour may be up to 1 + eps farther than the
+// exact one
 template <class pointT>
-int check_neighbours(parray<intT>& neighbours, pointT* p, intT n, intT k) {
+int check_neighbours(parray<intT>& neighbours, pointT* p, intT n, intT k, double eps = 0.0) {
   if (neighbours.size() != k * n) {
     cout << "error in neighboursCheck: wrong length, n = " << n
     << " k = " << k << " neighbours = " << neighbours.size() << endl;
@@ -81,30 +103,93 @@ int check_neighbours(parray<intT>& neighbours, pointT* p, intT n, intT k) {
       double d = (p[j] - p[neighbours.begin()[k * j + i]]).length();
       double curd = distances[i];
 
-      if ((d - curd) / (d + curd)  > error_tolerance) {
+      if ((d - (1 + eps) * curd) / (d + curd)  > error_tolerance) {
         cout << "error in neighboursCheck: for point " << j
         << " " << k << "-th min distance reported is: " << d
         << " actual is: " << curd << endl;
         result = 1;
       }
     }
+    free(distances);
   });
   return result;
 }
   
+// The neighbours among the n points p of each of the m queries q, which
+// are not points of p: -1 past the n-th neighbour
+template <class pointT>
+int check_queries(parray<intT>& neighbours, pointT* q, intT m, pointT* p, intT n, intT k) {
+  if (neighbours.size() != k * m) {
+    cout << "error in queriesCheck: wrong length, m = " << m
+    << " k = " << k << " neighbours = " << neighbours.size() << endl;
+    return 1;
+  }
+
+  int result = 0;
+  parallel_for((intT)0, m, [&] (intT j) {
+    parray<double> distances(n, [&] (long i) {
+      return (q[j] - p[i]).length();
+    });
+    sample_sort(distances.begin(), n, std::less<double>());
+
+    double error_tolerance = 1e-6;
+    for (int i = 0; i < k; i++) {
+      int id = neighbours.begin()[k * j + i];
+      if (i >= n) {
+        if (id != -1) {
+          cout << "error in queriesCheck: for query " << j
+          << " " << i << "-th neighbour reported is: " << id
+          << " but there are only " << n << " points" << endl;
+          result = 1;
+        }
+        continue;
+      }
+      if (id < 0 || id >= n) {
+        cout << "error in queriesCheck: for query " << j
+        << " " << i << "-th neighbour reported is: " << id << endl;
+        result = 1;
+        continue;
+      }
+      double d = (q[j] - p[id]).length();
+      double curd = distances[i];
+
+      if (std::abs(d - curd) / (d + curd) > error_tolerance) {
+        cout << "error in queriesCheck: for query " << j
+        << " " << i << "-th min distance reported is: " << d
+        << " actual is: " << curd << endl;
+        result = 1;
+      }
+    }
+  });
+  return result;
+}
+
+template <class pointT>
+bool inside_box(pointT p, pointT lo, pointT hi) {
+  for (int d = 0; d < pointT::dim; d++) {
+    if (p[d] < lo[d] || p[d] > hi[d]) {
+      return false;
+    }
+  }
+  return true;
+}
+
 using parray_wrapper = container_wrapper<parray<point2d>>;
 
-template <class point, int maxK>
-class nearestneighbours_property : public quickcheck::Property<parray_wrapper> {
+template <class point>
+using points_wrapper = container_wrapper<parray<point>>;
+
+// vertices selects the tree of vertex pointers instead of the point cloud
+template <class point, int maxK, bool vertices>
+class nearestneighbours_property : public quickcheck::Property<points_wrapper<point>> {
 public:
   
-  bool holdsFor(const parray_wrapper& _in) {
-    using vertex = vertex<point, maxK>;
-    parray_wrapper in(_in);
+  bool holdsFor(const points_wrapper<point>& _in) {
+    points_wrapper<point> in(_in);
     intT n = (intT)in.c.size();
     parray<point>& points = in.c;
     int k = 10;
-    parray<int> result = ANN<intT, maxK, point>(points, n, k);
+    parray<int> result = vertices ? ANN_vertices<intT, maxK, point>(points, n, k) : ANN<intT, maxK, point>(points, n, k);
 
     int r = 10;
     return !check_neighbours(result, points.begin(), n, k);
@@ -112,6 +197,188 @@ public:
   
 };
 
+// The approximate neighbours, over the point cloud and the k-d tree,
+// within a factor 1 + eps of the exact ones
+template <class point, int maxK>
+class approximate_property : public quickcheck::Property<parray_wrapper> {
+public:
+
+  bool holdsFor(const parray_wrapper& _in) {
+    parray_wrapper in(_in);
+    intT n = (intT)in.c.size();
+    parray<point>& points = in.c;
+    int k = 10;
+    double eps = 0.5;
+    parray<int> result = ANN<intT, maxK, point>(points, n, k, eps);
+    if (check_neighbours(result, points.begin(), n, k, eps)) {
+      return false;
+    }
+    result = kdtree_ANN<intT, maxK, point>(points, n, k, eps);
+    return !check_neighbours(result, points.begin(), n, k, eps);
+  }
+
+};
+
+// The neighbours found by the k-d tree, and its radius search around
+// every point compared to a scan of all the points
+template <class point, int maxK>
+class kdtree_property : public quickcheck::Property<points_wrapper<point>> {
+public:
+
+  bool holdsFor(const points_wrapper<point>& _in) {
+    points_wrapper<point> in(_in);
+    intT n = (intT)in.c.size();
+    parray<point>& points = in.c;
+    int k = 10;
+    parray<int> result = kdtree_ANN<intT, maxK, point>(points, n, k);
+    if (check_neighbours(result, points.begin(), n, k)) {
+      return false;
+    }
+    point_kdtree<point> tree(points);
+    // queries which are not points of the tree: the midpoints of
+    // consecutive points
+    parray<point> queries(n, [&] (long i) {
+      return points[i] + (points[(i + 1) % n] - points[i]) * 0.5;
+    });
+    result = tree.template knn<maxK>(queries.begin(), n, k);
+    if (check_queries(result, queries.begin(), n, points.begin(), n, k)) {
+      return false;
+    }
+    // fewer points than neighbours asked for
+    intT few = std::min(n, (intT) k / 2);
+    point_kdtree<point> small_tree(points.begin(), few);
+    result = small_tree.template knn<maxK>(queries.begin(), n, k);
+    if (check_queries(result, queries.begin(), n, points.begin(), few, k)) {
+      return false;
+    }
+    // the boxes spanned by pairs of points
+    parray<point> lo(n, [&] (long i) {
+      return points[i].min_coord(points[(i + 7) % n]);
+    });
+    parray<point> hi(n, [&] (long i) {
+      return points[i].max_coord(points[(i + 7) % n]);
+    });
+    parray<long> box_offsets;
+    parray<int> in_box = tree.range_query(lo.begin(), hi.begin(), n, box_offsets);
+    for (intT j = 0; j < n; j++) {
+      long count = 0;
+      for (intT i = 0; i < n; i++) {
+        if (inside_box(points[i], lo[j], hi[j])) {
+          count++;
+        }
+      }
+      if (box_offsets[j + 1] - box_offsets[j] != count) {
+        cout << "error in range query: for box " << j << " found "
+        << box_offsets[j + 1] - box_offsets[j] << " points, actual is: " << count << endl;
+        return false;
+      }
+      for (long l = box_offsets[j]; l < box_offsets[j + 1]; l++) {
+        if (! inside_box(points[in_box[l]], lo[j], hi[j])) {
+          cout << "error in range query: for box " << j << " found point "
+          << in_box[l] << " out of the box" << endl;
+          return false;
+        }
+      }
+    }
+    double r = 0.05;
+    parray<long> offsets;
+    parray<int> inside = tree.radius_search(points.begin(), n, r, offsets);
+    for (intT j = 0; j < n; j++) {
+      long count = 0;
+      for (intT i = 0; i < n; i++) {
+        if ((points[j] - points[i]).length() <= r) {
+          count++;
+        }
+      }
+      if (offsets[j + 1] - offsets[j] != count) {
+        cout << "error in radius search: for point " << j << " found "
+        << offsets[j + 1] - offsets[j] << " points, actual is: " << count << endl;
+        return false;
+      }
+      for (long l = offsets[j]; l < offsets[j + 1]; l++) {
+        if ((points[j] - points[inside[l]]).length() > r) {
+          cout << "error in radius search: for point " << j << " found point "
+          << inside[l] << " out of the ball" << endl;
+          return false;
+        }
+      }
+    }
+    return true;
+  }
+
+};
+
+// The neighbours found by the dynamic index after the points are inserted
+// in batches and the even ones deleted, compared to the neighbours among
+// the odd points
+template <class point, int maxK>
+class dynamicindex_property : public quickcheck::Property<parray_wrapper> {
+public:
+
+  bool holdsFor(const parray_wrapper& _in) {
+    parray_wrapper in(_in);
+    intT n = (intT)in.c.size();
+    parray<point>& points = in.c;
+    int k = 10;
+    dynamic_point_index<point> index;
+    parray<int> ids(n, [&] (long i) {
+      return (int) i;
+    });
+    intT batch = 1 + n / 7;
+    for (intT i = 0; i < n; i += batch) {
+      index.insert(points.begin() + i, ids.cbegin() + i, std::min(batch, n - i));
+    }
+    intT m = n / 2;
+    parray<int> even(n - m, [&] (long i) {
+      return (int) (2 * i);
+    });
+    index.erase(even.cbegin(), n - m);
+    parray<point> odd(m, [&] (long i) {
+      return points[2 * i + 1];
+    });
+    parray<int> result = index.template knn<maxK>(odd.begin(), m, k + 1);
+    // the first neighbour of every odd point is itself
+    parray<intT> neighbours(m * k, [&] (long i) {
+      return (intT) (result[(i / k) * (k + 1) + i % k + 1] / 2);
+    });
+    return !check_neighbours(neighbours, odd.begin(), m, k);
+  }
+
+};
+
+// The k-nearest neighbor graph of vectors of dimension 16, as many as the
+// points, should find most of the exact neighbours
+class knngraph_property : public quickcheck::Property<parray_wrapper> {
+public:
+
+  bool holdsFor(const parray_wrapper& _in) {
+    long n = (long)_in.c.size();
+    int d = 16;
+    int k = 10;
+    parray<float> x = clustered_vectors<float>(n, d, 10);
+    graph::graph<int> g = knn_graph(x.cbegin(), n, d, k);
+    long found = 0;
+    long m = std::min((long) k, n - 1);
+    for (long u = 0; u < n; u++) {
+      parray<float> distances(n, [&] (long v) {
+        return (u == v) ? std::numeric_limits<float>::max() : squared_l2<float>::run(&x[u * d], &x[v * d], d);
+      });
+      std::sort(distances.begin(), distances.end());
+      if (g.V[u].degree != m) {
+        cout << "error in knn graph: vertex " << u << " has degree " << g.V[u].degree << endl;
+        return false;
+      }
+      for (int j = 0; j < m; j++) {
+        int v = g.V[u].Neighbors[j];
+        found += squared_l2<float>::run(&x[u * d], &x[v * d], d) <= distances[m - 1];
+      }
+    }
+    g.del();
+    return found >= 0.9 * n * m;
+  }
+
+};
+
 } // end namespace
 } // end namespace
 
@@ -120,7 +387,14 @@ public:
 int main(int argc, char** argv) {
   pbbs::launch(argc, argv, [&] {
     int nb_tests = deepsea::cmdline::parse_or_default_int("n", 1000);
-    checkit<pasl::pctl::nearestneighbours_property<point2d, 10>>(nb_tests, "nearestneighbours is correct");
+    checkit<pasl::pctl::nearestneighbours_property<pasl::pctl::point2d, 10, false>>(nb_tests, "nearestneighbours is correct");
+    checkit<pasl::pctl::nearestneighbours_property<pasl::pctl::point2d, 10, true>>(nb_tests, "nearestneighbours over vertices is correct");
+    checkit<pasl::pctl::nearestneighbours_property<pasl::pctl::point3d, 10, false>>(nb_tests, "nearestneighbours in 3d is correct");
+    checkit<pasl::pctl::approximate_property<pasl::pctl::point2d, 10>>(nb_tests, "approximate nearestneighbours are within 1 + eps");
+    checkit<pasl::pctl::kdtree_property<pasl::pctl::point2d, 10>>(nb_tests, "nearestneighbours over the k-d tree is correct");
+    checkit<pasl::pctl::kdtree_property<pasl::pctl::point3d, 10>>(nb_tests, "nearestneighbours over the k-d tree in 3d is correct");
+    checkit<pasl::pctl::dynamicindex_property<pasl::pctl::point2d, 11>>(nb_tests, "nearestneighbours over the dynamic index is correct");
+    checkit<pasl::pctl::knngraph_property>(nb_tests, "knn graph finds most neighbours");
   });
   return 0;
 }
@@ -8,6 +8,8 @@
  *
  */
 
+#include <cmath>
+#include <cstring>
 #include "test.hpp"
 #include "prandgen.hpp"
 #include "sequencedata.hpp"
@@ -73,6 +75,78 @@ public:
   
 };
 
+// Every block length the network handles, on prefixes of the input; the
+// property holds trivially when the network is not compiled in
+class sorting_network_property : public quickcheck::Property<parray_wrapper> {
+public:
+
+  bool holdsFor(const parray_wrapper& _in) {
+    long m = std::min((long)_in.c.size(), (long)SORTNET_MAX);
+    for (long l = 0; l <= m; l++) {
+      parray<value_type> a(l, [&] (long i) {
+        return _in.c[i];
+      });
+      parray<value_type> b = a;
+      if (! sorting_network_sort(a.begin(), l, std::less<value_type>())) {
+        return true;
+      }
+      std::sort(b.begin(), b.end(), std::less<value_type>());
+      if (! same_sequence(a.cbegin(), a.cend(), b.cbegin(), b.cend())) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+};
+
+// Floating-point blocks mixing +0.0, -0.0 and NaNs: the output has to be a
+// permutation of the input bit for bit, as +0.0 == -0.0
+template <class Float, class Bits>
+bool sorting_network_sorts_floats(const parray<value_type>& in) {
+  Float values[] = { (Float)0.0, -(Float)0.0, (Float)1.0, -(Float)1.0, (Float)NAN };
+  long m = std::min((long)in.size(), (long)SORTNET_MAX);
+  for (long l = 0; l <= m; l++) {
+    parray<Float> a(l, [&] (long i) {
+      return (in[i] % 8 < 5) ? values[in[i] % 8] : (Float)in[i];
+    });
+    parray<Float> b = a;
+    if (! sorting_network_sort(a.begin(), l, std::less<Float>())) {
+      return true;
+    }
+    for (long i = 0; i + 1 < l; i++) {
+      if (a[i + 1] < a[i]) {
+        return false;
+      }
+    }
+    auto bits = [] (const parray<Float>& c) {
+      parray<Bits> r(c.size(), [&] (long i) {
+        Bits x;
+        memcpy(&x, &c[i], sizeof(Float));
+        return x;
+      });
+      std::sort(r.begin(), r.end());
+      return r;
+    };
+    parray<Bits> x = bits(a);
+    parray<Bits> y = bits(b);
+    if (! same_sequence(x.cbegin(), x.cend(), y.cbegin(), y.cend())) {
+      return false;
+    }
+  }
+  return true;
+}
+
+class sorting_network_float_property : public quickcheck::Property<parray_wrapper> {
+public:
+
+  bool holdsFor(const parray_wrapper& _in) {
+    return sorting_network_sorts_floats<float, uint32_t>(_in.c)
+        && sorting_network_sorts_floats<double, uint64_t>(_in.c);
+  }
+
+};
+
 } // end namespace
 } // end namespace
 
@@ -82,6 +156,8 @@ int main(int argc, char** argv) {
   pbbs::launch(argc, argv, [&] {
     int nb_tests = deepsea::cmdline::parse_or_default_int("n", 1000);
     checkit<pasl::pctl::sorted_property>(nb_tests, "samplesort is correct");
+    checkit<pasl::pctl::sorting_network_property>(nb_tests, "sorting network is correct");
+    checkit<pasl::pctl::sorting_network_float_property>(nb_tests, "sorting network is correct on floats");
   });
   return 0;
 }
@@ -0,0 +1,140 @@
+/*!
+ * \file selection.cpp
+ * \brief Quickcheck for selection, partial sort and top-k
+ * \date 2016
+ * \copyright COPYRIGHT (c) 2015 Umut Acar, Arthur Chargueraud, and
+ * Michael Rainey. All rights reserved.
+ * \license This project is released under the GNU Public License.
+ *
+ */
+
+#include "test.hpp"
+#include "prandgen.hpp"
+#include "sequencedata.hpp"
+#include "selection.hpp"
+
+/***********************************************************************/
+
+namespace pasl {
+namespace pctl {
+
+/*---------------------------------------------------------------------*/
+/* Quickcheck IO */
+
+template <class Container>
+std::ostream& operator<<(std::ostream& out, const container_wrapper<Container>& c) {
+  out << c.c;
+  return out;
+}
+
+/*---------------------------------------------------------------------*/
+/* Quickcheck generators */
+
+using value_type = unsigned int;
+
+void generate(size_t _nb, parray<value_type>& dst) {
+  long n = _nb * 10000;
+  std::cerr << "Size: " << n << "\n";
+  int r = quickcheck::generateInRange(0, 2);
+  if (r == 0) {
+    dst = sequencedata::rand_int_range((value_type)0, (value_type)n, (value_type)INT_MAX);
+  } else if (r == 1) {
+    int m = quickcheck::generateInRange(0, 1 << 10);
+    dst = sequencedata::almost_sorted<value_type>(0L, n, m);
+  } else {
+    value_type m = (value_type)quickcheck::generateInRange(1, 100);
+    dst = sequencedata::rand_int_range((value_type)0, (value_type)n, m);
+  }
+}
+
+void generate(size_t nb, container_wrapper<parray<value_type>>& c) {
+  generate(nb, c.c);
+}
+
+/*---------------------------------------------------------------------*/
+/* Quickcheck properties */
+
+using parray_wrapper = container_wrapper<parray<value_type>>;
+
+int generate_k(int n) {
+  return (n == 0) ? 0 : quickcheck::generateInRange(0, n - 1);
+}
+
+class nth_element_property : public quickcheck::Property<parray_wrapper> {
+public:
+
+  bool holdsFor(const parray_wrapper& _in) {
+    parray<value_type> a = _in.c;
+    parray<value_type> b = _in.c;
+    int n = (int)a.size();
+    int k = generate_k(n);
+    if (n == 0) {
+      return true;
+    }
+    nth_element(a.begin(), n, k, std::less<value_type>());
+    std::sort(b.begin(), b.end(), std::less<value_type>());
+    if (a[k] != b[k]) {
+      return false;
+    }
+    for (int i = 0; i < n; i++) {
+      if ((i < k && a[i] > a[k]) || (i > k && a[i] < a[k])) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+};
+
+class partial_sort_property : public quickcheck::Property<parray_wrapper> {
+public:
+
+  bool holdsFor(const parray_wrapper& _in) {
+    parray<value_type> a = _in.c;
+    parray<value_type> b = _in.c;
+    int n = (int)a.size();
+    int k = generate_k(n);
+    partial_sort(a.begin(), n, k, std::less<value_type>());
+    std::partial_sort(b.begin(), b.begin() + k, b.end(), std::less<value_type>());
+    if (! same_sequence(a.cbegin(), a.cbegin() + k, b.cbegin(), b.cbegin() + k)) {
+      return false;
+    }
+    // the rest, in any order, is made of the remaining elements
+    std::sort(a.begin() + k, a.end(), std::less<value_type>());
+    std::sort(b.begin() + k, b.end(), std::less<value_type>());
+    return same_sequence(a.cbegin() + k, a.cend(), b.cbegin() + k, b.cend());
+  }
+
+};
+
+class top_k_property : public quickcheck::Property<parray_wrapper> {
+public:
+
+  bool holdsFor(const parray_wrapper& _in) {
+    parray<value_type> a = _in.c;
+    parray<value_type> b = _in.c;
+    int n = (int)a.size();
+    int k = generate_k(n);
+    parray<value_type> top = top_k(a.begin(), n, k, std::greater<value_type>());
+    std::sort(b.begin(), b.end(), std::greater<value_type>());
+    return same_sequence(top.cbegin(), top.cend(), b.cbegin(), b.cbegin() + k);
+  }
+
+};
+
+} // end namespace
+} // end namespace
+
+/*---------------------------------------------------------------------*/
+
+int main(int argc, char** argv) {
+  pbbs::launch(argc, argv, [&] {
+    int nb_tests = deepsea::cmdline::parse_or_default_int("n", 1000);
+    checkit<pasl::pctl::nth_element_property>(nb_tests, "nth_element is correct");
+    checkit<pasl::pctl::partial_sort_property>(nb_tests, "partial_sort is correct");
+    checkit<pasl::pctl::top_k_property>(nb_tests, "top_k is correct");
+  });
+  return 0;
+}
+
+/***********************************************************************/
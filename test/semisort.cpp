@@ -0,0 +1,126 @@
+/*!
+ * \file semisort.cpp
+ * \brief Quickcheck for semisort and reduce-by-key
+ * \date 2016
+ * \copyright COPYRIGHT (c) 2015 Umut Acar, Arthur Chargueraud, and
+ * Michael Rainey. All rights reserved.
+ * \license This project is released under the GNU Public License.
+ *
+ */
+
+#include <map>
+
+#include "test.hpp"
+#include "prandgen.hpp"
+#include "sequencedata.hpp"
+#include "semisort.hpp"
+
+/***********************************************************************/
+
+namespace pasl {
+namespace pctl {
+
+/*---------------------------------------------------------------------*/
+/* Quickcheck IO */
+
+template <class Container>
+std::ostream& operator<<(std::ostream& out, const container_wrapper<Container>& c) {
+  out << c.c;
+  return out;
+}
+
+/*---------------------------------------------------------------------*/
+/* Quickcheck generators */
+
+using value_type = std::pair<int, int>;
+
+void generate(size_t _nb, parray<value_type>& dst) {
+  long n = _nb;
+  if (quickcheck::generateInRange(0, 4) == 0) {
+    n *= 5000;
+  }
+  int r = quickcheck::generateInRange(0, 2);
+  int m = (r == 0) ? INT_MAX : ((r == 1) ? (int)n + 1 : quickcheck::generateInRange(1, 256));
+  parray<int> keys = sequencedata::rand_int_range(0, (int)n, m);
+  dst = parray<value_type>(n, [&] (long i) {
+    return std::make_pair(keys[i], (int)(prandgen::hashi((int)i) % 100));
+  });
+}
+
+void generate(size_t nb, container_wrapper<parray<value_type>>& c) {
+  generate(nb, c.c);
+}
+
+/*---------------------------------------------------------------------*/
+/* Quickcheck properties */
+
+using parray_wrapper = container_wrapper<parray<value_type>>;
+
+class grouped_property : public quickcheck::Property<parray_wrapper> {
+public:
+
+  bool holdsFor(const parray_wrapper& _in) {
+    parray<value_type> a = _in.c;
+    parray<value_type> b = _in.c;
+    semisort(a.begin(), (int)a.size());
+    // the same elements, and no key starts a second group
+    std::sort(b.begin(), b.end());
+    parray<value_type> c = a;
+    std::sort(c.begin(), c.end());
+    if (! same_sequence(b.cbegin(), b.cend(), c.cbegin(), c.cend())) {
+      return false;
+    }
+    std::map<int, bool> seen;
+    for (int i = 0; i < a.size(); i++) {
+      if (i == 0 || a[i].first != a[i - 1].first) {
+        if (seen.count(a[i].first) > 0) {
+          return false;
+        }
+        seen[a[i].first] = true;
+      }
+    }
+    return true;
+  }
+
+};
+
+class reduce_by_key_property : public quickcheck::Property<parray_wrapper> {
+public:
+
+  bool holdsFor(const parray_wrapper& _in) {
+    parray<value_type> a = _in.c;
+    std::map<int, int> expected;
+    for (int i = 0; i < a.size(); i++) {
+      expected[a[i].first] += a[i].second;
+    }
+    parray<value_type> r = reduce_by_key(a.begin(), (int)a.size(), 0, [&] (int x, int y) {
+      return x + y;
+    });
+    if (r.size() != expected.size()) {
+      return false;
+    }
+    for (int i = 0; i < r.size(); i++) {
+      if (expected[r[i].first] != r[i].second) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+};
+
+} // end namespace
+} // end namespace
+
+/*---------------------------------------------------------------------*/
+
+int main(int argc, char** argv) {
+  pbbs::launch(argc, argv, [&] {
+    int nb_tests = deepsea::cmdline::parse_or_default_int("n", 1000);
+    checkit<pasl::pctl::grouped_property>(nb_tests, "semisort is correct");
+    checkit<pasl::pctl::reduce_by_key_property>(nb_tests, "reduce_by_key is correct");
+  });
+  return 0;
+}
+
+/***********************************************************************/
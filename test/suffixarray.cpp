@@ -13,6 +13,10 @@
 #include "test.hpp"
 #include "prandgen.hpp"
 #include "suffixarray.hpp"
+#include "lcp.hpp"
+#include "textindex.hpp"
+#include "fmindex.hpp"
+#include "lz77.hpp"
 #include "trigrams.hpp"
 
 /***********************************************************************/
@@ -44,6 +48,12 @@ void generate(size_t nb, parray<value_type>& str) {
       int x = quickcheck::generateInRange(0, 26) + 'a';
       str[i] = (value_type)x;
     }
+  } else if (mode == 1) {
+    // tandem repeats of a random period, where the LCP are long
+    int period = quickcheck::generateInRange(1, 50);
+    for (int i = 0; i < nb; i++) {
+      str[i] = (i < period) ? (value_type)(quickcheck::generateInRange(0, 3) + 'a') : str[i - period];
+    }
   } else {
     for (int i = 0; i < nb; i++) {
       str[i] = 'a';
@@ -134,13 +144,14 @@ bool is_sorted(intT* suffixes, uchar* s, intT n) {
 
 using parray_wrapper = container_wrapper<parray<value_type>>;
 
+template <suffix_array_algorithm algorithm>
 class suffixarray_property : public quickcheck::Property<parray_wrapper> {
 public:
   
   bool holdsFor(const parray_wrapper& _in) {
     parray_wrapper in(_in);
     intT n = (intT)in.c.size() - 1;
-    parray<intT> suffixes = suffix_array(in.c.begin(), n);
+    parray<intT> suffixes = suffix_array(in.c.begin(), n, algorithm);
 
 //    std::cerr << suffixes << std::endl;
 
@@ -158,6 +169,264 @@ public:
   
 };
 
+// The LCP built from a suffix array matches the one found by DC3
+class lcp_property : public quickcheck::Property<parray_wrapper> {
+public:
+
+  bool holdsFor(const parray_wrapper& _in) {
+    parray_wrapper in(_in);
+    intT n = (intT)in.c.size() - 1;
+    parray<intT> suffixes;
+    parray<intT> LCP;
+    suffix_array(in.c.begin(), n, true, suffixes, LCP);
+    parray<intT> plcp = lcp_array(in.c.cbegin(), suffixes);
+    if (plcp.size() != n) {
+      return false;
+    }
+    for (intT i = 0; i + 1 < n; i++) {
+      if (plcp[i] != LCP[i]) {
+        return false;
+      }
+    }
+    return n == 0 || plcp[n - 1] == 0;
+  }
+
+};
+
+// Suffix arrays with long and uint40 indices, from both engines, and their
+// LCP, match those with int indices
+template <class Index, suffix_array_algorithm algorithm>
+class suffixarray_large_property : public quickcheck::Property<parray_wrapper> {
+public:
+
+  bool holdsFor(const parray_wrapper& _in) {
+    parray_wrapper in(_in);
+    intT n = (intT)in.c.size() - 1;
+    parray<intT> suffixes = suffix_array(in.c.begin(), n, algorithm);
+    parray<Index> large = suffix_array_large<Index>(in.c.begin(), (long)n, algorithm);
+    if (large.size() != n) {
+      return false;
+    }
+    for (intT i = 0; i < n; i++) {
+      if ((long) large[i] != suffixes[i]) {
+        return false;
+      }
+    }
+    parray<intT> LCP = lcp_array(in.c.cbegin(), suffixes);
+    parray<Index> large_LCP = lcp_array(in.c.cbegin(), large);
+    for (intT i = 0; i < n; i++) {
+      if ((long) large_LCP[i] != LCP[i]) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+};
+
+// The compact range-minimum structure agrees with the sparse table on the
+// LCP of the text, whose minima are often tied, and so does its uint40
+// instance
+class compact_rmq_property : public quickcheck::Property<parray_wrapper> {
+public:
+
+  bool holdsFor(const parray_wrapper& _in) {
+    parray_wrapper in(_in);
+    intT n = (intT)in.c.size() - 1;
+    parray<intT> suffixes;
+    parray<intT> LCP;
+    suffix_array(in.c.begin(), n, true, suffixes, LCP);
+    if (n < 2) {
+      return true;
+    }
+    parray<uint40> LCP40(n, [&] (long i) {
+      return uint40(LCP[i]);
+    });
+    myRMQ sparse(LCP.begin(), n);
+    compact_rmq compact(LCP.cbegin(), n);
+    basic_compact_rmq<uint40> compact40(LCP40.cbegin(), n);
+    for (int k = 0; k < 100; k++) {
+      intT i = quickcheck::generateInRange(0, n - 1);
+      intT j = quickcheck::generateInRange(i, n - 1);
+      intT m = compact.query(i, j);
+      if (LCP[m] != LCP[sparse.query(i, j)] || compact40.query(i, j) != m) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+};
+
+// Counts of substrings of the text, and of variants of them, match a scan
+class text_index_property : public quickcheck::Property<parray_wrapper> {
+public:
+
+  bool holdsFor(const parray_wrapper& _in) {
+    intT n = (intT)_in.c.size() - 1;
+    std::string text((const char*)_in.c.cbegin(), n);
+    text_index<intT> index(text.c_str(), n);
+    for (int k = 0; k < 20 && n > 0; k++) {
+      int start = quickcheck::generateInRange(0, n - 1);
+      int m = quickcheck::generateInRange(0, 12);
+      std::string p = text.substr(start, m);
+      if (k % 2 == 1 && p.length() > 0) {
+        p[p.length() - 1] = (char)quickcheck::generateInRange('a', 'z' + 1);
+      }
+      long expected = 0;
+      for (intT i = 0; i < n; i++) {
+        if (text.compare(i, p.length(), p) == 0) {
+          expected++;
+        }
+      }
+      if (index.count(p) != expected) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+};
+
+// Backward search on the FM-index counts as the suffix array search does
+class fm_index_property : public quickcheck::Property<parray_wrapper> {
+public:
+
+  bool holdsFor(const parray_wrapper& _in) {
+    intT n = (intT)_in.c.size() - 1;
+    std::string text((const char*)_in.c.cbegin(), n);
+    text_index<intT> index(text.c_str(), n);
+    fm_index fm(text.c_str(), index.SA);
+    for (int k = 0; k < 20 && n > 0; k++) {
+      int start = quickcheck::generateInRange(0, n - 1);
+      int m = quickcheck::generateInRange(0, 12);
+      std::string p = text.substr(start, m);
+      if (k % 2 == 1 && p.length() > 0) {
+        p[p.length() - 1] = (char)quickcheck::generateInRange('a', 'z' + 1);
+      }
+      if (fm.count(p) != index.count(p)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+};
+
+// Select on bit vectors and on the wavelet matrix of the text, compared
+// to the positions found by a scan. The text is repeated up to a few
+// select samples, so that select crosses samples
+class select_property : public quickcheck::Property<parray_wrapper> {
+public:
+
+  bool holdsFor(const parray_wrapper& _in) {
+    long n = (long)_in.c.size() - 1;
+    if (n == 0) {
+      return true;
+    }
+    long m = std::max(n, 3L * SELECT_SAMPLE);
+    parray<unsigned char> text(m, [&] (long i) {
+      return _in.c[i % n];
+    });
+    // dense, as sparse as the first character, and with a run of zeros
+    for (int mode = 0; mode < 3; mode++) {
+      auto bit = [&] (long i) {
+        if (mode == 0) {
+          return (text[i] & 1) == 1;
+        } else if (mode == 1) {
+          return text[i] == text[0];
+        } else {
+          return i >= m / 2;
+        }
+      };
+      rank_bitvector bv(m, bit);
+      long ones = 0;
+      long zeros = 0;
+      for (long i = 0; i < m; i++) {
+        if (bit(i)) {
+          if (bv.select1(ones++) != i) {
+            cout << "error in select1: the one of rank " << ones - 1
+            << " is at " << i << endl;
+            return false;
+          }
+        } else {
+          if (bv.select0(zeros++) != i) {
+            cout << "error in select0: the zero of rank " << zeros - 1
+            << " is at " << i << endl;
+            return false;
+          }
+        }
+      }
+    }
+    wavelet_matrix wm(text, 8);
+    parray<long> seen(256, 0L);
+    for (long i = 0; i < m; i++) {
+      unsigned char c = text[i];
+      if (wm.select(c, seen[c]++) != i) {
+        cout << "error in wavelet matrix select: the occurrence of "
+        << (int)c << " of rank " << seen[c] - 1 << " is at " << i << endl;
+        return false;
+      }
+    }
+    return true;
+  }
+
+};
+
+// Decoding the LZ77 factorization gives back the text, every phrase copies
+// from before itself and the first phrases cannot be extended by one more
+// character
+class lz77_property : public quickcheck::Property<parray_wrapper> {
+public:
+
+  bool holdsFor(const parray_wrapper& _in) {
+    long n = (long)_in.c.size() - 1;
+    std::string text((const char*)_in.c.cbegin(), n);
+    parray<lz77_phrase<intT>> phrases = lz77_factorize(text.c_str(), n);
+    if (lz77_decode(phrases) != text) {
+      return false;
+    }
+    long p = 0;
+    for (long k = 0; k < phrases.size(); k++) {
+      long len = phrases[k].length;
+      if (len > 0 && phrases[k].source >= p) {
+        return false;
+      }
+      long start = p;
+      p += std::max(len, 1L);
+      if (k < 20 && p < n && text.find(text.substr(start, p - start + 1)) < start) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+};
+
+// The factorization over a uint40 suffix array is the one over an int
+// suffix array
+class lz77_uint40_property : public quickcheck::Property<parray_wrapper> {
+public:
+
+  bool holdsFor(const parray_wrapper& _in) {
+    long n = (long)_in.c.size() - 1;
+    std::string text((const char*)_in.c.cbegin(), n);
+    parray<uint40> SA = suffix_array_large<uint40>((unsigned char*)text.c_str(), n);
+    parray<lz77_phrase<uint40>> phrases = lz77_factorize(text.c_str(), SA);
+    parray<lz77_phrase<intT>> expected = lz77_factorize(text.c_str(), n);
+    if (phrases.size() != expected.size()) {
+      return false;
+    }
+    for (long k = 0; k < phrases.size(); k++) {
+      if ((long) phrases[k].length != expected[k].length) {
+        return false;
+      }
+    }
+    return lz77_decode(phrases) == text;
+  }
+
+};
+
 } // end namespace
 } // end namespace
 
@@ -166,7 +435,18 @@ public:
 int main(int argc, char** argv) {
   pbbs::launch(argc, argv, [&] {
     int nb_tests = deepsea::cmdline::parse_or_default_int("n", 1000);
-    checkit<pasl::pctl::suffixarray_property>(nb_tests, "suffixarray is correct");
+    checkit<pasl::pctl::suffixarray_property<pasl::pctl::suffix_array_dc3>>(nb_tests, "suffixarray is correct");
+    checkit<pasl::pctl::suffixarray_property<pasl::pctl::suffix_array_prefix_doubling>>(nb_tests, "suffixarray by prefix doubling is correct");
+    checkit<pasl::pctl::lcp_property>(nb_tests, "lcp is correct");
+    checkit<pasl::pctl::suffixarray_large_property<long, pasl::pctl::suffix_array_dc3>>(nb_tests, "suffixarray and lcp with long indices are correct");
+    checkit<pasl::pctl::suffixarray_large_property<pasl::pctl::uint40, pasl::pctl::suffix_array_dc3>>(nb_tests, "suffixarray and lcp with uint40 indices are correct");
+    checkit<pasl::pctl::suffixarray_large_property<pasl::pctl::uint40, pasl::pctl::suffix_array_prefix_doubling>>(nb_tests, "suffixarray by prefix doubling with uint40 indices is correct");
+    checkit<pasl::pctl::compact_rmq_property>(nb_tests, "compact rmq is correct");
+    checkit<pasl::pctl::text_index_property>(nb_tests, "text index is correct");
+    checkit<pasl::pctl::fm_index_property>(nb_tests, "fm index is correct");
+    checkit<pasl::pctl::select_property>(nb_tests, "bit vector and wavelet matrix select are correct");
+    checkit<pasl::pctl::lz77_property>(nb_tests, "lz77 is correct");
+    checkit<pasl::pctl::lz77_uint40_property>(nb_tests, "lz77 over a uint40 suffix array is correct");
   });
   return 0;
 }